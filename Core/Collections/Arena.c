@@ -0,0 +1,104 @@
+#define DT_ALLOC_TAG DT_ALLOC_ARENAS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections.h"
+
+#include "DtAllocators.h"
+#include "DtNumericalTypes.h"
+
+#define DT_ARENA_ALIGN 16
+
+static size_t arena_align(size_t size);
+static DtArenaBlock* arena_block_new(DtArenaBlock* prev, size_t size);
+static u8* arena_block_data(DtArenaBlock* block);
+
+DtArena dt_arena_new(const size_t block_size) {
+    return (DtArena) {
+        .head = NULL,
+        .block_size = block_size ? block_size : 4096,
+    };
+}
+
+void* dt_arena_alloc(DtArena* arena, size_t size) {
+    size = arena_align(size);
+
+    if (!arena->head || arena->head->ptr + size > arena->head->size) {
+        const size_t block_size = size > arena->block_size ? size : arena->block_size;
+        arena->head = arena_block_new(arena->head, block_size);
+    }
+
+    void* ptr = arena_block_data(arena->head) + arena->head->ptr;
+    arena->head->ptr += size;
+
+    return ptr;
+}
+
+char* dt_arena_strndup(DtArena* arena, const char* str, const size_t size) {
+    char* copy = dt_arena_alloc(arena, size + 1);
+    memcpy(copy, str, size);
+    copy[size] = '\0';
+
+    return copy;
+}
+
+DtArenaMark dt_arena_mark(const DtArena* arena) {
+    return (DtArenaMark) {
+        .block = arena->head,
+        .ptr = arena->head ? arena->head->ptr : 0,
+    };
+}
+
+void dt_arena_reset_to(DtArena* arena, const DtArenaMark mark) {
+    while (arena->head && arena->head != mark.block) {
+        DtArenaBlock* prev = arena->head->prev;
+        DT_FREE(arena->head);
+        arena->head = prev;
+    }
+
+    if (arena->head)
+        arena->head->ptr = mark.ptr;
+}
+
+void dt_arena_clear(DtArena* arena) {
+    if (!arena->head)
+        return;
+
+    while (arena->head->prev) {
+        DtArenaBlock* prev = arena->head->prev;
+        arena->head->prev = prev->prev;
+        DT_FREE(prev);
+    }
+
+    arena->head->ptr = 0;
+}
+
+void dt_arena_free(DtArena* arena) {
+    dt_arena_reset_to(arena, (DtArenaMark) {0});
+}
+
+static size_t arena_align(const size_t size) {
+    return (size + DT_ARENA_ALIGN - 1) & ~(size_t) (DT_ARENA_ALIGN - 1);
+}
+
+static DtArenaBlock* arena_block_new(DtArenaBlock* prev, const size_t size) {
+    DtArenaBlock* block = DT_MALLOC(arena_align(sizeof(DtArenaBlock)) + size);
+
+    if (!block) {
+        printf("[DEBUG] arena allocation exception\n");
+        exit(1);
+    }
+
+    *block = (DtArenaBlock) {
+        .prev = prev,
+        .size = size,
+        .ptr = 0,
+    };
+
+    return block;
+}
+
+static u8* arena_block_data(DtArenaBlock* block) {
+    return (u8*) block + arena_align(sizeof(DtArenaBlock));
+}
@@ -215,4 +215,68 @@ void dt_rb_tree_remove(DtRbTree* head, u64 hash);
 // TODO:comment
 void dt_rb_tree_free(DtRbTree* head);
 
+/**
+ * @brief block of arena memory
+ */
+typedef struct DtArenaBlock {
+    struct DtArenaBlock* prev;
+    size_t size;
+    size_t ptr;
+} DtArenaBlock;
+
+/**
+ * @brief bump allocator for transient data, all memory is freed by one call
+ *
+ * @note pointers stay valid until arena is reset or freed
+ */
+typedef struct {
+    DtArenaBlock* head;
+    size_t block_size;
+} DtArena;
+
+/**
+ * @brief saved arena position for dt_arena_reset_to
+ */
+typedef struct {
+    DtArenaBlock* block;
+    size_t ptr;
+} DtArenaMark;
+
+/**
+ * @brief create arena, memory is allocated on first dt_arena_alloc
+ *
+ * @param block_size minimal size of one block
+ */
+DtArena dt_arena_new(size_t block_size);
+
+/**
+ * @brief allocate aligned memory from arena
+ */
+void* dt_arena_alloc(DtArena* arena, size_t size);
+
+/**
+ * @brief copy size chars of str into arena and add terminating zero
+ */
+char* dt_arena_strndup(DtArena* arena, const char* str, size_t size);
+
+/**
+ * @brief return current arena position
+ */
+DtArenaMark dt_arena_mark(const DtArena* arena);
+
+/**
+ * @brief release everything allocated after mark
+ */
+void dt_arena_reset_to(DtArena* arena, DtArenaMark mark);
+
+/**
+ * @brief release everything, newest block is kept for next allocations
+ */
+void dt_arena_clear(DtArena* arena);
+
+/**
+ * @brief free all arena memory
+ */
+void dt_arena_free(DtArena* arena);
+
 #endif
@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_RBTREE
+
 #include "Collections/Collections.h"
 #include "DtAllocators.h"
 
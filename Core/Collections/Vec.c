@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_VECTORS
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -152,4 +154,4 @@ void vec_next(void* data) {
     header->current++;
 }
 
-inline void dt_vec_free(void* data) { free(dt_vec_header(data)); }
+inline void dt_vec_free(void* data) { DT_FREE(dt_vec_header(data)); }
@@ -10,6 +10,19 @@
 #define DT_STACK_ALLOC(size) alloca((size))
 #endif
 
+#ifdef DT_TRACK_ALLOCATIONS
+#include "Profiling/DtAllocTracker.h"
+
+#ifndef DT_ALLOC_TAG
+#define DT_ALLOC_TAG DT_ALLOC_OTHER
+#endif
+
+#define DT_MALLOC(size) dt_tracked_malloc((size), DT_ALLOC_TAG)
+#define DT_REALLOC(ptr, size) dt_tracked_realloc((ptr), (size), DT_ALLOC_TAG)
+#define DT_CALLOC(count, size) dt_tracked_calloc((count), (size), DT_ALLOC_TAG)
+#define DT_FREE(ptr) dt_tracked_free((ptr))
+#endif /*DT_TRACK_ALLOCATIONS*/
+
 #ifndef DT_MALLOC
 #include <malloc.h>
 #define DT_MALLOC(size) malloc((size))
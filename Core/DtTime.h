@@ -0,0 +1,31 @@
+#ifndef DT_TIME_H
+#define DT_TIME_H
+
+#include <time.h>
+#include "DtNumericalTypes.h"
+
+/**
+ * @brief monotonic time in nanoseconds, only differences between calls are meaningful
+ *
+ * @note windows.h isn't included on purpose, it clashes with raylib, mingw-w64 provides
+ * clock_gettime through winpthreads
+ */
+static inline u64 dt_time_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64) ts.tv_sec * 1000000000ULL + (u64) ts.tv_nsec;
+}
+
+/**
+ * @brief sleep calling thread for at least duration nanoseconds, comes from winpthreads
+ * on windows as clock_gettime
+ */
+static inline void dt_time_sleep_ns(const u64 duration) {
+    const struct timespec ts = {
+        .tv_sec = (time_t) (duration / 1000000000ULL),
+        .tv_nsec = (long) (duration % 1000000000ULL),
+    };
+    nanosleep(&ts, NULL);
+}
+
+#endif /*DT_TIME_H*/
@@ -1,3 +1,6 @@
+#define DT_ALLOC_TAG DT_ALLOC_MODULES
+
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,8 +11,20 @@
 
 static u64 size = 0;
 static int id_counter = 0;
-static const DtComponentData** component_data_by_id = NULL;
+// registry owns data of components, only plans are changed after registration
+static DtComponentData** component_data_by_id = NULL;
 static const DtComponentData** component_data_by_name = NULL;
+static u32 plans_version = 1;
+static atomic_bool frozen = false;
+
+static void dt_component_compile_plans(DtComponentData* data);
+static void dt_component_compile_all_plans(void);
+
+/**
+ * @brief search component in loaded modules, list of modules is read only while
+ * worlds simulate
+ */
+static const DtComponentData* dt_component_get_from_modules(const char* name);
 
 void dt_component_increment_count() { size++; }
 
@@ -22,7 +37,41 @@ static int dt_component_get_hash(const char* name) {
     return hash;
 }
 
+static u64 dt_component_layout_hash(const DtComponentData* data) {
+    u64 hash = 14695981039346656037ULL;
+
+#define LAYOUT_HASH_BYTES(ptr, len)                                                                \
+    ({                                                                                             \
+        const u8* bytes = (const u8*) (ptr);                                                       \
+        for (size_t b = 0; b < (len); b++) {                                                       \
+            hash ^= bytes[b];                                                                      \
+            hash *= 1099511628211ULL;                                                              \
+        }                                                                                          \
+    })
+
+    LAYOUT_HASH_BYTES(&data->component_size, sizeof(data->component_size));
+    LAYOUT_HASH_BYTES(&data->field_count, sizeof(data->field_count));
+
+    for (u16 i = 0; i < data->field_count; i++) {
+        LAYOUT_HASH_BYTES(data->field_names[i], strlen(data->field_names[i]));
+        LAYOUT_HASH_BYTES(data->field_types[i], strlen(data->field_types[i]));
+        LAYOUT_HASH_BYTES(&data->field_offsets[i], sizeof(u16));
+        if (data->field_sizes)
+            LAYOUT_HASH_BYTES(&data->field_sizes[i], sizeof(u16));
+    }
+
+#undef LAYOUT_HASH_BYTES
+
+    return hash;
+}
+
 void dt_register_component(DtComponentData* data) {
+    if (dt_registries_frozen()) {
+        fprintf(stderr, "[WARNING] registries are frozen, %s component isn't registered\n",
+                data->name);
+        return;
+    }
+
     if (size == 0)
         size = 107ULL;
     if (!component_data_by_id) {
@@ -32,6 +81,7 @@ void dt_register_component(DtComponentData* data) {
 
     data->id = id_counter++;
     data->hash = dt_component_get_hash(data->name);
+    data->layout_hash = dt_component_layout_hash(data);
     u64 idx = data->hash % size;
     const u64 start = idx;
     while (component_data_by_name[idx] != NULL) {
@@ -52,6 +102,8 @@ void dt_register_component(DtComponentData* data) {
     data->init = NULL;
     data->copy = NULL;
 
+    dt_component_compile_plans(data);
+
     for (int i = 0; i < data->attribute_count; i++) {
         if (strcmp(data->attributes[i].attribute_name, DT_RESET_ATTR_TAG) == 0) {
             data->reset = data->attributes[i].data;
@@ -84,37 +136,24 @@ const DtComponentData* dt_component_get_data_by_name(const char* name) {
     while (component_data_by_name[idx] != NULL &&
            strcmp(component_data_by_name[idx]->name, name) != 0) {
         idx = (idx + 1) % size;
-        if (idx == start) {
-            DtEnvironment* env = dt_environment_instance();
-
-            FOREACH(ModuleInfo, info, &env->modules.iterator, {
-                const DtComponentData* data = info.environment->get_component(name);
-                if (data)
-                    return data;
-            });
-
-            return NULL;
-        }
+        if (idx == start)
+            return dt_component_get_from_modules(name);
     }
 
-
     if (component_data_by_name[idx] != NULL) {
         return component_data_by_name[idx];
     }
 
-    DtEnvironment* env = dt_environment_instance();
-
-    FOREACH(ModuleInfo*, info, &env->modules.iterator, {
-        const DtComponentData* data = info->environment->get_component(name);
-        if (data)
-            return data;
-    });
-
-    return NULL;
+    return dt_component_get_from_modules(name);
 }
 
 i32 dt_component_get_field_index(const DtComponentData* data, const char* name) {
+    const DtFieldPlan* plans = dt_component_get_plans(data);
+    const u64 hash = plans ? (u64) dt_component_get_hash(name) : 0;
+
     for (u16 i = 0; i < data->field_count; i++) {
+        if (plans && plans[i].name_hash != hash)
+            continue;
         if (strcmp(data->field_names[i], name) != 0)
             continue;
         return i;
@@ -122,7 +161,73 @@ i32 dt_component_get_field_index(const DtComponentData* data, const char* name)
     return -1;
 }
 
+DtFieldPlan* dt_component_get_plans(const DtComponentData* data) { return data->field_plans; }
+
+void dt_component_invalidate_plans(void) {
+    // plans are read from any thread, so they are never compiled lazily by readers
+    plans_version++;
+    dt_component_compile_all_plans();
+}
+
+void dt_registries_freeze(void) {
+    dt_component_compile_all_plans();
+    atomic_store_explicit(&frozen, true, memory_order_release);
+}
+
+void dt_registries_unfreeze(void) { atomic_store_explicit(&frozen, false, memory_order_release); }
+
+bool dt_registries_frozen(void) { return atomic_load_explicit(&frozen, memory_order_acquire); }
+
+static const DtComponentData* dt_component_get_from_modules(const char* name) {
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
+        const DtComponentData* data = env->modules_list[i]->environment->get_component(name);
+        if (data)
+            return data;
+    }
+
+    return NULL;
+}
+
+static void dt_component_compile_all_plans(void) {
+    for (int i = 0; i < id_counter; i++) {
+        if (component_data_by_id[i]->plans_version != plans_version)
+            dt_component_compile_plans(component_data_by_id[i]);
+    }
+}
+
+static void dt_component_compile_plans(DtComponentData* data) {
+    if (data->field_count == 0) {
+        data->plans_version = plans_version;
+        return;
+    }
+
+    if (!data->field_plans) {
+        data->field_plans = DT_CALLOC(data->field_count, sizeof(DtFieldPlan));
+        if (!data->field_plans) {
+            printf("[DEBUG] field plans allocation exception\n");
+            exit(1);
+        }
+    }
+
+    for (u16 i = 0; i < data->field_count; i++) {
+        DtFieldPlan* plan = &data->field_plans[i];
+
+        plan->offset = data->field_offsets[i];
+        plan->size = data->field_sizes ? data->field_sizes[i] : 0;
+        plan->name_hash = (u64) dt_component_get_hash(data->field_names[i]);
+        plan->parse = dt_get_parser_json_to_type(data->field_types[i]);
+        plan->serialize = dt_get_serializer_type_to_json(data->field_types[i]);
+        plan->inspect = NULL;
+    }
+
+    data->plans_version = plans_version;
+}
+
 const DtComponentData** dt_component_get_all(u16* size) {
     *size = id_counter;
-    return component_data_by_id;
+    return (const DtComponentData**) component_data_by_id;
 }
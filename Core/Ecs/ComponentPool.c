@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_POOLS
+
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -6,6 +8,8 @@
 #include "RegisterHandler.h"
 
 static void component_pool_add(void* pool, DtEntity entity, const void* data);
+static void component_pool_add_range(void* pool, const DtEntity* entities, u16 count,
+                                     const void* data);
 static void* component_pool_get_item(const void* pool, DtEntity entity);
 static bool component_pool_has(const void* pool, DtEntity entity);
 static void component_pool_reset(void* pool, DtEntity entity);
@@ -32,6 +36,7 @@ DtEcsPool* dt_component_pool_new(const DtEcsManager* manager, const char* name,
                 .type = DT_COMPONENT_POOL,
 
                 .add = component_pool_add,
+                .add_range = component_pool_add_range,
                 .get = component_pool_get_item,
                 .has = component_pool_has,
                 .reset = component_pool_reset,
@@ -57,6 +62,12 @@ static void component_pool_add(void* pool, DtEntity entity, const void* data) {
     dt_entity_container_add(&component_pool->entities, entity, data);
 }
 
+static void component_pool_add_range(void* pool, const DtEntity* entities, const u16 count,
+                                     const void* data) {
+    DtComponentPool* component_pool = pool;
+    dt_entity_container_add_range(&component_pool->entities, entities, count, data);
+}
+
 static void* component_pool_get_item(const void* pool, DtEntity entity) {
     const DtComponentPool* component_pool = pool;
     return dt_entity_container_get(&component_pool->entities, entity);
@@ -91,5 +102,5 @@ static void component_pool_resize(void* pool, const u16 new_size) {
 
 static void component_pool_free(void* pool) {
     dt_entity_container_free(&((DtComponentPool*) pool)->entities);
-    free(pool);
+    DT_FREE(pool);
 }
@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_SYSTEMS
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,6 +12,12 @@ static int id_counter = 0;
 static const DtDrawData** draw_data_by_id = NULL;
 static const DtDrawData** draw_data_by_name = NULL;
 
+/**
+ * @brief search system in loaded modules, list of modules is read only while
+ * worlds simulate
+ */
+static const DtDrawData* dt_draw_get_from_modules(const char* name);
+
 void dt_draw_increment_count() { size++; }
 
 static int dt_draw_get_hash(const char* name) {
@@ -22,6 +30,12 @@ static int dt_draw_get_hash(const char* name) {
 }
 
 void dt_draw_register(DtDrawData* data) {
+    if (dt_registries_frozen()) {
+        fprintf(stderr, "[WARNING] registries are frozen, %s draw system isn't registered\n",
+                data->name);
+        return;
+    }
+
     if (!size)
         size = 107ULL;
     if (!draw_data_by_id) {
@@ -63,34 +77,32 @@ const DtDrawData* dt_draw_get_data_by_name(const char* name) {
 
     while (draw_data_by_name[idx] != NULL && strcmp(draw_data_by_name[idx]->name, name) != 0) {
         idx = (idx + 1) % size;
-        if (idx == start) {
-            DtEnvironment* env = dt_environment_instance();
-            FOREACH(ModuleInfo, info, &env->modules.iterator, {
-                const DtDrawData* data = info.environment->get_draw(name);
-                if (data)
-                    return data;
-            });
-
-            return NULL;
-        }
+        if (idx == start)
+            return dt_draw_get_from_modules(name);
     }
 
     if (draw_data_by_name[idx] != NULL) {
         return draw_data_by_name[idx];
     }
 
-    DtEnvironment* env = dt_environment_instance();
-
-    FOREACH(ModuleInfo*, info, &env->modules.iterator, {
-        const DtDrawData* data = info->environment->get_draw(name);
-        if (data)
-            return data;
-    });
-
-    return NULL;
+    return dt_draw_get_from_modules(name);
 }
 
 const DtDrawData** dt_draw_get_all(u16* size_out) {
     *size_out = id_counter;
     return draw_data_by_id;
 }
+
+static const DtDrawData* dt_draw_get_from_modules(const char* name) {
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
+        const DtDrawData* data = env->modules_list[i]->environment->get_draw(name);
+        if (data)
+            return data;
+    }
+
+    return NULL;
+}
@@ -6,6 +6,7 @@
  *============================================================================*/
 
 #include <DtNumericalTypes.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include "Collections/Collections.h"
 
@@ -16,6 +17,8 @@
 typedef u16 DtEntity;
 #define DT_ENTITY_NULL (0xFFFF)
 
+struct cJSON;
+
 /*=============================================================================
  *                        Определения типов и структур
  *============================================================================*/
@@ -45,6 +48,7 @@ typedef void (*DtCopyItemHandler)(void* dst, const void* src);
 typedef struct DtEcsManager DtEcsManager;
 // TODO: comments
 typedef struct DtEcsFilter DtEcsFilter;
+typedef struct DtEcsObserver DtEcsObserver;
 
 /**
  * @brief metadata of component and components field
@@ -54,6 +58,22 @@ typedef struct {
     void* data;
 } DtAttributeData;
 
+/**
+ * @brief precompiled access to one component field
+ *
+ * @note handlers are resolved once by type name, NULL handler means that type is
+ * unknown for core and lookup by name must be used
+ */
+typedef struct {
+    u16 offset;
+    u16 size;
+    u64 name_hash;
+
+    void (*parse)(struct cJSON* src, void* dst);
+    struct cJSON* (*serialize)(const void* src);
+    bool (*inspect)(const char* name, void* data);
+} DtFieldPlan;
+
 /**
  * @brief data of serialized component
  */
@@ -70,10 +90,15 @@ typedef struct {
     char** field_names;
     char** field_types;
     u16* field_offsets;
+    u16* field_sizes;
     DtAttributeData** filed_attributes;
     u16* filed_attributes_count;
 
     u64 component_size;
+    u64 layout_hash;
+
+    DtFieldPlan* field_plans;
+    u32 plans_version;
 
     DtAttributeData* attributes;
     u8 attribute_count;
@@ -178,6 +203,8 @@ DtEntityContainer dt_entity_container_new(u32 item_size, DtEntity dense_size, Dt
                                           DtEntity recycle_size, DtResetItemHandler reset,
                                           DtCopyItemHandler copy, DtInitItemHandler init);
 void dt_entity_container_add(DtEntityContainer* container, DtEntity entity, const void* data);
+void dt_entity_container_add_range(DtEntityContainer* container, const DtEntity* entities,
+                                   u16 count, const void* data);
 int dt_entity_container_has(const DtEntityContainer* container, DtEntity entity);
 void* dt_entity_container_get(const DtEntityContainer* container, DtEntity entity);
 void dt_entity_container_reset(DtEntityContainer* container, DtEntity entity);
@@ -229,6 +256,7 @@ typedef struct {
     void* data;
 
     void (*add)(void*, DtEntity, const void*);
+    void (*add_range)(void*, const DtEntity*, u16, const void*);
     void* (*get)(const void*, DtEntity);
     bool (*has)(const void*, DtEntity);
     void (*reset)(void*, DtEntity);
@@ -238,6 +266,8 @@ typedef struct {
     void (*free)(void*);
 
     DtIterator iterator;
+
+    DT_VEC(DtEcsObserver*) observers;
 } DtEcsPool;
 
 /**
@@ -276,10 +306,24 @@ DtEcsPool* dt_component_pool_new(const DtEcsManager* manager, const char* name,
 DtEcsPool* dt_tag_pool_new(const DtEcsManager* manager, const char* name);
 
 void dt_ecs_pool_add(DtEcsPool* pool, DtEntity entity, const void* data);
+void dt_ecs_pool_add_range(DtEcsPool* pool, const DtEntity* entities, u16 count, const void* data);
+/**
+ * @brief add entities to pool like dt_ecs_pool_add_range, but filters aren't updated
+ *
+ * @note dt_ecs_manager_update_filters must be called for entities after all components are added
+ */
+void dt_ecs_pool_add_range_deferred(DtEcsPool* pool, const DtEntity* entities, u16 count,
+                                    const void* data);
 void* dt_ecs_pool_get(const DtEcsPool* pool, DtEntity entity);
 int dt_ecs_pool_has(const DtEcsPool* pool, DtEntity entity);
 void dt_ecs_pool_reset(DtEcsPool* pool, DtEntity entity);
 void dt_ecs_pool_copy(DtEcsPool* pool, DtEntity dst, DtEntity src);
+
+/**
+ * @brief copy data into component of entity and notify set observers, NULL data only
+ * notifies them about change made in place
+ */
+void dt_ecs_pool_set(DtEcsPool* pool, DtEntity entity, const void* data);
 void dt_ecs_pool_remove(DtEcsPool* pool, DtEntity entity);
 void dt_ecs_pool_resize(DtEcsPool* pool, u64 size);
 void dt_ecs_pool_free(DtEcsPool* pool);
@@ -320,8 +364,151 @@ struct DtEcsFilter {
     DtEcsManager* manager;
     DtEcsMask mask;
     DtEntityContainer entities;
+
+    atomic_ushort parallel_passes;
+};
+
+/*=============================================================================
+ *                  Параллельный обход фильтра (DtFilterParallel)
+ *============================================================================*/
+
+/**
+ * @brief structural changes recorded by chunk, they are applied after pass
+ */
+typedef struct DtEcsCommandBuffer DtEcsCommandBuffer;
+
+/**
+ * @brief state of thread which runs chunk, scratch memory is cleared after pass
+ */
+typedef struct {
+    DtArena* scratch;
+    DtEcsCommandBuffer* commands;
+    u16 thread;
+} DtFilterChunkContext;
+
+/**
+ * @brief process entities[0..count) of filter, chunks of one pass run concurrently
+ */
+typedef void (*DtFilterChunkFunc)(const DtEntity* entities, u16 count, DtFilterChunkContext* ctx,
+                                  void* user);
+
+/**
+ * @brief split dense entities of filter into chunks and run them as jobs, calling thread
+ * helps and returns when all chunks are done, recorded commands are applied by it in
+ * order of threads
+ *
+ * @param chunk_size entities in one chunk, 0 picks size by count of job threads
+ *
+ * @note filter can't be changed during pass, such change stops program,
+ * call it from main thread or from job
+ */
+void dt_filter_parallel_for(DtEcsFilter* filter, u16 chunk_size, DtFilterChunkFunc fn,
+                            void* user);
+
+/**
+ * @brief add component with data copy after pass
+ */
+void dt_ecs_commands_add(DtEcsCommandBuffer* commands, DtEcsPool* pool, DtEntity entity,
+                         const void* data);
+void dt_ecs_commands_remove(DtEcsCommandBuffer* commands, DtEcsPool* pool, DtEntity entity);
+void dt_ecs_commands_kill(DtEcsCommandBuffer* commands, DtEntity entity);
+
+/*=============================================================================
+ *                           Шина событий (DtEventChannel)
+ *============================================================================*/
+
+/**
+ * @brief fixed block of events, blocks of buffer are kept between frames
+ */
+typedef struct DtEventBlock DtEventBlock;
+
+/**
+ * @brief events of one frame, writers fill current block and chain next one when it's full
+ */
+typedef struct {
+    DtEventBlock* head;
+    _Atomic(DtEventBlock*) current;
+} DtEventBuffer;
+
+/**
+ * @brief queue of one event type in world, any thread may send events while systems
+ * read events sent before last swap, swap clears buffer read during previous frame
+ *
+ * @note read with FOREACH over iterator of DtEventReader, any number of readers may read
+ * channel at the same time
+ */
+typedef struct {
+    const char* name;
+    u64 hash;
+    u32 event_size;
+
+    DtEventBuffer buffers[2];
+    u8 write;
+    atomic_flag grow_lock;
+} DtEventChannel;
+
+/**
+ * @brief read position of one reader, it's kept by caller, usually on stack
+ */
+typedef struct {
+    DtIterator iterator;
+    const DtEventChannel* channel;
+    DtEventBlock* block;
+    u32 index;
+} DtEventReader;
+
+/**
+ * @brief copy event into write buffer of channel, it's safe from any thread
+ */
+void dt_event_send(DtEventChannel* channel, const void* event);
+
+/**
+ * @brief count of events which can be read now
+ */
+u32 dt_events_count(const DtEventChannel* channel);
+
+/**
+ * @brief start reader at first event which can be read now
+ */
+void dt_events_begin(DtEventReader* reader, const DtEventChannel* channel);
+
+/*=============================================================================
+ *                          Наблюдатели (DtEcsObserver)
+ *============================================================================*/
+
+typedef enum { DT_OBSERVE_ADD, DT_OBSERVE_REMOVE, DT_OBSERVE_SET } DtObserveKind;
+
+/**
+ * @brief entities whose component of pool was added, removed or set, they are gathered
+ * during frame and delivered to systems of next one
+ *
+ * @note entity is listed once per frame, optional filter keeps only entities which match
+ * it at end of frame, for remove before component is removed
+ */
+struct DtEcsObserver {
+    DtObserveKind kind;
+    DtEcsPool* pool;
+    DtEcsFilter* filter;
+
+    DT_VEC(DtEntity) entities[2];
+    u8 collect;
+
+    u8* queued;
+    u32 queued_size;
 };
 
+/**
+ * @brief entities delivered by last swap
+ *
+ * @note removed component isn't readable, entity may be killed or changed again already
+ */
+const DtEntity* dt_ecs_observer_entities(const DtEcsObserver* observer, u16* count);
+
+/**
+ * @brief gather change of component for observers of pool, pools call it themselves
+ */
+void dt_ecs_pool_notify(const DtEcsPool* pool, DtEntity entity, DtObserveKind kind);
+
 /*=============================================================================
  *                              ECS Менеджер (DtEcsManager)
  *============================================================================*/
@@ -355,6 +542,9 @@ struct DtEcsManager {
     DT_VEC(DtEcsFilter*) * filter_by_exclude;
 
     DtEcsPool* hierarchy_dirty_pool;
+
+    DT_VEC(DtEventChannel*) events;
+    DT_VEC(DtEcsObserver*) observers;
 };
 
 /*=============================================================================
@@ -375,6 +565,11 @@ struct DtEcsManager {
 #define DT_ECS_MANAGER_REMOVE_FROM_POOL(manager, T, entity)                                        \
     ({ dt_ecs_manager_entity_remove_component(manager, entity, #T); })
 
+/**
+ * @brief channel of event type T registered by DT_REGISTER_EVENT, it's created on first get
+ */
+#define DT_ECS_MANAGER_GET_EVENTS(manager, T) ({ dt_ecs_manager_get_events((manager), #T); })
+
 /**
  * @brief Включает тип T в маску
  * @param mask Маска, в которую включаем T
@@ -396,6 +591,7 @@ struct DtEcsManager {
  *============================================================================*/
 
 DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg);
+DtEcsManagerConfig dt_ecs_manager_get_config(const DtEcsManager* manager);
 DtEntity dt_ecs_manager_new_entity(DtEcsManager* manager);
 DtEntityInfo dt_ecs_manager_get_entity(const DtEcsManager* manager, DtEntity entity);
 DtEntityInfo dt_ecs_manager_get_parent(const DtEcsManager* manager, DtEntity entity);
@@ -417,40 +613,461 @@ void dt_ecs_manager_add_pool(DtEcsManager* manager, DtEcsPool* pool);
 DtEcsPool* dt_ecs_manager_get_pool(DtEcsManager* manager, const char* name);
 void dt_on_entity_change(const DtEcsManager* manager, DtEntity entity, u16 ecs_manager_component_id,
                          bool added);
+/**
+ * @brief sync filters with current components of entities in one pass
+ *
+ * @note every filter referencing any component of entity is checked once per component
+ */
+void dt_ecs_manager_update_filters(const DtEcsManager* manager, const DtEntity* entities,
+                                   u16 count);
+
+/**
+ * @brief return channel of event, NULL if event isn't registered
+ *
+ * @note channels are created while systems are initialized, not from jobs
+ */
+DtEventChannel* dt_ecs_manager_get_events(DtEcsManager* manager, const char* name);
+
+/**
+ * @brief make events sent since previous swap readable and clear older ones, update
+ * handler swaps them before systems of frame run
+ */
+void dt_ecs_manager_swap_events(const DtEcsManager* manager);
+
+/**
+ * @brief drop events of both buffers, channels and their blocks are kept
+ */
+void dt_ecs_manager_clear_events(const DtEcsManager* manager);
+void dt_ecs_manager_free_events(DtEcsManager* manager);
+
+/**
+ * @brief observe changes of component in pool, filter may be NULL
+ *
+ * @note observers are created while systems are initialized
+ */
+DtEcsObserver* dt_ecs_manager_observe(DtEcsManager* manager, DtObserveKind kind, DtEcsPool* pool,
+                                      DtEcsFilter* filter);
+
+/**
+ * @brief deliver changes gathered since previous swap, update handler swaps observers
+ * with events
+ */
+void dt_ecs_manager_swap_observers(const DtEcsManager* manager);
+
+/**
+ * @brief drop gathered and delivered changes, observers are kept
+ */
+void dt_ecs_manager_clear_observers(const DtEcsManager* manager);
+void dt_ecs_manager_free_observers(DtEcsManager* manager);
 void dt_ecs_manager_free(DtEcsManager* manager);
 void dt_remove_tool_components(const DtEcsManager* manager);
 
+/*=============================================================================
+ *                            Снимки мира (DtEcsSnapshot)
+ *============================================================================*/
+
+/**
+ * @brief raw copy of entities, pools and filters of one manager in one buffer
+ *
+ * @note component items are copied as is, memory owned by component fields isn't cloned.
+ * Buffer is reused by next snapshot of the same manager
+ */
+typedef struct {
+    const DtEcsManager* manager;
+    u8* data;
+    u64 size;
+    u64 capacity;
+} DtEcsSnapshot;
+
+/**
+ * @brief copy manager state into snapshot buffer
+ */
+void dt_ecs_manager_snapshot(const DtEcsManager* manager, DtEcsSnapshot* snapshot);
+
+/**
+ * @brief bring manager back to snapshot state
+ *
+ * @note entities, pools and filters created after snapshot are cleared,
+ * filters unknown to snapshot are refilled, events and observed changes are dropped
+ * since they refer to entities of replaced state
+ * @return false if snapshot was taken from other manager or is empty
+ */
+bool dt_ecs_manager_restore(DtEcsManager* manager, const DtEcsSnapshot* snapshot);
+
+void dt_ecs_snapshot_free(DtEcsSnapshot* snapshot);
+
+/*=============================================================================
+ *                        Миграция компонентов (DtComponentLayout)
+ *============================================================================*/
+
+/**
+ * @brief owned copy of component layout, stays valid after module with component is unloaded
+ */
+typedef struct {
+    char* name;
+    u64 layout_hash;
+    u64 component_size;
+
+    u16 field_count;
+    char** field_names;
+    char** field_types;
+    u16* field_offsets;
+    u16* field_sizes;
+} DtComponentLayout;
+
+/**
+ * @brief copy layouts of all manager pools, layout i belongs to pool i
+ */
+DtComponentLayout* dt_ecs_manager_capture_layouts(const DtEcsManager* manager, u16* count);
+
+/**
+ * @brief rebind pools to currently registered components and move rows to new layouts
+ *
+ * @note pools with unchanged layout keep their memory byte-for-byte, changed pools get
+ * fields matched by name, type and size, other fields are reset
+ * @return false without touching manager if component was removed or changed its kind
+ */
+bool dt_ecs_manager_migrate(DtEcsManager* manager, const DtComponentLayout* layouts, u16 count);
+
+void dt_component_layouts_free(DtComponentLayout* layouts, u16 count);
+
+/*=============================================================================
+ *                                Префабы (DtPrefab)
+ *============================================================================*/
+
+/**
+ * @brief frozen rows of one component, rows are local entity indices
+ */
+typedef struct {
+    const DtComponentData* data;
+    u16 count;
+    u16* rows;
+    u8* items;
+} DtPrefabColumn;
+
+/**
+ * @brief frozen entities subtree, components are stored by columns
+ *
+ * @note parents are local indices, DT_ENTITY_NULL for roots
+ */
+typedef struct {
+    u16 entity_count;
+    DtEntity* parents;
+
+    DtPrefabColumn* columns;
+    u16 column_count;
+} DtPrefab;
+
+/**
+ * @brief freeze root with all its children, root becomes local entity 0
+ */
+DtPrefab* dt_prefab_new(const DtEcsManager* manager, DtEntity root);
+
+/**
+ * @brief freeze all alive entities of manager
+ */
+DtPrefab* dt_prefab_from_manager(const DtEcsManager* manager);
+
+/**
+ * @brief create n copies of prefab, each pool gets one bulk add and filters are updated once
+ *
+ * @param entities optional output of n * entity_count entities, copy by copy in local order
+ */
+void dt_prefab_instantiate(DtEcsManager* manager, const DtPrefab* prefab, u16 n,
+                           DtEntity* entities);
+
+void dt_prefab_free(DtPrefab* prefab);
+
+/*=============================================================================
+ *                          Статистика систем (DtSystemStats)
+ *============================================================================*/
+
+/**
+ * @brief timings and counters of one system in handler
+ *
+ * @note collected only when built with DT_PROFILE_SYSTEMS, entities are counted
+ * on every visit of container or tag pool iterator
+ */
+typedef struct {
+    u64 last_ns;
+    u64 total_ns;
+    u64 max_ns;
+    u64 calls;
+
+    u64 entities_visited;
+    u64 structural_changes;
+    u64 skipped;
+} DtSystemStats;
+
+#ifdef DT_PROFILE_SYSTEMS
+/**
+ * @brief stats of system which is running now on calling thread, NULL outside of handlers
+ */
+extern _Thread_local DtSystemStats* dt_current_system_stats;
+
+#define DT_SYSTEM_STATS_ADD(field, value)                                                          \
+    ({                                                                                             \
+        if (dt_current_system_stats)                                                               \
+            dt_current_system_stats->field += (value);                                             \
+    })
+#else
+#define DT_SYSTEM_STATS_ADD(field, value) ((void) 0)
+#endif /*DT_PROFILE_SYSTEMS*/
+
+u64 dt_system_stats_average_ns(const DtSystemStats* stats);
+
 /*=============================================================================
  *                              Система ECS (EcsSystem)
  *============================================================================*/
 
+/**
+ * @brief alpha and fixed_steps are written by handler, alpha is part of fixed step left
+ * in accumulator after fixed update, from 0 to 1
+ */
 typedef struct {
     float delta_time;
     float fixed_delta_time;
+
+    float alpha;
+    u16 fixed_steps;
 } DtUpdateContext;
 
+typedef enum { DT_SLICE_DONE, DT_SLICE_PENDING } DtSliceResult;
+
+/**
+ * @brief call of sliced work, cursor is kept by handler between calls and frames
+ */
+typedef struct {
+    DtUpdateContext* update;
+    u32 cursor;
+    u64 deadline_ns;
+} DtSliceContext;
+
+#define DT_RUN_WATCH_COUNT 4
+
+/**
+ * @brief criteria checked by handler before call, system runs when all given ones pass,
+ * zeroed one runs system every frame
+ *
+ * @note filter and watch are usually set by init, system with every_frames or rate_hz
+ * gets time since its previous run as delta_time
+ */
+typedef struct {
+    u16 every_frames;
+    float rate_hz;
+
+    DtEcsFilter* filter;
+    DtEcsObserver* watch[DT_RUN_WATCH_COUNT];
+} DtRunCondition;
+
 typedef void (*Action)(void*);
 typedef void (*CtxAction)(void*, DtUpdateContext*);
 typedef void (*Init)(DtEcsManager*, void*);
+typedef DtSliceResult (*SliceAction)(void*, DtSliceContext*);
 
 /**
  * @brief Контейнер для функций системы
  * NULL
+ *
+ * @note slice is optional work spread over frames, it's called after update of all
+ * systems while it returns DT_SLICE_PENDING and frame budget of handler isn't spent
+ * @note fixed_update runs before update zero or more times per frame with
+ * fixed_delta_time of context, run_if isn't checked for it
  */
 typedef struct {
     void* data;
 
     Init init;
     CtxAction update;
+    CtxAction fixed_update;
+    SliceAction slice;
     Action destroy;
 
     i16 priority;
+    DtRunCondition run_if;
 } UpdateSystem;
 
+/**
+ * @brief true when frame budget of slices is spent
+ */
+bool dt_slice_expired(const DtSliceContext* ctx);
+
+/**
+ * @brief stackless coroutine over cursor of slice, locals don't survive yield, keep them
+ * in system data, one yield per line
+ */
+#define DT_SLICE_BEGIN(ctx)                                                                        \
+    switch ((ctx)->cursor) {                                                                       \
+        case 0:
+
+#define DT_SLICE_YIELD(ctx)                                                                        \
+    do {                                                                                           \
+        (ctx)->cursor = __LINE__;                                                                  \
+        return DT_SLICE_PENDING;                                                                   \
+        case __LINE__:;                                                                            \
+    } while (0)
+
+/**
+ * @brief yield only when frame budget is spent
+ */
+#define DT_SLICE_YIELD_EXPIRED(ctx)                                                                \
+    do {                                                                                           \
+        if (dt_slice_expired(ctx)) {                                                               \
+            (ctx)->cursor = __LINE__;                                                              \
+            return DT_SLICE_PENDING;                                                               \
+        }                                                                                          \
+        case __LINE__:;                                                                            \
+    } while (0)
+
+#define DT_SLICE_END(ctx)                                                                          \
+    }                                                                                              \
+    (ctx)->cursor = 0;                                                                             \
+    return DT_SLICE_DONE
+
+/*=============================================================================
+ *                        Доступ систем к пулам (DtSystemAccess)
+ *============================================================================*/
+
+/**
+ * @brief pools which system reads and writes, ids are ecs_manager_id of handler manager
+ *
+ * @note without DT_READS_ATTR, DT_WRITES_ATTR or DT_EXCLUSIVE_ATTR on registration every
+ * pool fetched by system init (filters included) is counted as written, system that
+ * fetched nothing is exclusive
+ */
+typedef struct {
+    DT_VEC(u16) reads;
+    DT_VEC(u16) writes;
+    bool exclusive;
+
+    bool structural;
+    bool structural_found;
+} DtSystemAccess;
+
+/**
+ * @brief access of system which init is running now, pools fetched by
+ * dt_ecs_manager_get_pool are written into it, NULL outside of handler init,
+ * it's per thread since worlds may be initialized in parallel
+ */
+extern _Thread_local DtSystemAccess* dt_current_system_access;
+
+/**
+ * @brief access of system which update is running now on calling thread, NULL outside of it
+ */
+extern _Thread_local DtSystemAccess* dt_running_system_access;
+
+/**
+ * @brief true while running system may run together with others of parallel schedule
+ */
+extern _Thread_local bool dt_running_system_concurrent;
+
+/**
+ * @brief called before undeclared structural change, it's fatal while other systems may
+ * run at the same time, otherwise system becomes structural and handler rebuilds schedule
+ * before next frame
+ */
+void dt_system_access_found_structural(DtSystemAccess* access);
+
+#define DT_SYSTEM_STRUCTURAL_CHANGE()                                                              \
+    ({                                                                                             \
+        if (dt_running_system_access && !dt_running_system_access->structural)                     \
+            dt_system_access_found_structural(dt_running_system_access);                           \
+    })
+
+void dt_system_access_read(DtSystemAccess* access, u16 ecs_manager_id);
+void dt_system_access_write(DtSystemAccess* access, u16 ecs_manager_id);
+
+/**
+ * @brief true if systems can't run at the same time
+ */
+bool dt_system_access_conflicts(const DtSystemAccess* first, const DtSystemAccess* second);
+
+/**
+ * @brief fill access from DT_READS_ATTR, DT_WRITES_ATTR and DT_EXCLUSIVE_ATTR of system
+ * registration, return false if none of them is given
+ */
+bool dt_system_access_declare(DtSystemAccess* access, DtEcsManager* manager,
+                              const DtAttributeData* attributes, u16 attribute_count);
+
+void dt_system_access_clear(DtSystemAccess* access);
+
+/*=============================================================================
+ *                       Граф выполнения систем (DtSystemSchedule)
+ *============================================================================*/
+
+/**
+ * @brief dependency graph of systems run as jobs, conflicting systems keep
+ * priority order, others may run concurrently
+ */
+typedef struct DtSystemSchedule DtSystemSchedule;
+
+typedef void (*DtSystemRun)(void* data, u16 system);
+
+DtSystemSchedule* dt_system_schedule_new(void);
+
+/**
+ * @brief build edges between conflicting systems, access is ordered by priority
+ */
+void dt_system_schedule_build(DtSystemSchedule* schedule, const DtSystemAccess* access,
+                              u16 count);
+
+u16 dt_system_schedule_count(const DtSystemSchedule* schedule);
+
+/**
+ * @brief true if system after waits for system before
+ */
+bool dt_system_schedule_depends(const DtSystemSchedule* schedule, u16 before, u16 after);
+
+/**
+ * @brief run every system once on job workers, calling thread helps until all are done
+ */
+void dt_system_schedule_run(DtSystemSchedule* schedule, DtSystemRun run, void* data);
+
+void dt_system_schedule_free(DtSystemSchedule* schedule);
+
 /*=============================================================================
  *                         Обработчик систем (SystemHandler)
  *============================================================================*/
 
+#define DT_UPDATE_SLICE_BUDGET_NS 1000000ULL
+#define DT_UPDATE_FIXED_MAX_STEPS 5
+
+/**
+ * @brief progress of system to next run by its DtRunCondition
+ */
+typedef struct {
+    u16 frames;
+    float elapsed;
+    u64 last_ns;
+} DtRunState;
+
+typedef struct {
+    u32 cursor;
+    u64 done_frame;
+} DtSliceState;
+
+/**
+ * @brief sliced work of handler systems, they share budget in turns and the first
+ * called one runs even when budget is spent, so every system makes progress
+ */
+typedef struct {
+    DT_VEC(DtSliceState) states;
+    u16 sliced_count;
+    u16 next;
+    u64 frame;
+    u64 budget_ns;
+} DtUpdateSlices;
+
+/**
+ * @brief time of frames which isn't simulated by fixed steps yet, steps over max_steps
+ * are dropped so slow frame doesn't make next ones slower
+ */
+typedef struct {
+    float accumulator;
+    u16 max_steps;
+    u16 fixed_count;
+} DtUpdateFixed;
+
 /**
  * @brief Контейнер, в котором системы сгруппированы по функциям
  */
@@ -458,6 +1075,17 @@ typedef struct {
     DtEcsManager* manager;
     DT_VEC(UpdateSystem*) systems;
     DT_VEC(char*) names;
+#ifdef DT_PROFILE_SYSTEMS
+    DT_VEC(DtSystemStats) stats;
+#endif /*DT_PROFILE_SYSTEMS*/
+    DT_VEC(DtSystemAccess) access;
+    DT_VEC(DtRunState) runs;
+
+    DtSystemSchedule* schedule;
+    bool parallel;
+
+    DtUpdateSlices* slices;
+    DtUpdateFixed* fixed;
 } UpdateHandler;
 
 UpdateHandler* dt_update_handler_new(DtEcsManager* manager, u16 updater_count);
@@ -465,8 +1093,37 @@ void dt_update_handler_add(UpdateHandler* handler, UpdateSystem* system, char* n
 void dt_update_handler_init(const UpdateHandler* handler);
 void dt_update_handler_update(const UpdateHandler* handler, DtUpdateContext* ctx);
 void dt_update_handler_destroy(const UpdateHandler* handler);
+/**
+ * @brief remove all systems from handler, systems aren't destroyed
+ */
+void dt_update_handler_clear(UpdateHandler* handler);
 void dt_update_handler_free(UpdateHandler* handler);
 
+/**
+ * @brief run independent systems as jobs, without job workers or when false
+ * systems run sequentially in priority order
+ *
+ * @note systems which add or remove components, create or kill entities must be registered
+ * with DT_STRUCTURAL_ATTR
+ */
+void dt_update_handler_set_parallel(UpdateHandler* handler, bool parallel);
+
+/**
+ * @brief time of frame given to slices of systems, DT_UPDATE_SLICE_BUDGET_NS by default
+ */
+void dt_update_handler_set_slice_budget(UpdateHandler* handler, u64 budget_ns);
+
+/**
+ * @brief most fixed steps run by one update, DT_UPDATE_FIXED_MAX_STEPS by default
+ */
+void dt_update_handler_set_fixed_max_steps(UpdateHandler* handler, u16 max_steps);
+
+/**
+ * @brief stats of system with name, NULL if system is unknown or profiling is disabled
+ */
+const DtSystemStats* dt_update_handler_get_stats(const UpdateHandler* handler, const char* name);
+void dt_update_handler_reset_stats(const UpdateHandler* handler);
+
 /*=============================================================================
  *                         Система отрисовки (DrawSystem)
  *============================================================================*/
@@ -476,6 +1133,40 @@ enum DRAW_LAYER{
     DT_CAMERA
 };
 
+/**
+ * @brief draw data copied from ECS by one draw system, skipped when extract didn't run
+ */
+typedef struct {
+    void* items;
+    u32 item_size;
+    u32 count;
+    size_t capacity;
+    bool skipped;
+} DtRenderStream;
+
+/**
+ * @brief copy draw data of system into stream, it runs after update and may run on worker
+ */
+typedef void (*Extract)(void* data, DtRenderStream* stream);
+
+/**
+ * @brief draw from extracted stream only, ECS pools may be updated at the same time
+ */
+typedef void (*DrawExtracted)(void* data, const DtRenderStream* stream);
+
+/**
+ * @brief return array for count items of item_size, previous items of stream are dropped,
+ * memory is reused between frames
+ */
+void* dt_render_stream_reserve(DtRenderStream* stream, u32 item_size, u32 count);
+void dt_render_stream_free(DtRenderStream* stream);
+
+/**
+ * @brief systems without extract draw from live pools in draw
+ *
+ * @note run_if is checked before extract if system has it, before draw otherwise, its
+ * rate is measured by clock, skipped draw leaves nothing on screen in that frame
+ */
 typedef struct {
     void* data;
     Init init;
@@ -483,23 +1174,95 @@ typedef struct {
     Action destroy;
     i16 priority;
 
+    Extract extract;
+    DrawExtracted draw_extracted;
+    DtRunCondition run_if;
 } DrawSystem;
 
 /*=============================================================================
  *                        Обработчик отрисовки (DrawHandler)
  *============================================================================*/
 
+/**
+ * @brief two frames of streams, one per system, extract fills one while other is drawn,
+ * alpha of fixed update goes with its frame
+ */
+typedef struct {
+    DT_VEC(DtRenderStream) frames[2];
+    float alpha[2];
+    u8 drawn;
+
+    /**
+     * @brief pools are updated by frame pipeline, systems without extract wait for its end
+     */
+    bool updating;
+    bool live_deferred;
+} DtRenderSnapshot;
+
+/**
+ * @brief alpha of fixed update for draw system which is running now on calling thread
+ */
+extern _Thread_local float dt_current_draw_alpha;
+
 typedef struct {
     DtEcsManager* manager;
     DT_VEC(DrawSystem*) systems;
     DT_VEC(char*) names;
+#ifdef DT_PROFILE_SYSTEMS
+    DT_VEC(DtSystemStats) stats;
+#endif /*DT_PROFILE_SYSTEMS*/
+    DT_VEC(DtRunState) runs;
+    DtRenderSnapshot* snapshot;
 } DrawHandler;
 
 DrawHandler* dt_draw_handler_new(DtEcsManager* manager, u16 drawers_count);
 void dt_draw_handler_add(DrawHandler* handler, const DrawSystem* system, char* name);
 void dt_draw_handler_init(const DrawHandler* handler);
+/**
+ * @brief draw systems with extract from drawn frame of snapshot, others from pools
+ *
+ * @note between dt_draw_handler_begin_update and dt_draw_handler_end_update systems
+ * without extract are drawn by end instead
+ */
 void dt_draw_handler_draw(const DrawHandler* handler);
+
+/**
+ * @brief pools of handler are updated from now, draw keeps only systems with extract
+ */
+void dt_draw_handler_begin_update(const DrawHandler* handler);
+
+/**
+ * @brief update of pools is done, draw systems without extract skipped by draw since begin
+ */
+void dt_draw_handler_end_update(const DrawHandler* handler);
+
+/**
+ * @brief run extract of systems into frame which isn't drawn
+ *
+ * @note it can run on worker while main thread draws, only next dt_draw_handler_swap shows it
+ */
+void dt_draw_handler_extract(const DrawHandler* handler);
+
+/**
+ * @brief make last extracted frame drawn one, call it when draw and extract are done
+ */
+void dt_draw_handler_swap(const DrawHandler* handler);
+
+/**
+ * @brief alpha of update which is extracted next, systems without extract see it at once
+ */
+void dt_draw_handler_set_alpha(const DrawHandler* handler, float alpha);
 void dt_draw_handler_destroy(const DrawHandler* handler);
+/**
+ * @brief remove all systems from handler, systems aren't destroyed
+ */
+void dt_draw_handler_clear(DrawHandler* handler);
 void dt_draw_handler_free(DrawHandler* handler);
 
+/**
+ * @brief stats of system with name, NULL if system is unknown or profiling is disabled
+ */
+const DtSystemStats* dt_draw_handler_get_stats(const DrawHandler* handler, const char* name);
+void dt_draw_handler_reset_stats(const DrawHandler* handler);
+
 #endif /* DT_ECS_H */
@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_FILTERS
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -5,8 +7,14 @@
 #include "Collections/Collections.h"
 #include "DtAllocators.h"
 #include "DtEcs.h"
+#include "Profiling/DtTrace.h"
 #include "RegisterHandler.h"
 
+/**
+ * @brief return pool of component, pool is created if manager hasn't it
+ */
+static DtEcsPool* ecs_manager_find_pool(DtEcsManager* manager, const char* name);
+
 /**
  * @brief compair two pools by id
  */
@@ -35,6 +43,17 @@ static void filter_remove_entity(DtEcsFilter* filter, DtEntity entity);
  */
 static void filter_resize(DtEcsFilter* filter, size_t new_size);
 
+/**
+ * @brief stop on change of filter which is iterated by dt_filter_parallel_for
+ */
+static void filter_check_unlocked(const DtEcsFilter* filter);
+
+/**
+ * @brief add or remove entity from every filter in list by its current components
+ */
+static void filter_sync_entity(const DtEcsManager* manager, DT_VEC(DtEcsFilter*) filters,
+                               DtEntity entity);
+
 /**
  * @brief free filter memory
  */
@@ -71,15 +90,23 @@ static int is_mask_compatible(const DtEcsManager* manager, DtEcsMask mask, DtEnt
  */
 static int is_mask_compatible_without(const DtEcsManager*, DtEcsMask, DtEntity, int);
 
+/**
+ * @brief file allocates filters, entity infos and pools table are allocated under own tags
+ */
+static void* entity_info_calloc(size_t count, size_t size);
+static void* entity_info_realloc(void* ptr, size_t size);
+static void* pools_table_calloc(size_t count, size_t size);
+static void* pools_table_realloc(void* ptr, size_t size);
+
 DtEcsMask dt_mask_new(DtEcsManager* manager, const u16 inc_size, const u16 exc_size) {
     return (DtEcsMask) {
         .manager = manager,
 
-        .include_pools = calloc(inc_size, sizeof(int)),
+        .include_pools = DT_CALLOC(inc_size, sizeof(int)),
         .include_size = inc_size,
         .include_count = 0,
 
-        .exclude_pools = calloc(inc_size, sizeof(int)),
+        .exclude_pools = DT_CALLOC(exc_size, sizeof(int)),
         .exclude_size = exc_size,
         .exclude_count = 0,
     };
@@ -122,6 +149,7 @@ static int cmp_pools(const void* id1, const void* id2) {
 }
 
 DtEcsFilter* dt_mask_end(DtEcsMask mask) {
+    DT_TRACE_FUNCTION();
     qsort(mask.include_pools, mask.include_count, sizeof(u16), cmp_pools);
     qsort(mask.exclude_pools, mask.exclude_count, sizeof(u16), cmp_pools);
 
@@ -140,7 +168,7 @@ DtEcsFilter* dt_mask_end(DtEcsMask mask) {
 }
 
 static DtEcsFilter* filter_new(DtEcsManager* manager, const DtEcsMask mask) {
-    DtEcsFilter* new_filter = malloc(sizeof(DtEcsFilter));
+    DtEcsFilter* new_filter = DT_MALLOC(sizeof(DtEcsFilter));
 
     *new_filter = (DtEcsFilter) {
         .manager = manager,
@@ -157,26 +185,52 @@ static DtEcsFilter* filter_new(DtEcsManager* manager, const DtEcsMask mask) {
 }
 
 static void filter_add_entity(DtEcsFilter* filter, DtEntity entity) {
+    filter_check_unlocked(filter);
     dt_entity_container_add(&filter->entities, entity, &entity);
 }
 
 static void filter_remove_entity(DtEcsFilter* filter, const DtEntity entity) {
+    filter_check_unlocked(filter);
     dt_entity_container_remove(&filter->entities, entity);
 }
 
 static void filter_resize(DtEcsFilter* filter, const size_t new_size) {
+    filter_check_unlocked(filter);
     dt_entity_container_resize(&filter->entities, new_size);
     filter->entities.entities_iterator.enumerable = &filter->entities;
     filter->entities.items_iterator.enumerable = &filter->entities;
 }
 
+static void filter_check_unlocked(const DtEcsFilter* filter) {
+    if (atomic_load_explicit(&filter->parallel_passes, memory_order_acquire) > 0) {
+        printf("cant change filter while it's iterated in parallel\n");
+        exit(1);
+    }
+}
+
+static void filter_sync_entity(const DtEcsManager* manager, DT_VEC(DtEcsFilter*) filters,
+                               const DtEntity entity) {
+    if (filters == NULL)
+        return;
+
+    FOREACH(DtEcsFilter*, filter, DT_VEC_ITERATOR(filters), {
+        const bool has = dt_entity_container_has(&filter->entities, entity);
+        const bool compatible = is_mask_compatible(manager, filter->mask, entity);
+
+        if (compatible && !has)
+            filter_add_entity(filter, entity);
+        else if (!compatible && has)
+            filter_remove_entity(filter, entity);
+    });
+}
+
 static void filter_free(DtEcsFilter* filter) {
     dt_entity_container_free(&filter->entities);
-    free(filter);
+    DT_FREE(filter);
 }
 
 DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg) {
-    DtEcsManager* manager = DT_MALLOC(sizeof(DtEcsManager));
+    DtEcsManager* manager = entity_info_calloc(1, sizeof(DtEcsManager));
 
     if (!manager) {
         // TODO: add handle
@@ -201,7 +255,7 @@ DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg) {
         cfg.filters_size = 50;
 
     *manager = (DtEcsManager) {
-        .sparse_entities = DT_CALLOC(cfg.sparse_size, sizeof(DtEntityInfo)),
+        .sparse_entities = entity_info_calloc(cfg.sparse_size, sizeof(DtEntityInfo)),
         .sparse_size = cfg.sparse_size,
         .entities_ptr = 0,
 
@@ -210,12 +264,12 @@ DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg) {
         .children_size = cfg.children_size,
         .component_count = cfg.components_count,
 
-        .recycled_entities = DT_CALLOC(cfg.recycle_size, sizeof(DtEntity)),
+        .recycled_entities = entity_info_calloc(cfg.recycle_size, sizeof(DtEntity)),
         .recycled_size = cfg.recycle_size,
         .recycled_ptr = 0,
 
         .pools = DT_VEC_NEW(DtEcsPool*, cfg.pools_size),
-        .pools_table = DT_CALLOC(cfg.pools_size, sizeof(DtEcsPool*)),
+        .pools_table = pools_table_calloc(cfg.pools_size, sizeof(DtEcsPool*)),
         .pools_table_size = cfg.pools_size,
 
         .include_mask_count = cfg.include_mask_count,
@@ -227,6 +281,9 @@ DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg) {
 
         .filter_by_include = DT_CALLOC(cfg.pools_size, sizeof(DT_VEC(DtEcsFilter*))),
         .filter_by_exclude = DT_CALLOC(cfg.pools_size, sizeof(DT_VEC(DtEcsFilter*))),
+
+        .events = DT_VEC_NEW(DtEventChannel*, 4),
+        .observers = DT_VEC_NEW(DtEcsObserver*, 4),
     };
 
     manager->hierarchy_dirty_pool = DT_ECS_MANAGER_GET_POOL(manager, HierarchyDirty);
@@ -234,8 +291,25 @@ DtEcsManager* dt_ecs_manager_new(DtEcsManagerConfig cfg) {
     return manager;
 }
 
+DtEcsManagerConfig dt_ecs_manager_get_config(const DtEcsManager* manager) {
+    return (DtEcsManagerConfig) {
+        .dense_size = manager->cfg_dense_size,
+        .sparse_size = manager->sparse_size,
+        .recycle_size = manager->cfg_recycle_size,
+        .children_size = manager->children_size,
+        .components_count = manager->component_count,
+        .pools_size = manager->pools_table_size,
+        .masks_size = manager->include_mask_count + manager->exclude_mask_count,
+        .include_mask_count = manager->include_mask_count,
+        .exclude_mask_count = manager->exclude_mask_count,
+        .filters_size = manager->filters_size,
+    };
+}
+
 DtEntity dt_ecs_manager_new_entity(DtEcsManager* manager) {
     DtEntity entity;
+    DT_SYSTEM_STRUCTURAL_CHANGE();
+    DT_SYSTEM_STATS_ADD(structural_changes, 1);
 
     if (manager->recycled_ptr > 0) {
         entity = manager->recycled_entities[--manager->recycled_ptr];
@@ -246,8 +320,8 @@ DtEntity dt_ecs_manager_new_entity(DtEcsManager* manager) {
         if (entity == manager->sparse_size) {
             printf("[DEBUG]\t need to resize sparse array\n");
             manager->sparse_size = manager->sparse_size ? 2 * manager->sparse_size : 8;
-            void* tmp =
-                DT_REALLOC(manager->sparse_entities, manager->sparse_size * sizeof(DtEntityInfo));
+            void* tmp = entity_info_realloc(manager->sparse_entities,
+                                            manager->sparse_size * sizeof(DtEntityInfo));
 
             if (!tmp) {
                 printf("entity add realloc failed\n");
@@ -407,12 +481,14 @@ void dt_ecs_manager_kill_entity(DtEcsManager* manager, const DtEntity entity) {
     if (!manager->sparse_entities[entity].alive)
         return;
 
+    DT_SYSTEM_STRUCTURAL_CHANGE();
+    DT_SYSTEM_STATS_ADD(structural_changes, 1);
     if (manager->recycled_ptr == manager->recycled_size) {
         printf("[DEBUG]\t need to resize recycle array\n");
 
         manager->recycled_size = manager->recycled_size ? 2 * manager->recycled_size : 8;
-        void* tmp =
-            DT_REALLOC(manager->recycled_entities, manager->recycled_size * sizeof(DtEntity));
+        void* tmp = entity_info_realloc(manager->recycled_entities,
+                                        manager->recycled_size * sizeof(DtEntity));
 
         if (!tmp) {
             printf("[DEBUG]entity kill realloc failed\n");
@@ -526,6 +602,16 @@ void dt_ecs_manager_add_pool(DtEcsManager* manager, DtEcsPool* pool) {
 }
 
 DtEcsPool* dt_ecs_manager_get_pool(DtEcsManager* manager, const char* name) {
+    DtEcsPool* pool = ecs_manager_find_pool(manager, name);
+
+    // pools fetched by system init make its access for parallel schedule
+    if (pool && dt_current_system_access)
+        dt_system_access_write(dt_current_system_access, pool->ecs_manager_id);
+
+    return pool;
+}
+
+static DtEcsPool* ecs_manager_find_pool(DtEcsManager* manager, const char* name) {
     const DtComponentData* data = dt_component_get_data_by_name(name);
     if (data == NULL)
         return NULL;
@@ -561,7 +647,7 @@ static void ecs_manager_resize_pools(DtEcsManager* manager) {
     memcpy(old_pools, manager->pools_table, old_size * sizeof(DtEcsPool*));
 
     void* tmp_pools =
-        DT_REALLOC(manager->pools_table, sizeof(DtEcsPool*) * manager->pools_table_size);
+        pools_table_realloc(manager->pools_table, sizeof(DtEcsPool*) * manager->pools_table_size);
 
     if (!tmp_pools) {
         printf("[DEBUG]\t Failed to allocate memory for new pools\n");
@@ -622,6 +708,7 @@ static DtEcsFilter* get_filter(DtEcsManager* manager, const DtEcsMask mask) {
     while (manager->filters[idx] != NULL) {
         if (manager->filters[idx]->mask.hash == hash) {
             filter = manager->filters[idx];
+            break;
         }
 
         idx = (idx + 1) % manager->filters_size;
@@ -631,8 +718,12 @@ static DtEcsFilter* get_filter(DtEcsManager* manager, const DtEcsMask mask) {
         }
     }
 
-    if (filter)
+    // mask is consumed by dt_mask_end, existing filter keeps own copy
+    if (filter) {
+        DT_FREE(mask.include_pools);
+        DT_FREE(mask.exclude_pools);
         return filter;
+    }
 
     filter = filter_new(manager, mask);
 
@@ -650,10 +741,11 @@ static DtEcsFilter* get_filter(DtEcsManager* manager, const DtEcsMask mask) {
 
         if (!list) {
             list = DT_VEC_NEW(DtEcsFilter*, mask.include_count);
-            manager->filter_by_include[mask.include_pools[i]] = list;
         }
 
+        // vec may be moved by growth
         DT_VEC_ADD(list, filter);
+        manager->filter_by_include[mask.include_pools[i]] = list;
     }
 
     for (int i = 0; i < mask.exclude_count; i++) {
@@ -661,10 +753,11 @@ static DtEcsFilter* get_filter(DtEcsManager* manager, const DtEcsMask mask) {
 
         if (!list) {
             list = DT_VEC_NEW(DtEcsFilter*, mask.exclude_count);
-            manager->filter_by_exclude[mask.exclude_pools[i]] = list;
         }
 
+        // vec may be moved by growth
         DT_VEC_ADD(list, filter);
+        manager->filter_by_exclude[mask.exclude_pools[i]] = list;
     }
 
     for (DtEntity i = 0; i < manager->entities_ptr; i++) {
@@ -690,8 +783,12 @@ static void ecs_manager_resize_filters(DtEcsManager* manager) {
     }
 
     manager->filters = tmp;
+    memset(manager->filters, 0, sizeof(DtEcsFilter*) * manager->filters_size);
 
     for (int i = 0; i < old_size; i++) {
+        if (old_filters[i] == NULL)
+            continue;
+
         u16 idx = old_filters[i]->mask.hash % manager->filters_size;
 
         while (manager->filters[idx] != NULL) {
@@ -714,6 +811,7 @@ void dt_on_entity_change(const DtEcsManager* manager, const DtEntity entity,
     DT_VEC(DtEcsFilter*)
     exclude_list = manager->filter_by_exclude[ecs_manager_component_id];
 
+    DT_SYSTEM_STATS_ADD(structural_changes, 1);
     if (added) {
         dt_entity_info_add_component(&manager->sparse_entities[entity], ecs_manager_component_id);
     } else {
@@ -756,6 +854,19 @@ void dt_on_entity_change(const DtEcsManager* manager, const DtEntity entity,
     }
 }
 
+void dt_ecs_manager_update_filters(const DtEcsManager* manager, const DtEntity* entities,
+                                   const u16 count) {
+    for (u16 i = 0; i < count; i++) {
+        const DtEntityInfo* info = &manager->sparse_entities[entities[i]];
+
+        for (u16 c = 0; c < info->component_count; c++) {
+            const u16 id = info->components[c];
+            filter_sync_entity(manager, manager->filter_by_include[id], entities[i]);
+            filter_sync_entity(manager, manager->filter_by_exclude[id], entities[i]);
+        }
+    }
+}
+
 static int is_mask_compatible(const DtEcsManager* manager, const DtEcsMask mask,
                               const DtEntity entity) {
     for (int i = 0; i < mask.include_count; i++) {
@@ -792,8 +903,8 @@ static int is_mask_compatible_without(const DtEcsManager* manager, const DtEcsMa
 }
 
 void dt_ecs_manager_free(DtEcsManager* manager) {
-    free(manager->sparse_entities);
-    free(manager->recycled_entities);
+    DT_FREE(manager->sparse_entities);
+    DT_FREE(manager->recycled_entities);
 
     for (int i = 0; i < dt_vec_count(manager->pools); i++) {
         if (manager->filter_by_include[i])
@@ -803,28 +914,32 @@ void dt_ecs_manager_free(DtEcsManager* manager) {
             dt_vec_free(manager->filter_by_exclude[i]);
     }
 
-    free(manager->filter_by_include);
-    free(manager->filter_by_exclude);
+    DT_FREE(manager->filter_by_include);
+    DT_FREE(manager->filter_by_exclude);
 
     FOREACH(DtEcsPool*, pool, DT_VEC_ITERATOR(manager->pools), { dt_ecs_pool_free(pool); });
 
     dt_vec_free(manager->pools);
-    free(manager->pools_table);
+    DT_FREE(manager->pools_table);
 
     for (int i = 0; i < manager->filters_size; i++) {
         if (manager->filters[i] == NULL)
             continue;
 
         if (manager->filters[i]->mask.include_pools)
-            free(manager->filters[i]->mask.include_pools);
+            DT_FREE(manager->filters[i]->mask.include_pools);
 
         if (manager->filters[i]->mask.exclude_pools)
-            free(manager->filters[i]->mask.exclude_pools);
+            DT_FREE(manager->filters[i]->mask.exclude_pools);
 
         filter_free(manager->filters[i]);
     }
 
-    free(manager);
+    DT_FREE(manager->filters);
+
+    dt_ecs_manager_free_events(manager);
+    dt_ecs_manager_free_observers(manager);
+    DT_FREE(manager);
 }
 
 void dt_remove_tool_components(const DtEcsManager* manager) { remove_hierarchy_dirty_tag(manager); }
@@ -837,3 +952,21 @@ static void remove_hierarchy_dirty_tag(const DtEcsManager* manager) {
         dt_ecs_pool_remove(manager->hierarchy_dirty_pool, i);
     }
 }
+
+#undef DT_ALLOC_TAG
+#define DT_ALLOC_TAG DT_ALLOC_ENTITY_INFO
+
+static void* entity_info_calloc(const size_t count, const size_t size) {
+    return DT_CALLOC(count, size);
+}
+
+static void* entity_info_realloc(void* ptr, const size_t size) { return DT_REALLOC(ptr, size); }
+
+#undef DT_ALLOC_TAG
+#define DT_ALLOC_TAG DT_ALLOC_POOLS
+
+static void* pools_table_calloc(const size_t count, const size_t size) {
+    return DT_CALLOC(count, size);
+}
+
+static void* pools_table_realloc(void* ptr, const size_t size) { return DT_REALLOC(ptr, size); }
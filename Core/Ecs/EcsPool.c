@@ -5,6 +5,16 @@
 #include <string.h>
 #include "RegisterHandler.h"
 
+/**
+ * @brief true if no entity of range is in pool, so range is added at once
+ */
+static bool ecs_pool_range_new(const DtEcsPool* pool, const DtEntity* entities, u16 count);
+
+/**
+ * @brief item of entity in range data, NULL for tags and ranges without data
+ */
+static const void* ecs_pool_range_item(const DtEcsPool* pool, const void* data, u16 index);
+
 DtEcsPool* dt_ecs_pool_new(const DtEcsManager* manager, const char* name, const u16 size) {
     return size != 0 ? dt_component_pool_new(manager, name, size) : dt_tag_pool_new(manager, name);
 }
@@ -23,13 +33,68 @@ void dt_ecs_pool_add(DtEcsPool* pool, const DtEntity entity, const void* data) {
     if (pool->has(pool->data, entity))
         return;
 
+    DT_SYSTEM_STRUCTURAL_CHANGE();
     pool->count++;
     pool->add(pool->data, entity, data);
 
     dt_on_entity_change(pool->manager, entity, pool->ecs_manager_id, true);
+    dt_ecs_pool_notify(pool, entity, DT_OBSERVE_ADD);
     printf("[DEBUG]\t entity \"%d\" was added to %s pool\n", entity, pool->name);
 }
 
+void dt_ecs_pool_add_range(DtEcsPool* pool, const DtEntity* entities, const u16 count,
+                           const void* data) {
+    if (pool == NULL || count == 0)
+        return;
+
+    // entities already in pool are skipped like by single add
+    if (!ecs_pool_range_new(pool, entities, count)) {
+        for (u16 i = 0; i < count; i++)
+            dt_ecs_pool_add(pool, entities[i], ecs_pool_range_item(pool, data, i));
+        return;
+    }
+
+    DT_SYSTEM_STRUCTURAL_CHANGE();
+    pool->count += count;
+    pool->add_range(pool->data, entities, count, data);
+
+    for (u16 i = 0; i < count; i++) {
+        dt_on_entity_change(pool->manager, entities[i], pool->ecs_manager_id, true);
+        dt_ecs_pool_notify(pool, entities[i], DT_OBSERVE_ADD);
+    }
+
+    printf("[DEBUG]\t %d entities were added to %s pool\n", count, pool->name);
+}
+
+void dt_ecs_pool_add_range_deferred(DtEcsPool* pool, const DtEntity* entities, const u16 count,
+                                    const void* data) {
+    if (pool == NULL || count == 0)
+        return;
+
+    if (!ecs_pool_range_new(pool, entities, count)) {
+        for (u16 i = 0; i < count; i++) {
+            if (!pool->has(pool->data, entities[i]))
+                dt_ecs_pool_add_range_deferred(pool, &entities[i], 1,
+                                               ecs_pool_range_item(pool, data, i));
+        }
+        return;
+    }
+
+    DT_SYSTEM_STRUCTURAL_CHANGE();
+    pool->count += count;
+    pool->add_range(pool->data, entities, count, data);
+    DT_SYSTEM_STATS_ADD(structural_changes, count);
+
+    for (u16 i = 0; i < count; i++) {
+        dt_entity_info_add_component(&pool->manager->sparse_entities[entities[i]],
+                                     pool->ecs_manager_id);
+        dt_ecs_pool_notify(pool, entities[i], DT_OBSERVE_ADD);
+    }
+
+    printf("[DEBUG]\t %d entities were added to %s pool without filter update\n", count,
+           pool->name);
+}
+
 inline void* dt_ecs_pool_get(const DtEcsPool* pool, const DtEntity entity) {
     return pool->get(pool->data, entity);
 }
@@ -58,11 +123,25 @@ void dt_ecs_pool_copy(DtEcsPool* pool, const DtEntity dst, const DtEntity src) {
     }
 }
 
+void dt_ecs_pool_set(DtEcsPool* pool, const DtEntity entity, const void* data) {
+    if (!pool->has(pool->data, entity))
+        return;
+
+    if (data && pool->type == DT_COMPONENT_POOL) {
+        const DtComponentPool* component_pool = (DtComponentPool*) pool->data;
+        memcpy(pool->get(pool->data, entity), data, component_pool->entities.item_size);
+    }
+
+    dt_ecs_pool_notify(pool, entity, DT_OBSERVE_SET);
+}
+
 inline void dt_ecs_pool_remove(DtEcsPool* pool, const DtEntity entity) {
     if (!pool->has(pool->data, entity))
         return;
 
+    DT_SYSTEM_STRUCTURAL_CHANGE();
     pool->count--;
+    dt_ecs_pool_notify(pool, entity, DT_OBSERVE_REMOVE);
     dt_on_entity_change(pool->manager, entity, pool->ecs_manager_id, false);
     pool->remove(pool->data, entity);
     printf("[DEBUG]\t entity \"%d\" was removed from %s pool\n", entity, pool->name);
@@ -70,4 +149,26 @@ inline void dt_ecs_pool_remove(DtEcsPool* pool, const DtEntity entity) {
 
 void dt_ecs_pool_resize(DtEcsPool* pool, const u64 size) { pool->resize(pool->data, size); }
 
-void dt_ecs_pool_free(DtEcsPool* pool) { pool->free(pool->data); }
+void dt_ecs_pool_free(DtEcsPool* pool) {
+    if (pool->observers)
+        dt_vec_free(pool->observers);
+
+    pool->free(pool->data);
+}
+
+static bool ecs_pool_range_new(const DtEcsPool* pool, const DtEntity* entities, const u16 count) {
+    for (u16 i = 0; i < count; i++) {
+        if (pool->has(pool->data, entities[i]))
+            return false;
+    }
+
+    return true;
+}
+
+static const void* ecs_pool_range_item(const DtEcsPool* pool, const void* data, const u16 index) {
+    if (data == NULL || pool->type != DT_COMPONENT_POOL)
+        return NULL;
+
+    const u32 size = ((const DtComponentPool*) pool->data)->entities.item_size;
+    return (const u8*) data + (size_t) index * size;
+}
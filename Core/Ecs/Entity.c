@@ -1,8 +1,11 @@
+#define DT_ALLOC_TAG DT_ALLOC_ENTITY_INFO
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "DtAllocators.h"
 #include "DtEcs.h"
+#include "Profiling/DtTrace.h"
 
 typedef struct {
     void* data;
@@ -200,7 +203,7 @@ void dt_entity_info_copy(DtEntityInfo* dst, const DtEntityInfo* src) {
     if (dst->component_size < src->component_size) {
         dst->component_size = src->component_size;
 
-        void* tmp = realloc(dst->components, dst->component_size * sizeof(int));
+        void* tmp = DT_REALLOC(dst->components, dst->component_size * sizeof(int));
 
         if (!tmp) {
             printf("[DEBUG] entity info realloc exception]\n");
@@ -246,6 +249,10 @@ static void entity_info_children_next(void* data) {
     info->children_iterator_ptr++;
 }
 
+// sparse sets below are shared by component pools and filters
+#undef DT_ALLOC_TAG
+#define DT_ALLOC_TAG DT_ALLOC_CONTAINERS
+
 DtEntityContainer dt_entity_container_new(const u32 item_size, const DtEntity dense_size,
                                           const DtEntity sparse_size, const DtEntity recycle_size,
                                           const DtResetItemHandler reset,
@@ -300,36 +307,32 @@ void dt_entity_container_add(DtEntityContainer* container, const DtEntity entity
     if (dt_entity_container_has(container, entity))
         return;
 
-    DtEntity e;
-
-    if (container->recycle_ptr) {
-        e = container->recycle_entities[container->recycle_ptr--];
-    } else {
-        if (container->count == container->dense_size) {
-            container->dense_size = container->dense_size ? container->dense_size * 2 : 10;
-            void* tmp =
-                DT_REALLOC(container->dense_items, container->dense_size * container->item_size);
-
-            if (!tmp) {
-                printf("[DEBUG] entity container realloc exception\n");
-                exit(1);
-            }
+    // dense array is kept packed by swap-remove, so new item always goes to the end
+    if (container->count == container->dense_size) {
+        DT_TRACE_ZONE("dt_entity_container_grow");
+        container->dense_size = container->dense_size ? container->dense_size * 2 : 10;
+        void* tmp =
+            DT_REALLOC(container->dense_items, container->dense_size * container->item_size);
 
-            container->dense_items = tmp;
+        if (!tmp) {
+            printf("[DEBUG] entity container realloc exception\n");
+            exit(1);
+        }
 
-            tmp = DT_REALLOC(container->entities, container->dense_size * sizeof(DtEntity));
+        container->dense_items = tmp;
 
-            if (!tmp) {
-                printf("[DEBUG] entity container realloc exception\n");
-                exit(1);
-            }
+        tmp = DT_REALLOC(container->entities, container->dense_size * sizeof(DtEntity));
 
-            container->entities = tmp;
+        if (!tmp) {
+            printf("[DEBUG] entity container realloc exception\n");
+            exit(1);
         }
 
-        e = container->count;
+        container->entities = tmp;
     }
 
+    const DtEntity e = container->count;
+
     void* target = (u8*) container->dense_items + e * container->item_size;
 
     if (data) {
@@ -367,6 +370,68 @@ void dt_entity_container_add(DtEntityContainer* container, const DtEntity entity
     container->count++;
 }
 
+void dt_entity_container_add_range(DtEntityContainer* container, const DtEntity* entities,
+                                   const u16 count, const void* data) {
+    if (count == 0)
+        return;
+
+    if (container->count + count > container->dense_size) {
+        DT_TRACE_ZONE("dt_entity_container_grow");
+        DtEntity new_size = container->dense_size ? container->dense_size : 10;
+        while (new_size < container->count + count)
+            new_size *= 2;
+
+        void* tmp = DT_REALLOC(container->dense_items, new_size * container->item_size);
+
+        if (!tmp) {
+            printf("[DEBUG] entity container realloc exception\n");
+            exit(1);
+        }
+
+        container->dense_items = tmp;
+
+        tmp = DT_REALLOC(container->entities, new_size * sizeof(DtEntity));
+
+        if (!tmp) {
+            printf("[DEBUG] entity container realloc exception\n");
+            exit(1);
+        }
+
+        container->entities = tmp;
+        container->dense_size = new_size;
+    }
+
+    u8* target = (u8*) container->dense_items + container->count * container->item_size;
+
+    if (data == NULL) {
+        for (u16 i = 0; i < count; i++) {
+            void* item = target + i * container->item_size;
+            if (container->auto_reset)
+                container->auto_reset(item);
+            else
+                memset(item, 0, container->item_size);
+        }
+    } else if (container->auto_copy) {
+        for (u16 i = 0; i < count; i++) {
+            container->auto_copy(target + i * container->item_size,
+                                 (const u8*) data + i * container->item_size);
+        }
+    } else {
+        memcpy(target, data, (size_t) count * container->item_size);
+    }
+
+    if (container->auto_init) {
+        for (u16 i = 0; i < count; i++)
+            container->auto_init(target + i * container->item_size);
+    }
+
+    memcpy(container->entities + container->count, entities, count * sizeof(DtEntity));
+    for (u16 i = 0; i < count; i++)
+        container->sparse_entities[entities[i]] = container->count + i;
+
+    container->count += count;
+}
+
 void dt_entity_container_remove(DtEntityContainer* container, const DtEntity entity) {
     if (entity > container->sparse_size)
         return;
@@ -374,19 +439,21 @@ void dt_entity_container_remove(DtEntityContainer* container, const DtEntity ent
         return;
 
 
-    void* entity_data =
-        container->dense_items + container->sparse_entities[entity] * container->item_size;
+    const DtEntity idx = container->sparse_entities[entity];
+    const DtEntity last = container->count - 1;
 
-    if (container->count > 1) {
-        const void* last_entity =
-            (u8*) container->dense_items +
-            container->sparse_entities[container->count - 1] * container->item_size;
+    if (idx != last) {
+        void* entity_data = (u8*) container->dense_items + idx * container->item_size;
+        const void* last_entity = (u8*) container->dense_items + last * container->item_size;
 
-        container->auto_copy(entity_data, last_entity);
+        if (container->auto_copy)
+            container->auto_copy(entity_data, last_entity);
+        else
+            memcpy(entity_data, last_entity, container->item_size);
 
-        const DtEntity last_id = container->entities[container->count - 1];
-        container->sparse_entities[last_id] = container->sparse_entities[entity];
-        container->entities[container->sparse_entities[entity]] = last_id;
+        const DtEntity last_id = container->entities[last];
+        container->sparse_entities[last_id] = idx;
+        container->entities[idx] = last_id;
     }
 
     container->sparse_entities[entity] = DT_ENTITY_NULL;
@@ -476,7 +543,8 @@ void dt_entity_container_copy(DtEntityContainer* container, const DtEntity dst,
 }
 
 void dt_entity_container_resize(DtEntityContainer* container, u16 new_size) {
-    void* tmp = realloc(container->sparse_entities, new_size);
+    DT_TRACE_FUNCTION();
+    void* tmp = DT_REALLOC(container->sparse_entities, new_size * sizeof(DtEntity));
 
     if (!tmp) {
         printf("[DEBUG]memory allocation exception");
@@ -484,6 +552,10 @@ void dt_entity_container_resize(DtEntityContainer* container, u16 new_size) {
     }
 
     container->sparse_entities = tmp;
+
+    for (DtEntity i = container->sparse_size; i < new_size; i++)
+        container->sparse_entities[i] = DT_ENTITY_NULL;
+    container->sparse_size = new_size;
 }
 
 static void default_entity_item_reset(void* data) {
@@ -500,10 +572,10 @@ static void default_entity_item_copy(void* dst, const void* src) {
 }
 
 void dt_entity_container_free(DtEntityContainer* container) {
-    free(container->dense_items);
-    free(container->entities);
-    free(container->sparse_entities);
-    free(container->recycle_entities);
+    DT_FREE(container->dense_items);
+    DT_FREE(container->entities);
+    DT_FREE(container->sparse_entities);
+    DT_FREE(container->recycle_entities);
 }
 
 static void entity_container_items_start(void* data) {
@@ -512,6 +584,7 @@ static void entity_container_items_start(void* data) {
 
 static void* entity_container_items_current(void* data) {
     const DtEntityContainer* container = data;
+    DT_SYSTEM_STATS_ADD(entities_visited, 1);
     return container->dense_items + container->items_iterator_ptr * container->item_size;
 }
 
@@ -531,6 +604,7 @@ static void entity_container_entities_start(void* data) {
 
 static void* entity_container_entities_current(void* data) {
     const DtEntityContainer* container = data;
+    DT_SYSTEM_STATS_ADD(entities_visited, 1);
     return &container->entities[container->entities_iterator_ptr];
 }
 
@@ -0,0 +1,115 @@
+#define DT_ALLOC_TAG DT_ALLOC_SYSTEMS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DtAllocators.h"
+#include "RegisterHandler.h"
+#include "scheduler/RuntimeScheduler.h"
+
+static u64 size = 0;
+static int id_counter = 0;
+static const DtEventData** event_data_by_id = NULL;
+static const DtEventData** event_data_by_name = NULL;
+
+/**
+ * @brief search event in loaded modules, list of modules is read only while
+ * worlds simulate
+ */
+static const DtEventData* dt_event_get_from_modules(const char* name);
+
+void dt_event_increment_count() { size++; }
+
+static int dt_event_get_hash(const char* name) {
+    int hash = 2147483647;
+    while (*name) {
+        hash ^= *name++;
+        hash *= 314159;
+    }
+    return hash;
+}
+
+void dt_event_register(DtEventData* data) {
+    if (dt_registries_frozen()) {
+        fprintf(stderr, "[WARNING] registries are frozen, %s event isn't registered\n",
+                data->name);
+        return;
+    }
+
+    if (!size)
+        size = 107ULL;
+    if (!event_data_by_id) {
+        event_data_by_id = DT_CALLOC(size, sizeof(DtEventData*));
+        event_data_by_name = DT_CALLOC(size, sizeof(DtEventData*));
+        if (!event_data_by_id || !event_data_by_name) {
+            printf("[DEBUG]\t Failed to allocate memory for events\n");
+            exit(1);
+        }
+    }
+
+    data->hash = dt_event_get_hash(data->name);
+    u64 idx = data->hash % size;
+    const u64 start = idx;
+    while (event_data_by_name[idx] != NULL) {
+        if (strcmp(data->name, event_data_by_name[idx]->name) == 0)
+            return;
+
+        idx = (idx + 1) % size;
+        if (idx == start) {
+            printf("[DEBUG] event count out of range");
+            exit(1);
+        }
+    }
+
+    data->id = id_counter++;
+    event_data_by_id[data->id] = data;
+    event_data_by_name[idx] = data;
+    printf("[DEBUG] %s event was registered with id %d\n", data->name, data->id);
+}
+
+const DtEventData* dt_event_get_data_by_id(const u16 id) {
+    if (id >= id_counter) {
+        return NULL;
+    }
+
+    return event_data_by_id[id];
+}
+
+const DtEventData* dt_event_get_data_by_name(const char* name) {
+    if (!event_data_by_name)
+        return dt_event_get_from_modules(name);
+
+    u64 idx = dt_event_get_hash(name) % size;
+    const u64 start = idx;
+
+    while (event_data_by_name[idx] != NULL && strcmp(event_data_by_name[idx]->name, name) != 0) {
+        idx = (idx + 1) % size;
+        if (idx == start)
+            return dt_event_get_from_modules(name);
+    }
+
+    if (event_data_by_name[idx] != NULL) {
+        return event_data_by_name[idx];
+    }
+
+    return dt_event_get_from_modules(name);
+}
+
+const DtEventData** dt_event_get_all(u16* size_out) {
+    *size_out = id_counter;
+    return event_data_by_id;
+}
+
+static const DtEventData* dt_event_get_from_modules(const char* name) {
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
+        const DtEventData* data = env->modules_list[i]->environment->get_event(name);
+        if (data)
+            return data;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,224 @@
+#define DT_ALLOC_TAG DT_ALLOC_CONTAINERS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "DtEcs.h"
+#include "RegisterHandler.h"
+
+#define EVENT_BLOCK_BYTES 4096
+
+/**
+ * @brief reserved may run over capacity, such writers move to next block
+ */
+struct DtEventBlock {
+    DtEventBlock* next;
+    atomic_uint reserved;
+    u32 capacity;
+    u8 events[];
+};
+
+static DtEventChannel* channel_new(const DtEventData* data);
+static void channel_free(DtEventChannel* channel);
+
+static DtEventBlock* block_new(u32 event_size);
+static u32 block_count(DtEventBlock* block);
+
+/**
+ * @brief make block after full one current, blocks of previous frames are reused
+ */
+static void buffer_grow(DtEventChannel* channel, DtEventBuffer* buffer, DtEventBlock* full);
+static void buffer_clear(DtEventBuffer* buffer);
+
+static void events_iterator_start(void* data);
+static void* events_iterator_current(void* data);
+static bool events_iterator_has_current(void* data);
+static void events_iterator_next(void* data);
+
+void dt_event_send(DtEventChannel* channel, const void* event) {
+    DtEventBuffer* buffer = &channel->buffers[channel->write];
+
+    while (true) {
+        DtEventBlock* block = atomic_load_explicit(&buffer->current, memory_order_acquire);
+        const u32 slot = atomic_fetch_add_explicit(&block->reserved, 1, memory_order_relaxed);
+        if (slot < block->capacity) {
+            memcpy(block->events + (size_t) slot * channel->event_size, event,
+                   channel->event_size);
+            return;
+        }
+
+        buffer_grow(channel, buffer, block);
+    }
+}
+
+u32 dt_events_count(const DtEventChannel* channel) {
+    u32 count = 0;
+    for (DtEventBlock* block = channel->buffers[channel->write ^ 1].head; block;
+         block = block->next)
+        count += block_count(block);
+
+    return count;
+}
+
+void dt_events_begin(DtEventReader* reader, const DtEventChannel* channel) {
+    *reader = (DtEventReader) {
+        .iterator =
+            {
+                .start = events_iterator_start,
+                .current = events_iterator_current,
+                .has_current = events_iterator_has_current,
+                .next = events_iterator_next,
+                .enumerable = reader,
+            },
+        .channel = channel,
+    };
+}
+
+DtEventChannel* dt_ecs_manager_get_events(DtEcsManager* manager, const char* name) {
+    const DtEventData* data = dt_event_get_data_by_name(name);
+    if (!data)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(manager->events); i++) {
+        if (manager->events[i]->hash == data->hash)
+            return manager->events[i];
+    }
+
+    DtEventChannel* channel = channel_new(data);
+    DT_VEC_ADD(manager->events, channel);
+
+    return channel;
+}
+
+void dt_ecs_manager_swap_events(const DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->events); i++) {
+        DtEventChannel* channel = manager->events[i];
+
+        channel->write ^= 1;
+        buffer_clear(&channel->buffers[channel->write]);
+    }
+}
+
+void dt_ecs_manager_clear_events(const DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->events); i++) {
+        DtEventChannel* channel = manager->events[i];
+
+        buffer_clear(&channel->buffers[0]);
+        buffer_clear(&channel->buffers[1]);
+    }
+}
+
+void dt_ecs_manager_free_events(DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->events); i++)
+        channel_free(manager->events[i]);
+
+    dt_vec_free(manager->events);
+    manager->events = NULL;
+}
+
+static DtEventChannel* channel_new(const DtEventData* data) {
+    DtEventChannel* channel = DT_MALLOC(sizeof(DtEventChannel));
+    if (!channel) {
+        printf("[DEBUG]\t Failed to allocate memory for event channel\n");
+        exit(1);
+    }
+
+    *channel = (DtEventChannel) {
+        .name = data->name,
+        .hash = data->hash,
+        .event_size = data->size,
+        .write = 0,
+        .grow_lock = ATOMIC_FLAG_INIT,
+    };
+
+    for (u8 i = 0; i < 2; i++) {
+        channel->buffers[i].head = block_new(channel->event_size);
+        atomic_init(&channel->buffers[i].current, channel->buffers[i].head);
+    }
+
+    return channel;
+}
+
+static void channel_free(DtEventChannel* channel) {
+    for (u8 i = 0; i < 2; i++) {
+        DtEventBlock* block = channel->buffers[i].head;
+        while (block) {
+            DtEventBlock* next = block->next;
+            DT_FREE(block);
+            block = next;
+        }
+    }
+
+    DT_FREE(channel);
+}
+
+static DtEventBlock* block_new(const u32 event_size) {
+    const u32 capacity = event_size < EVENT_BLOCK_BYTES ? EVENT_BLOCK_BYTES / event_size : 1;
+
+    DtEventBlock* block = DT_MALLOC(sizeof(DtEventBlock) + (size_t) capacity * event_size);
+    if (!block) {
+        printf("[DEBUG]\t Failed to allocate memory for event block\n");
+        exit(1);
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    atomic_init(&block->reserved, 0);
+
+    return block;
+}
+
+static u32 block_count(DtEventBlock* block) {
+    const u32 reserved = atomic_load_explicit(&block->reserved, memory_order_relaxed);
+    return reserved < block->capacity ? reserved : block->capacity;
+}
+
+static void buffer_grow(DtEventChannel* channel, DtEventBuffer* buffer, DtEventBlock* full) {
+    while (atomic_flag_test_and_set_explicit(&channel->grow_lock, memory_order_acquire)) {
+    }
+
+    // other writer may have moved to next block already
+    if (atomic_load_explicit(&buffer->current, memory_order_relaxed) == full) {
+        if (!full->next)
+            full->next = block_new(channel->event_size);
+        atomic_store_explicit(&buffer->current, full->next, memory_order_release);
+    }
+
+    atomic_flag_clear_explicit(&channel->grow_lock, memory_order_release);
+}
+
+static void buffer_clear(DtEventBuffer* buffer) {
+    for (DtEventBlock* block = buffer->head; block; block = block->next)
+        atomic_store_explicit(&block->reserved, 0, memory_order_relaxed);
+
+    atomic_store_explicit(&buffer->current, buffer->head, memory_order_relaxed);
+}
+
+static void events_iterator_start(void* data) {
+    DtEventReader* reader = data;
+    reader->block = reader->channel->buffers[reader->channel->write ^ 1].head;
+    reader->index = 0;
+}
+
+static void* events_iterator_current(void* data) {
+    const DtEventReader* reader = data;
+    return reader->block->events + (size_t) reader->index * reader->channel->event_size;
+}
+
+static bool events_iterator_has_current(void* data) {
+    const DtEventReader* reader = data;
+    return reader->block && reader->index < block_count(reader->block);
+}
+
+static void events_iterator_next(void* data) {
+    DtEventReader* reader = data;
+
+    reader->index++;
+    if (reader->index < block_count(reader->block))
+        return;
+
+    reader->block = reader->block->next;
+    reader->index = 0;
+}
@@ -0,0 +1,292 @@
+#define DT_ALLOC_TAG DT_ALLOC_FILTERS
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "DtEcs.h"
+#include "Jobs/DtJobs.h"
+#include "Profiling/DtTrace.h"
+
+#define FILTER_MAX_CHUNKS 256
+#define FILTER_CHUNKS_PER_THREAD 4
+#define FILTER_MIN_CHUNK_SIZE 64
+#define FILTER_SCRATCH_BLOCK_SIZE (16 * 1024)
+#define FILTER_COMMANDS_BLOCK_SIZE 4096
+
+typedef enum { COMMAND_ADD, COMMAND_REMOVE, COMMAND_KILL } EcsCommandType;
+
+typedef struct {
+    EcsCommandType type;
+    DtEcsPool* pool;
+    DtEntity entity;
+    void* data;
+} EcsCommand;
+
+/**
+ * @brief component data of commands is copied into arena
+ */
+struct DtEcsCommandBuffer {
+    DtEcsManager* manager;
+    DT_VEC(EcsCommand) commands;
+    DtArena data;
+};
+
+typedef struct {
+    DtArena scratch;
+    DtEcsCommandBuffer commands;
+} FilterThreadState;
+
+typedef struct FilterPass FilterPass;
+
+typedef struct {
+    FilterPass* pass;
+    u16 start;
+    u16 count;
+} FilterChunk;
+
+/**
+ * @brief state of one dt_filter_parallel_for, passes are reused so steady frames
+ * don't allocate
+ */
+struct FilterPass {
+    DtEcsFilter* filter;
+    DtFilterChunkFunc fn;
+    void* user;
+
+    FilterThreadState* threads;
+    u16 threads_count;
+
+    /**
+     * @brief main thread and threads outside of pool share last state, one of them holds it
+     */
+    _Atomic(void*) shared_owner;
+
+    FilterChunk chunks[FILTER_MAX_CHUNKS];
+    DtJobCounter counter;
+
+    FilterPass* next;
+};
+
+static FilterPass* free_passes = NULL;
+static pthread_mutex_t passes_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// address of it tells threads sharing last index apart
+static _Thread_local char thread_token;
+
+/**
+ * @brief take free pass or create new one with state for every job thread
+ */
+static FilterPass* pass_acquire(void);
+static void pass_release(FilterPass* pass);
+static void pass_free_threads(FilterPass* pass);
+
+static u16 pass_chunk_size(u16 count, u16 chunk_size);
+static void pass_run_chunk(void* data);
+
+/**
+ * @brief apply and clear commands of every thread
+ */
+static void pass_apply_commands(FilterPass* pass);
+
+void dt_filter_parallel_for(DtEcsFilter* filter, const u16 chunk_size, const DtFilterChunkFunc fn,
+                            void* user) {
+    DT_TRACE_FUNCTION();
+    const u16 count = filter->entities.count;
+    if (count == 0)
+        return;
+
+    FilterPass* pass = pass_acquire();
+    pass->filter = filter;
+    pass->fn = fn;
+    pass->user = user;
+
+    atomic_fetch_add_explicit(&filter->parallel_passes, 1, memory_order_acq_rel);
+
+    const u16 size = pass_chunk_size(count, chunk_size);
+    u16 chunks = 0;
+    for (u32 start = 0; start < count; start += size) {
+        pass->chunks[chunks] = (FilterChunk) {
+            .pass = pass,
+            .start = start,
+            .count = count - start < size ? count - start : size,
+        };
+        dt_job_submit(pass_run_chunk, &pass->chunks[chunks], &pass->counter);
+        chunks++;
+    }
+
+    dt_job_wait(&pass->counter);
+
+    // commands may change this filter too, so it's unlocked first
+    atomic_fetch_sub_explicit(&filter->parallel_passes, 1, memory_order_acq_rel);
+    pass_apply_commands(pass);
+    pass_release(pass);
+}
+
+void dt_ecs_commands_add(DtEcsCommandBuffer* commands, DtEcsPool* pool, const DtEntity entity,
+                         const void* data) {
+    void* copy = NULL;
+    if (pool->type == DT_COMPONENT_POOL && data) {
+        const u32 size = ((DtComponentPool*) pool->data)->entities.item_size;
+        copy = dt_arena_alloc(&commands->data, size);
+        memcpy(copy, data, size);
+    }
+
+    DT_VEC_ADD(commands->commands, ((EcsCommand) {
+                                       .type = COMMAND_ADD,
+                                       .pool = pool,
+                                       .entity = entity,
+                                       .data = copy,
+                                   }));
+}
+
+void dt_ecs_commands_remove(DtEcsCommandBuffer* commands, DtEcsPool* pool, const DtEntity entity) {
+    DT_VEC_ADD(commands->commands, ((EcsCommand) {
+                                       .type = COMMAND_REMOVE,
+                                       .pool = pool,
+                                       .entity = entity,
+                                   }));
+}
+
+void dt_ecs_commands_kill(DtEcsCommandBuffer* commands, const DtEntity entity) {
+    DT_VEC_ADD(commands->commands, ((EcsCommand) {
+                                       .type = COMMAND_KILL,
+                                       .entity = entity,
+                                   }));
+}
+
+static FilterPass* pass_acquire(void) {
+    pthread_mutex_lock(&passes_lock);
+    FilterPass* pass = free_passes;
+    if (pass)
+        free_passes = pass->next;
+    pthread_mutex_unlock(&passes_lock);
+
+    if (!pass) {
+        pass = DT_CALLOC(1, sizeof(FilterPass));
+        if (!pass) {
+            printf("[DEBUG]\t Failed to allocate memory for filter pass\n");
+            exit(1);
+        }
+    }
+
+    // job threads may be restarted with other count between passes
+    const u16 threads_count = dt_jobs_threads_count();
+    if (pass->threads_count == threads_count)
+        return pass;
+
+    pass_free_threads(pass);
+    pass->threads = DT_CALLOC(threads_count, sizeof(FilterThreadState));
+    if (!pass->threads) {
+        printf("[DEBUG]\t Failed to allocate memory for filter pass\n");
+        exit(1);
+    }
+    pass->threads_count = threads_count;
+
+    for (u16 i = 0; i < threads_count; i++) {
+        pass->threads[i] = (FilterThreadState) {
+            .scratch = dt_arena_new(FILTER_SCRATCH_BLOCK_SIZE),
+            .commands =
+                {
+                    .commands = DT_VEC_NEW(EcsCommand, 16),
+                    .data = dt_arena_new(FILTER_COMMANDS_BLOCK_SIZE),
+                },
+        };
+    }
+
+    return pass;
+}
+
+static void pass_release(FilterPass* pass) {
+    pass->filter = NULL;
+    pass->fn = NULL;
+    pass->user = NULL;
+
+    pthread_mutex_lock(&passes_lock);
+    pass->next = free_passes;
+    free_passes = pass;
+    pthread_mutex_unlock(&passes_lock);
+}
+
+static void pass_free_threads(FilterPass* pass) {
+    for (u16 i = 0; i < pass->threads_count; i++) {
+        dt_arena_free(&pass->threads[i].scratch);
+        dt_arena_free(&pass->threads[i].commands.data);
+        dt_vec_free(pass->threads[i].commands.commands);
+    }
+
+    DT_FREE(pass->threads);
+    pass->threads = NULL;
+    pass->threads_count = 0;
+}
+
+static u16 pass_chunk_size(const u16 count, u16 chunk_size) {
+    // without workers whole filter is one chunk
+    if (chunk_size == 0 && dt_jobs_threads_count() == 1)
+        return count;
+
+    if (chunk_size == 0) {
+        chunk_size = count / (dt_jobs_threads_count() * FILTER_CHUNKS_PER_THREAD);
+        if (chunk_size < FILTER_MIN_CHUNK_SIZE)
+            chunk_size = FILTER_MIN_CHUNK_SIZE;
+    }
+
+    // chunks of pass are stored in place, too small chunks are widened
+    const u16 min_size = (count + FILTER_MAX_CHUNKS - 1) / FILTER_MAX_CHUNKS;
+    return chunk_size < min_size ? min_size : chunk_size;
+}
+
+static void pass_run_chunk(void* data) {
+    const FilterChunk* chunk = data;
+    FilterPass* pass = chunk->pass;
+
+    const u16 thread = dt_jobs_thread_index();
+    bool claimed = false;
+    if (thread == pass->threads_count - 1) {
+        void* owner = NULL;
+        claimed = atomic_compare_exchange_strong_explicit(&pass->shared_owner, &owner,
+                                                          &thread_token, memory_order_acquire,
+                                                          memory_order_acquire);
+
+        // state is held by other thread, chunk is left for pool or for it
+        if (!claimed && owner != &thread_token) {
+            dt_job_submit(pass_run_chunk, data, &pass->counter);
+            return;
+        }
+    }
+
+    FilterThreadState* state = &pass->threads[thread];
+    state->commands.manager = pass->filter->manager;
+
+    DtFilterChunkContext ctx = {
+        .scratch = &state->scratch,
+        .commands = &state->commands,
+        .thread = thread,
+    };
+    pass->fn(pass->filter->entities.entities + chunk->start, chunk->count, &ctx, pass->user);
+
+    if (claimed)
+        atomic_store_explicit(&pass->shared_owner, NULL, memory_order_release);
+}
+
+static void pass_apply_commands(FilterPass* pass) {
+    for (u16 i = 0; i < pass->threads_count; i++) {
+        FilterThreadState* state = &pass->threads[i];
+        DtEcsCommandBuffer* commands = &state->commands;
+
+        FOREACH(EcsCommand, command, DT_VEC_ITERATOR(commands->commands), {
+            if (command.type == COMMAND_ADD)
+                dt_ecs_pool_add(command.pool, command.entity, command.data);
+            else if (command.type == COMMAND_REMOVE)
+                dt_ecs_pool_remove(command.pool, command.entity);
+            else
+                dt_ecs_manager_kill_entity(commands->manager, command.entity);
+        });
+
+        dt_vec_header(commands->commands)->count = 0;
+        dt_arena_clear(&commands->data);
+        dt_arena_clear(&state->scratch);
+    }
+}
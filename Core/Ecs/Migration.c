@@ -0,0 +1,229 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DtAllocators.h"
+#include "DtEcs.h"
+#include "RegisterHandler.h"
+
+/**
+ * @brief deep copy of string array, NULL array stays NULL
+ */
+static char** copy_strings(char* const* src, u16 count);
+
+/**
+ * @brief index of old field with same name, type and size or -1
+ */
+static int layout_find_field(const DtComponentLayout* old, const DtComponentData* data, u16 field);
+
+/**
+ * @brief true if old field is string owned by row, it's freed unless it's moved to new row
+ */
+static bool layout_field_owned(const DtComponentLayout* old, u16 field);
+
+/**
+ * @brief move rows of component pool from old layout to layout of new component data
+ */
+static void migrate_rows(DtComponentPool* pool, const DtComponentLayout* old,
+                         const DtComponentData* data);
+
+DtComponentLayout* dt_ecs_manager_capture_layouts(const DtEcsManager* manager, u16* count) {
+    *count = dt_vec_count(manager->pools);
+    DtComponentLayout* layouts = DT_CALLOC(*count ? *count : 1, sizeof(DtComponentLayout));
+    if (!layouts) {
+        printf("[DEBUG] Failed to allocate component layouts\n");
+        exit(1);
+    }
+
+    for (u16 i = 0; i < *count; i++) {
+        const DtEcsPool* pool = manager->pools[i];
+        DtComponentLayout* layout = &layouts[i];
+
+        layout->name = strdup(pool->name);
+        if (pool->type == DT_TAG_POOL)
+            continue;
+
+        const DtComponentData* data = ((const DtComponentPool*) pool->data)->component_data;
+        layout->layout_hash = data->layout_hash;
+        layout->component_size = data->component_size;
+        layout->field_count = data->field_count;
+        layout->field_names = copy_strings(data->field_names, data->field_count);
+        layout->field_types = copy_strings(data->field_types, data->field_count);
+
+        if (data->field_offsets) {
+            layout->field_offsets = DT_MALLOC(data->field_count * sizeof(u16));
+            memcpy(layout->field_offsets, data->field_offsets, data->field_count * sizeof(u16));
+        }
+        if (data->field_sizes) {
+            layout->field_sizes = DT_MALLOC(data->field_count * sizeof(u16));
+            memcpy(layout->field_sizes, data->field_sizes, data->field_count * sizeof(u16));
+        }
+    }
+
+    return layouts;
+}
+
+bool dt_ecs_manager_migrate(DtEcsManager* manager, const DtComponentLayout* layouts,
+                            const u16 count) {
+    if (count != dt_vec_count(manager->pools))
+        return false;
+
+    for (u16 i = 0; i < count; i++) {
+        const DtComponentData* data = dt_component_get_data_by_name(layouts[i].name);
+        if (!data) {
+            fprintf(stderr, "[WARNING] component %s was removed, migration skipped\n",
+                    layouts[i].name);
+            return false;
+        }
+
+        const bool was_tag = manager->pools[i]->type == DT_TAG_POOL;
+        if (was_tag != (data->component_size == 0)) {
+            fprintf(stderr, "[WARNING] component %s changed its kind, migration skipped\n",
+                    layouts[i].name);
+            return false;
+        }
+    }
+
+    for (u16 i = 0; i < count; i++) {
+        DtEcsPool* pool = manager->pools[i];
+        const DtComponentData* data = dt_component_get_data_by_name(layouts[i].name);
+
+        pool->name = data->name;
+        pool->hash = data->hash;
+        if (pool->type == DT_TAG_POOL)
+            continue;
+
+        DtComponentPool* component_pool = pool->data;
+        component_pool->component_data = data;
+        component_pool->entities.auto_reset = data->reset;
+        component_pool->entities.auto_init = data->init;
+        component_pool->entities.auto_copy = data->copy;
+
+        if (layouts[i].layout_hash == data->layout_hash &&
+            layouts[i].component_size == data->component_size)
+            continue;
+
+        migrate_rows(component_pool, &layouts[i], data);
+        printf("[DEBUG] pool %s was migrated to new layout\n", data->name);
+    }
+
+    return true;
+}
+
+void dt_component_layouts_free(DtComponentLayout* layouts, const u16 count) {
+    if (!layouts)
+        return;
+
+    for (u16 i = 0; i < count; i++) {
+        DtComponentLayout* layout = &layouts[i];
+        for (u16 f = 0; f < layout->field_count; f++) {
+            if (layout->field_names)
+                DT_FREE(layout->field_names[f]);
+            if (layout->field_types)
+                DT_FREE(layout->field_types[f]);
+        }
+
+        DT_FREE(layout->name);
+        DT_FREE(layout->field_names);
+        DT_FREE(layout->field_types);
+        DT_FREE(layout->field_offsets);
+        DT_FREE(layout->field_sizes);
+    }
+
+    DT_FREE(layouts);
+}
+
+static char** copy_strings(char* const* src, const u16 count) {
+    if (!src)
+        return NULL;
+
+    char** dst = DT_MALLOC(count * sizeof(char*));
+    for (u16 i = 0; i < count; i++)
+        dst[i] = strdup(src[i]);
+
+    return dst;
+}
+
+static int layout_find_field(const DtComponentLayout* old, const DtComponentData* data,
+                             const u16 field) {
+    if (!old->field_names || !old->field_types || !old->field_offsets || !old->field_sizes ||
+        !data->field_sizes)
+        return -1;
+
+    for (u16 f = 0; f < old->field_count; f++) {
+        if (strcmp(old->field_names[f], data->field_names[field]) != 0)
+            continue;
+        if (strcmp(old->field_types[f], data->field_types[field]) != 0 ||
+            old->field_sizes[f] != data->field_sizes[field])
+            return -1;
+        if (old->field_offsets[f] + old->field_sizes[f] > old->component_size)
+            return -1;
+
+        return f;
+    }
+
+    return -1;
+}
+
+static bool layout_field_owned(const DtComponentLayout* old, const u16 field) {
+    if (!old->field_types || !old->field_offsets)
+        return false;
+
+    return strcmp(old->field_types[field], "char*") == 0 &&
+           old->field_offsets[field] + sizeof(char*) <= old->component_size;
+}
+
+static void migrate_rows(DtComponentPool* pool, const DtComponentLayout* old,
+                         const DtComponentData* data) {
+    DtEntityContainer* container = &pool->entities;
+
+    int* sources = DT_STACK_ALLOC((data->field_count + 1) * sizeof(int));
+    for (u16 f = 0; f < data->field_count; f++)
+        sources[f] = layout_find_field(old, data, f);
+
+    // reset of old layout is gone with its library, dropped strings are freed here
+    bool* dropped = DT_STACK_ALLOC(old->field_count + 1);
+    for (u16 f = 0; f < old->field_count; f++)
+        dropped[f] = layout_field_owned(old, f);
+    for (u16 f = 0; f < data->field_count; f++) {
+        if (sources[f] >= 0)
+            dropped[sources[f]] = false;
+    }
+
+    u8* items = DT_CALLOC(container->dense_size, data->component_size);
+    if (!items) {
+        printf("[DEBUG] Failed to allocate migrated rows of %s\n", data->name);
+        exit(1);
+    }
+
+    const u8* old_items = container->dense_items;
+    for (DtEntity row = 0; row < container->count; row++) {
+        u8* dst = items + (size_t) row * data->component_size;
+        const u8* src = old_items + (size_t) row * container->item_size;
+
+        if (data->reset)
+            data->reset(dst);
+
+        for (u16 f = 0; f < data->field_count; f++) {
+            if (sources[f] < 0)
+                continue;
+            memcpy(dst + data->field_offsets[f], src + old->field_offsets[sources[f]],
+                   data->field_sizes[f]);
+        }
+
+        for (u16 f = 0; f < old->field_count; f++) {
+            if (!dropped[f])
+                continue;
+
+            char* str;
+            memcpy(&str, src + old->field_offsets[f], sizeof(char*));
+            DT_FREE(str);
+        }
+    }
+
+    DT_FREE(container->dense_items);
+    container->dense_items = items;
+    container->item_size = data->component_size;
+}
@@ -0,0 +1,162 @@
+#define DT_ALLOC_TAG DT_ALLOC_CONTAINERS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "DtEcs.h"
+
+#define OBSERVER_ENTITIES_SIZE 16
+
+/**
+ * @brief mark entity as queued, false if it's queued in this frame already
+ */
+static bool observer_mark(DtEcsObserver* observer, DtEntity entity);
+
+/**
+ * @brief drop entities which lost component or don't match filter at end of frame
+ */
+static void observer_compact(DtEcsObserver* observer);
+
+static void observer_free(DtEcsObserver* observer);
+
+DtEcsObserver* dt_ecs_manager_observe(DtEcsManager* manager, const DtObserveKind kind,
+                                      DtEcsPool* pool, DtEcsFilter* filter) {
+    if (!pool)
+        return NULL;
+
+    DtEcsObserver* observer = DT_MALLOC(sizeof(DtEcsObserver));
+    if (!observer) {
+        printf("[DEBUG]\t Failed to allocate memory for observer\n");
+        exit(1);
+    }
+
+    *observer = (DtEcsObserver) {
+        .kind = kind,
+        .pool = pool,
+        .filter = filter,
+        .entities =
+            {
+                DT_VEC_NEW(DtEntity, OBSERVER_ENTITIES_SIZE),
+                DT_VEC_NEW(DtEntity, OBSERVER_ENTITIES_SIZE),
+            },
+        .collect = 0,
+    };
+
+    if (!pool->observers)
+        pool->observers = DT_VEC_NEW(DtEcsObserver*, 2);
+    DT_VEC_ADD(pool->observers, observer);
+    DT_VEC_ADD(manager->observers, observer);
+
+    return observer;
+}
+
+const DtEntity* dt_ecs_observer_entities(const DtEcsObserver* observer, u16* count) {
+    DT_VEC(DtEntity) entities = observer->entities[observer->collect ^ 1];
+
+    *count = dt_vec_count(entities);
+    return entities;
+}
+
+void dt_ecs_pool_notify(const DtEcsPool* pool, DtEntity entity, const DtObserveKind kind) {
+    if (!pool->observers)
+        return;
+
+    for (size_t i = 0; i < dt_vec_count(pool->observers); i++) {
+        DtEcsObserver* observer = pool->observers[i];
+        if (observer->kind != kind)
+            continue;
+
+        // removed entity leaves filter right after notify
+        if (kind == DT_OBSERVE_REMOVE && observer->filter &&
+            !dt_entity_container_has(&observer->filter->entities, entity))
+            continue;
+
+        if (observer_mark(observer, entity))
+            DT_VEC_ADD(observer->entities[observer->collect], entity);
+    }
+}
+
+void dt_ecs_manager_swap_observers(const DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->observers); i++) {
+        DtEcsObserver* observer = manager->observers[i];
+
+        DT_VEC(DtEntity) collected = observer->entities[observer->collect];
+        for (size_t j = 0; j < dt_vec_count(collected); j++)
+            observer->queued[collected[j]] = 0;
+
+        observer->collect ^= 1;
+        dt_vec_header(observer->entities[observer->collect])->count = 0;
+
+        if (observer->kind != DT_OBSERVE_REMOVE)
+            observer_compact(observer);
+    }
+}
+
+void dt_ecs_manager_clear_observers(const DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->observers); i++) {
+        DtEcsObserver* observer = manager->observers[i];
+
+        if (observer->queued)
+            memset(observer->queued, 0, observer->queued_size);
+        dt_vec_header(observer->entities[0])->count = 0;
+        dt_vec_header(observer->entities[1])->count = 0;
+    }
+}
+
+void dt_ecs_manager_free_observers(DtEcsManager* manager) {
+    for (size_t i = 0; i < dt_vec_count(manager->observers); i++)
+        observer_free(manager->observers[i]);
+
+    dt_vec_free(manager->observers);
+    manager->observers = NULL;
+}
+
+static bool observer_mark(DtEcsObserver* observer, const DtEntity entity) {
+    if (entity >= observer->queued_size) {
+        u32 size = observer->queued_size ? observer->queued_size : 64;
+        while (size <= entity)
+            size *= 2;
+
+        u8* queued = DT_REALLOC(observer->queued, size);
+        if (!queued) {
+            printf("[DEBUG]\t Failed to allocate memory for observer\n");
+            exit(1);
+        }
+
+        memset(queued + observer->queued_size, 0, size - observer->queued_size);
+        observer->queued = queued;
+        observer->queued_size = size;
+    }
+
+    if (observer->queued[entity])
+        return false;
+
+    observer->queued[entity] = 1;
+    return true;
+}
+
+static void observer_compact(DtEcsObserver* observer) {
+    DT_VEC(DtEntity) entities = observer->entities[observer->collect ^ 1];
+
+    size_t kept = 0;
+    for (size_t i = 0; i < dt_vec_count(entities); i++) {
+        const DtEntity entity = entities[i];
+        if (!dt_ecs_pool_has(observer->pool, entity))
+            continue;
+        if (observer->filter && !dt_entity_container_has(&observer->filter->entities, entity))
+            continue;
+
+        entities[kept++] = entity;
+    }
+
+    dt_vec_header(entities)->count = kept;
+}
+
+static void observer_free(DtEcsObserver* observer) {
+    dt_vec_free(observer->entities[0]);
+    dt_vec_free(observer->entities[1]);
+    DT_FREE(observer->queued);
+    DT_FREE(observer);
+}
@@ -0,0 +1,219 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DtAllocators.h"
+#include "DtEcs.h"
+#include "RegisterHandler.h"
+
+/**
+ * @brief build prefab from list of manager entities, local index is position in list
+ */
+static DtPrefab* prefab_freeze(const DtEcsManager* manager, const DtEntity* entities, u16 count);
+
+/**
+ * @brief collect root and all its children in breadth-first order
+ */
+static u16 prefab_collect_subtree(const DtEcsManager* manager, DtEntity root, DtEntity** out);
+
+DtPrefab* dt_prefab_new(const DtEcsManager* manager, const DtEntity root) {
+    if (root >= manager->entities_ptr || !manager->sparse_entities[root].alive)
+        return NULL;
+
+    DtEntity* entities;
+    const u16 count = prefab_collect_subtree(manager, root, &entities);
+
+    DtPrefab* prefab = prefab_freeze(manager, entities, count);
+    DT_FREE(entities);
+
+    return prefab;
+}
+
+DtPrefab* dt_prefab_from_manager(const DtEcsManager* manager) {
+    DtEntity* entities = DT_MALLOC((manager->entities_ptr + 1) * sizeof(DtEntity));
+    u16 count = 0;
+
+    for (DtEntity e = 0; e < manager->entities_ptr; e++) {
+        if (manager->sparse_entities[e].alive)
+            entities[count++] = e;
+    }
+
+    DtPrefab* prefab = prefab_freeze(manager, entities, count);
+    DT_FREE(entities);
+
+    return prefab;
+}
+
+void dt_prefab_instantiate(DtEcsManager* manager, const DtPrefab* prefab, const u16 n,
+                           DtEntity* entities) {
+    if (prefab == NULL || n == 0 || prefab->entity_count == 0)
+        return;
+
+    const u32 total = (u32) n * prefab->entity_count;
+    if (total > DT_ENTITY_NULL) {
+        printf("[DEBUG] prefab instantiate overflow, %u entities requested\n", total);
+        return;
+    }
+
+    DtEntity* created = entities ? entities : DT_MALLOC(total * sizeof(DtEntity));
+    for (u32 i = 0; i < total; i++)
+        created[i] = dt_ecs_manager_new_entity(manager);
+
+    u16 max_rows = 0;
+    u64 max_bytes = 0;
+    for (u16 c = 0; c < prefab->column_count; c++) {
+        const DtPrefabColumn* column = &prefab->columns[c];
+        if (column->count > max_rows)
+            max_rows = column->count;
+        if (column->count * column->data->component_size > max_bytes)
+            max_bytes = column->count * column->data->component_size;
+    }
+
+    DtEntity* targets = DT_MALLOC((u64) max_rows * n * sizeof(DtEntity));
+    u8* items = max_bytes ? DT_MALLOC(max_bytes * n) : NULL;
+
+    for (u16 c = 0; c < prefab->column_count; c++) {
+        const DtPrefabColumn* column = &prefab->columns[c];
+        const u64 column_bytes = column->count * column->data->component_size;
+        DtEcsPool* pool = dt_ecs_manager_get_pool(manager, column->data->name);
+
+        for (u16 copy = 0; copy < n; copy++) {
+            const DtEntity* base = created + copy * prefab->entity_count;
+            for (u16 r = 0; r < column->count; r++)
+                targets[copy * column->count + r] = base[column->rows[r]];
+
+            if (column_bytes)
+                memcpy(items + copy * column_bytes, column->items, column_bytes);
+        }
+
+        dt_ecs_pool_add_range_deferred(pool, targets, column->count * n,
+                                       column_bytes ? items : NULL);
+    }
+
+    dt_ecs_manager_update_filters(manager, created, total);
+
+    for (u16 copy = 0; copy < n; copy++) {
+        const DtEntity* base = created + copy * prefab->entity_count;
+        for (u16 i = 0; i < prefab->entity_count; i++) {
+            if (prefab->parents[i] != DT_ENTITY_NULL)
+                dt_ecs_manager_set_parent(manager, base[i], base[prefab->parents[i]]);
+        }
+    }
+
+    DT_FREE(items);
+    DT_FREE(targets);
+    if (created != entities)
+        DT_FREE(created);
+
+    printf("[DEBUG]\t prefab was instantiated %d times\n", n);
+}
+
+void dt_prefab_free(DtPrefab* prefab) {
+    if (prefab == NULL)
+        return;
+
+    // only items made by copy own their fields, memcpy'd ones share them with source
+    for (u16 c = 0; c < prefab->column_count; c++) {
+        const DtPrefabColumn* column = &prefab->columns[c];
+        const u64 size = column->data->component_size;
+        if (column->items && column->data->copy && column->data->reset) {
+            for (u16 i = 0; i < column->count; i++)
+                column->data->reset(column->items + i * size);
+        }
+
+        DT_FREE(column->rows);
+        DT_FREE(column->items);
+    }
+
+    DT_FREE(prefab->columns);
+    DT_FREE(prefab->parents);
+    DT_FREE(prefab);
+}
+
+static DtPrefab* prefab_freeze(const DtEcsManager* manager, const DtEntity* entities,
+                               const u16 count) {
+    DtPrefab* prefab = DT_MALLOC(sizeof(DtPrefab));
+    const u16 pools_count = dt_vec_count(manager->pools);
+
+    *prefab = (DtPrefab) {
+        .entity_count = count,
+        .parents = DT_MALLOC((count + 1) * sizeof(DtEntity)),
+        .columns = DT_CALLOC(pools_count + 1, sizeof(DtPrefabColumn)),
+        .column_count = 0,
+    };
+
+    DtEntity* local = DT_MALLOC((manager->entities_ptr + 1) * sizeof(DtEntity));
+    for (DtEntity e = 0; e < manager->entities_ptr; e++)
+        local[e] = DT_ENTITY_NULL;
+    for (u16 i = 0; i < count; i++)
+        local[entities[i]] = i;
+
+    for (u16 i = 0; i < count; i++) {
+        const DtEntity parent = manager->sparse_entities[entities[i]].parent;
+        prefab->parents[i] = parent < manager->entities_ptr ? local[parent] : DT_ENTITY_NULL;
+    }
+
+    for (u16 p = 0; p < pools_count; p++) {
+        const DtEcsPool* pool = manager->pools[p];
+        if (pool == NULL || pool == manager->hierarchy_dirty_pool)
+            continue;
+
+        u16 rows = 0;
+        for (u16 i = 0; i < count; i++)
+            rows += dt_ecs_pool_has(pool, entities[i]) ? 1 : 0;
+        if (rows == 0)
+            continue;
+
+        const DtComponentData* data = dt_component_get_data_by_name(pool->name);
+        const u64 size = data->component_size;
+
+        DtPrefabColumn* column = &prefab->columns[prefab->column_count++];
+        *column = (DtPrefabColumn) {
+            .data = data,
+            .count = 0,
+            .rows = DT_MALLOC(rows * sizeof(u16)),
+            .items = size ? DT_MALLOC(rows * size) : NULL,
+        };
+
+        for (u16 i = 0; i < count; i++) {
+            if (!dt_ecs_pool_has(pool, entities[i]))
+                continue;
+
+            if (size) {
+                u8* dst = column->items + column->count * size;
+                const void* src = dt_ecs_pool_get(pool, entities[i]);
+                if (data->copy)
+                    data->copy(dst, src);
+                else
+                    memcpy(dst, src, size);
+            }
+
+            column->rows[column->count++] = i;
+        }
+    }
+
+    DT_FREE(local);
+
+    return prefab;
+}
+
+static u16 prefab_collect_subtree(const DtEcsManager* manager, const DtEntity root,
+                                  DtEntity** out) {
+    DtEntity* entities = DT_MALLOC((manager->entities_ptr + 1) * sizeof(DtEntity));
+    u16 count = 0;
+
+    entities[count++] = root;
+    for (u16 i = 0; i < count; i++) {
+        u16 children_count = 0;
+        const DtEntity* children =
+            dt_ecs_manager_get_children(manager, entities[i], &children_count);
+
+        for (u16 c = 0; c < children_count; c++)
+            entities[count++] = children[c];
+    }
+
+    *out = entities;
+    return count;
+}
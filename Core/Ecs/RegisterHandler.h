@@ -19,6 +19,37 @@
 #define DT_COPY_ATTR(func)                                                                         \
     (DtAttributeData) { .attribute_name = DT_COPY_ATTR_TAG, .data = func, }
 
+/**
+ * @brief access of update system to component, given on DT_REGISTER_UPDATE,
+ * declared access replaces pools fetched by init
+ *
+ * @note writes cover component data only, adding or removing components and creating
+ * or killing entities change state of whole manager, such system must be registered
+ * with DT_STRUCTURAL_ATTR, undeclared structural change of sequential run makes system
+ * structural from next frame with warning, in parallel schedule it's fatal error
+ */
+#define DT_READS_ATTR_TAG "dt_reads"
+#define DT_READS_ATTR(T)                                                                           \
+    (DtAttributeData) { .attribute_name = DT_READS_ATTR_TAG, .data = #T, }
+
+#define DT_WRITES_ATTR_TAG "dt_writes"
+#define DT_WRITES_ATTR(T)                                                                          \
+    (DtAttributeData) { .attribute_name = DT_WRITES_ATTR_TAG, .data = #T, }
+
+/**
+ * @brief update system never runs together with others
+ */
+#define DT_EXCLUSIVE_ATTR_TAG "dt_exclusive"
+#define DT_EXCLUSIVE_ATTR                                                                          \
+    (DtAttributeData) { .attribute_name = DT_EXCLUSIVE_ATTR_TAG, .data = NULL, }
+
+/**
+ * @brief update system makes structural changes, it never runs together with others
+ */
+#define DT_STRUCTURAL_ATTR_TAG "dt_structural"
+#define DT_STRUCTURAL_ATTR                                                                         \
+    (DtAttributeData) { .attribute_name = DT_STRUCTURAL_ATTR_TAG, .data = NULL, }
+
 #define DT_FIELD_DECL(type, name, component_name, ...) type name;
 #define DT_FIELD_COUNT(type, name, component_name, ...) +1
 #define DT_FIELD_NAME(type, name, component_name, ...) #name,
@@ -57,6 +88,7 @@
             .field_count = 0,                                                                      \
             .field_names = NULL,                                                                   \
             .field_offsets = NULL,                                                                 \
+            .field_sizes = NULL,                                                                   \
             .component_size = 0,                                                                   \
         };                                                                                         \
         dt_register_component(&local_##component_name##_data);                                     \
@@ -73,6 +105,7 @@
     static char* component_name##_field_names[] = {fields(DT_FIELD_NAME, component_name)};         \
     static u16 component_name##_field_offsets[] = {fields(DT_FIELD_OFFSET, component_name)};       \
     static char* component_name##_field_typess[] = {fields(DT_FIELD_TYPE, component_name)};        \
+    static u16 component_name##_field_sizes[] = {fields(DT_FIELD_SIZE, component_name)};           \
                                                                                                    \
     fields(DT_FIELD_ATTRIBUTES_GENERATE, component_name);                                          \
                                                                                                    \
@@ -100,6 +133,7 @@
             .filed_attributes = component_name##_field_attrs,                                      \
             .filed_attributes_count = component_name##_field_attrs_count,                          \
             .field_types = component_name##_field_typess,                                          \
+            .field_sizes = component_name##_field_sizes,                                           \
             .component_size = sizeof(component_name),                                              \
         };                                                                                         \
         dt_register_component(&local_##component_name##_data);                                     \
@@ -140,6 +174,24 @@ const DtComponentData* dt_component_get_data_by_name(const char* name);
 DT_EXPORT
 i32 dt_component_get_field_index(const DtComponentData* data, const char* name);
 
+/**
+ * @brief get precompiled field plans of component, one per field
+ *
+ * @note plans are compiled on registration and by dt_component_invalidate_plans, reading
+ * them never compiles, plans of module components are compiled by their module
+ */
+DT_EXPORT
+DtFieldPlan* dt_component_get_plans(const DtComponentData* data);
+
+/**
+ * @brief recompile field plans of all registered components, must be called when type
+ * handler is added
+ *
+ * @note worlds mustn't run then
+ */
+DT_EXPORT
+void dt_component_invalidate_plans(void);
+
 // TODO: comments
 DT_EXPORT
 const DtComponentData** dt_component_get_all(u16* size);
@@ -156,8 +208,7 @@ typedef struct {
 #define DT_REGISTER_UPDATE(system_name, new_func, ...)                                             \
     static DtUpdateData local_##system_name##_data;                                                \
     static DtAttributeData system_name##_attrs[] = {__VA_ARGS__};                                  \
-    static u16 system_name##_attrs_count =                                                         \
-        (sizeof((DtAttributeData[]) {__VA_ARGS__}) / sizeof(DtAttributeData));                     \
+    static u16 system_name##_attrs_count = sizeof(system_name##_attrs) / sizeof(DtAttributeData);  \
                                                                                                    \
     static __attribute__((constructor(DT_ORDER_REGISTER_COUNT))) void system_name##_add_count() {  \
         dt_update_increment_count();                                                               \
@@ -200,8 +251,7 @@ typedef struct {
 #define DT_REGISTER_DRAW(system_name, new_func, ...)                                               \
     static DtDrawData local_##system_name##_data;                                                  \
     static DtAttributeData system_name##_attrs[] = {__VA_ARGS__};                                  \
-    static u16 system_name##_attrs_count =                                                         \
-        (sizeof((DtAttributeData[]) {__VA_ARGS__}) / sizeof(DtAttributeData));                     \
+    static u16 system_name##_attrs_count = sizeof(system_name##_attrs) / sizeof(DtAttributeData);  \
     static __attribute__((constructor(DT_ORDER_REGISTER_COUNT))) void system_name##_add_count() {  \
         dt_draw_increment_count();                                                                 \
     }                                                                                              \
@@ -230,4 +280,58 @@ const DtDrawData** dt_draw_get_all(u16* size);
 // TODO: comments
 void dt_draw_increment_count();
 
+/**
+ * @brief data of event type, events are plain structs copied into channels of worlds
+ */
+typedef struct {
+    char* name;
+    u16 id;
+    u64 hash;
+    u32 size;
+} DtEventData;
+
+/**
+ * @brief register struct event_name as event, systems get its channel with
+ * DT_ECS_MANAGER_GET_EVENTS
+ */
+#define DT_REGISTER_EVENT(event_name)                                                              \
+    static DtEventData local_##event_name##_data;                                                  \
+    static __attribute__((constructor(DT_ORDER_REGISTER_COUNT))) void event_name##_add_count() {   \
+        dt_event_increment_count();                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static __attribute__((constructor(DT_ORDER_REGISTER))) void                                    \
+    event_name##_register_event(void) {                                                            \
+        local_##event_name##_data = (DtEventData) {                                                \
+            .name = #event_name,                                                                   \
+            .size = sizeof(event_name),                                                            \
+        };                                                                                         \
+        dt_event_register(&local_##event_name##_data);                                             \
+    }                                                                                              \
+    DtEventData event_name##_data() { return local_##event_name##_data; }
+
+void dt_event_register(DtEventData* data);
+DT_EXPORT
+const DtEventData* dt_event_get_data_by_name(const char* name);
+const DtEventData* dt_event_get_data_by_id(u16 id);
+DT_EXPORT
+const DtEventData** dt_event_get_all(u16* size);
+void dt_event_increment_count();
+
+/**
+ * @brief make component, update, draw and type parser registries read only, after it
+ * lookups by id and name are safe from any thread and worlds may simulate in parallel
+ *
+ * @note field plans of all components are compiled here, registration into frozen
+ * registries is refused, dt_module_load unfreezes them while module is initialized
+ */
+DT_EXPORT
+void dt_registries_freeze(void);
+
+DT_EXPORT
+void dt_registries_unfreeze(void);
+
+DT_EXPORT
+bool dt_registries_frozen(void);
+
 #endif /*COMPONENTS_HANDLER_H*/
@@ -0,0 +1,431 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DtAllocators.h"
+#include "DtEcs.h"
+
+#define DT_SNAPSHOT_MAGIC 0x44745370
+
+/**
+ * @brief every section starts aligned, so restore reads it in place
+ */
+#define SNAPSHOT_ALIGN _Alignof(max_align_t)
+#define SNAPSHOT_PADDED(size) (((size) + SNAPSHOT_ALIGN - 1) & ~(u64) (SNAPSHOT_ALIGN - 1))
+
+typedef struct {
+    u32 magic;
+    DtEntity entities_ptr;
+    DtEntity recycled_ptr;
+    u16 pools_count;
+    u16 filters_count;
+} SnapshotHeader;
+
+/**
+ * @brief sequential writer, with NULL data only size is counted
+ */
+typedef struct {
+    u8* data;
+    u64 offset;
+} SnapshotWriter;
+
+typedef struct {
+    const u8* data;
+    u64 size;
+    u64 offset;
+} SnapshotReader;
+
+static void snapshot_write_manager(SnapshotWriter* writer, const DtEcsManager* manager);
+static void snapshot_put(SnapshotWriter* writer, const void* src, u64 size);
+static void snapshot_put_container(SnapshotWriter* writer, const DtEntityContainer* container);
+
+static const void* snapshot_take(SnapshotReader* reader, u64 size);
+static bool snapshot_take_container(SnapshotReader* reader, DtEntityContainer* container);
+static bool snapshot_skip_container(SnapshotReader* reader);
+static bool snapshot_take_entity(SnapshotReader* reader, DtEntityInfo* info);
+static bool snapshot_take_pool(SnapshotReader* reader, DtEcsPool* pool);
+static void snapshot_clear_container(DtEntityContainer* container);
+static void snapshot_clear_pool(DtEcsPool* pool);
+
+void dt_ecs_manager_snapshot(const DtEcsManager* manager, DtEcsSnapshot* snapshot) {
+    SnapshotWriter writer = {
+        .data = NULL,
+        .offset = 0,
+    };
+    snapshot_write_manager(&writer, manager);
+
+    if (snapshot->manager != manager || writer.offset > snapshot->capacity) {
+        void* tmp = DT_REALLOC(snapshot->data, writer.offset);
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot realloc exception\n");
+            exit(1);
+        }
+
+        snapshot->data = tmp;
+        snapshot->capacity = writer.offset;
+    }
+
+    snapshot->manager = manager;
+    snapshot->size = writer.offset;
+
+    writer = (SnapshotWriter) {
+        .data = snapshot->data,
+        .offset = 0,
+    };
+    snapshot_write_manager(&writer, manager);
+
+    printf("[DEBUG]\t snapshot of %d entities was taken, %lu bytes\n", manager->entities_ptr,
+           (unsigned long) snapshot->size);
+}
+
+bool dt_ecs_manager_restore(DtEcsManager* manager, const DtEcsSnapshot* snapshot) {
+    if (snapshot->manager != manager || snapshot->data == NULL)
+        return false;
+
+    SnapshotReader reader = {
+        .data = snapshot->data,
+        .size = snapshot->size,
+        .offset = 0,
+    };
+
+    const SnapshotHeader* header = snapshot_take(&reader, sizeof(SnapshotHeader));
+    if (!header || header->magic != DT_SNAPSHOT_MAGIC ||
+        header->pools_count > dt_vec_count(manager->pools) ||
+        header->entities_ptr > manager->sparse_size)
+        return false;
+
+    const DtEntity* recycled = snapshot_take(&reader, header->recycled_ptr * sizeof(DtEntity));
+    if (!recycled)
+        return false;
+
+    if (manager->recycled_size < header->recycled_ptr) {
+        void* tmp = DT_REALLOC(manager->recycled_entities, header->recycled_ptr * sizeof(DtEntity));
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot restore realloc exception\n");
+            exit(1);
+        }
+
+        manager->recycled_entities = tmp;
+        manager->recycled_size = header->recycled_ptr;
+    }
+
+    memcpy(manager->recycled_entities, recycled, header->recycled_ptr * sizeof(DtEntity));
+    manager->recycled_ptr = header->recycled_ptr;
+
+    for (DtEntity e = 0; e < header->entities_ptr; e++) {
+        DtEntityInfo* info = &manager->sparse_entities[e];
+
+        if (e >= manager->entities_ptr) {
+            *info = dt_entity_info_new(manager, e, manager->component_count,
+                                       manager->children_size);
+            info->children_iterator.enumerable = info;
+        }
+
+        if (!snapshot_take_entity(&reader, info))
+            return false;
+    }
+
+    for (DtEntity e = header->entities_ptr; e < manager->entities_ptr; e++) {
+        DT_FREE(manager->sparse_entities[e].components);
+        DT_FREE(manager->sparse_entities[e].children);
+        manager->sparse_entities[e].components = NULL;
+        manager->sparse_entities[e].children = NULL;
+    }
+    manager->entities_ptr = header->entities_ptr;
+
+    for (u16 p = 0; p < dt_vec_count(manager->pools); p++) {
+        if (p >= header->pools_count)
+            snapshot_clear_pool(manager->pools[p]);
+        else if (!snapshot_take_pool(&reader, manager->pools[p]))
+            return false;
+    }
+
+    bool refill = false;
+    for (size_t i = 0; i < manager->filters_size; i++) {
+        DtEcsFilter* filter = manager->filters[i];
+        if (filter == NULL)
+            continue;
+
+        SnapshotReader filters = reader;
+        bool restored = false;
+
+        for (u16 f = 0; f < header->filters_count && !restored; f++) {
+            const u64* hash = snapshot_take(&filters, sizeof(u64));
+            if (!hash)
+                return false;
+
+            if (*hash == filter->mask.hash) {
+                if (!snapshot_take_container(&filters, &filter->entities))
+                    return false;
+                restored = true;
+            } else if (!snapshot_skip_container(&filters)) {
+                return false;
+            }
+        }
+
+        if (!restored) {
+            snapshot_clear_container(&filter->entities);
+            refill = true;
+        }
+    }
+
+    if (refill) {
+        DtEntity* alive = DT_MALLOC((manager->entities_ptr + 1) * sizeof(DtEntity));
+        u16 count = 0;
+
+        for (DtEntity e = 0; e < manager->entities_ptr; e++) {
+            if (manager->sparse_entities[e].alive)
+                alive[count++] = e;
+        }
+
+        dt_ecs_manager_update_filters(manager, alive, count);
+        DT_FREE(alive);
+    }
+
+    dt_ecs_manager_clear_events(manager);
+    dt_ecs_manager_clear_observers(manager);
+
+    printf("[DEBUG]\t snapshot of %d entities was restored\n", manager->entities_ptr);
+
+    return true;
+}
+
+void dt_ecs_snapshot_free(DtEcsSnapshot* snapshot) {
+    DT_FREE(snapshot->data);
+    *snapshot = (DtEcsSnapshot) {0};
+}
+
+static void snapshot_write_manager(SnapshotWriter* writer, const DtEcsManager* manager) {
+    SnapshotHeader header = {
+        .magic = DT_SNAPSHOT_MAGIC,
+        .entities_ptr = manager->entities_ptr,
+        .recycled_ptr = manager->recycled_ptr,
+        .pools_count = dt_vec_count(manager->pools),
+        .filters_count = 0,
+    };
+
+    for (size_t i = 0; i < manager->filters_size; i++)
+        header.filters_count += manager->filters[i] != NULL;
+
+    snapshot_put(writer, &header, sizeof(SnapshotHeader));
+    snapshot_put(writer, manager->recycled_entities, manager->recycled_ptr * sizeof(DtEntity));
+
+    for (DtEntity e = 0; e < manager->entities_ptr; e++) {
+        const DtEntityInfo* info = &manager->sparse_entities[e];
+
+        snapshot_put(writer, info, sizeof(DtEntityInfo));
+        snapshot_put(writer, info->components, info->component_count * sizeof(u16));
+        snapshot_put(writer, info->children, info->children_count * sizeof(DtEntity));
+    }
+
+    for (u16 p = 0; p < header.pools_count; p++) {
+        const DtEcsPool* pool = manager->pools[p];
+
+        snapshot_put(writer, &pool->count, sizeof(pool->count));
+
+        if (pool->type == DT_COMPONENT_POOL) {
+            snapshot_put_container(writer, &((const DtComponentPool*) pool->data)->entities);
+        } else {
+            const DtTagPool* tag_pool = pool->data;
+            const u64 size = tag_pool->size;
+
+            snapshot_put(writer, &size, sizeof(u64));
+            snapshot_put(writer, tag_pool->buckets, size * sizeof(TagBucket));
+        }
+    }
+
+    for (size_t i = 0; i < manager->filters_size; i++) {
+        const DtEcsFilter* filter = manager->filters[i];
+        if (filter == NULL)
+            continue;
+
+        snapshot_put(writer, &filter->mask.hash, sizeof(u64));
+        snapshot_put_container(writer, &filter->entities);
+    }
+}
+
+static void snapshot_put(SnapshotWriter* writer, const void* src, const u64 size) {
+    if (writer->data && size) {
+        memcpy(writer->data + writer->offset, src, size);
+        memset(writer->data + writer->offset + size, 0, SNAPSHOT_PADDED(size) - size);
+    }
+
+    writer->offset += SNAPSHOT_PADDED(size);
+}
+
+static void snapshot_put_container(SnapshotWriter* writer, const DtEntityContainer* container) {
+    snapshot_put(writer, &container->count, sizeof(DtEntity));
+    snapshot_put(writer, &container->sparse_size, sizeof(DtEntity));
+    snapshot_put(writer, &container->item_size, sizeof(u32));
+    snapshot_put(writer, container->entities, container->count * sizeof(DtEntity));
+    snapshot_put(writer, container->dense_items, (u64) container->count * container->item_size);
+    snapshot_put(writer, container->sparse_entities, container->sparse_size * sizeof(DtEntity));
+}
+
+static const void* snapshot_take(SnapshotReader* reader, const u64 size) {
+    if (reader->offset + SNAPSHOT_PADDED(size) > reader->size)
+        return NULL;
+
+    const void* ptr = reader->data + reader->offset;
+    reader->offset += SNAPSHOT_PADDED(size);
+
+    return ptr;
+}
+
+static bool snapshot_take_container(SnapshotReader* reader, DtEntityContainer* container) {
+    const DtEntity* count = snapshot_take(reader, sizeof(DtEntity));
+    const DtEntity* sparse_size = count ? snapshot_take(reader, sizeof(DtEntity)) : NULL;
+    const u32* item_size = sparse_size ? snapshot_take(reader, sizeof(u32)) : NULL;
+    if (!item_size || *item_size != container->item_size)
+        return false;
+
+    const DtEntity* entities = snapshot_take(reader, *count * sizeof(DtEntity));
+    const u8* items = snapshot_take(reader, (u64) *count * container->item_size);
+    const DtEntity* sparse = snapshot_take(reader, *sparse_size * sizeof(DtEntity));
+    if (!entities || !items || !sparse)
+        return false;
+
+    if (container->dense_size < *count) {
+        void* tmp = DT_REALLOC(container->dense_items, (u64) *count * container->item_size);
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot restore realloc exception\n");
+            exit(1);
+        }
+
+        container->dense_items = tmp;
+
+        tmp = DT_REALLOC(container->entities, *count * sizeof(DtEntity));
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot restore realloc exception\n");
+            exit(1);
+        }
+
+        container->entities = tmp;
+        container->dense_size = *count;
+    }
+
+    memcpy(container->entities, entities, *count * sizeof(DtEntity));
+    memcpy(container->dense_items, items, (u64) *count * container->item_size);
+    container->count = *count;
+
+    const DtEntity copied =
+        *sparse_size < container->sparse_size ? *sparse_size : container->sparse_size;
+    memcpy(container->sparse_entities, sparse, copied * sizeof(DtEntity));
+    for (DtEntity i = copied; i < container->sparse_size; i++)
+        container->sparse_entities[i] = DT_ENTITY_NULL;
+
+    return true;
+}
+
+static bool snapshot_skip_container(SnapshotReader* reader) {
+    const DtEntity* count = snapshot_take(reader, sizeof(DtEntity));
+    const DtEntity* sparse_size = count ? snapshot_take(reader, sizeof(DtEntity)) : NULL;
+    const u32* item_size = sparse_size ? snapshot_take(reader, sizeof(u32)) : NULL;
+    if (!item_size)
+        return false;
+
+    // sections are padded one by one
+    return snapshot_take(reader, *count * sizeof(DtEntity)) &&
+           snapshot_take(reader, (u64) *count * *item_size) &&
+           snapshot_take(reader, *sparse_size * sizeof(DtEntity));
+}
+
+static bool snapshot_take_entity(SnapshotReader* reader, DtEntityInfo* info) {
+    const DtEntityInfo* saved = snapshot_take(reader, sizeof(DtEntityInfo));
+    if (!saved)
+        return false;
+
+    const u16* components = snapshot_take(reader, saved->component_count * sizeof(u16));
+    const DtEntity* children = snapshot_take(reader, saved->children_count * sizeof(DtEntity));
+    if (!components || !children)
+        return false;
+
+    if (info->component_size < saved->component_count) {
+        void* tmp = DT_REALLOC(info->components, saved->component_count * sizeof(u16));
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot restore realloc exception\n");
+            exit(1);
+        }
+
+        info->components = tmp;
+        info->component_size = saved->component_count;
+    }
+
+    if (saved->children_count > 0 &&
+        (info->children == NULL || info->children_size < saved->children_count)) {
+        if (info->children_size < saved->children_count)
+            info->children_size = saved->children_count;
+
+        void* tmp = DT_REALLOC(info->children, info->children_size * sizeof(DtEntity));
+
+        if (!tmp) {
+            printf("[DEBUG] snapshot restore realloc exception\n");
+            exit(1);
+        }
+
+        info->children = tmp;
+    }
+
+    memcpy(info->components, components, saved->component_count * sizeof(u16));
+    if (saved->children_count > 0)
+        memcpy(info->children, children, saved->children_count * sizeof(DtEntity));
+
+    info->id = saved->id;
+    info->component_count = saved->component_count;
+    info->parent = saved->parent;
+    info->children_count = saved->children_count;
+    info->children_iterator_ptr = 0;
+    info->alive = saved->alive;
+    info->gen = saved->gen;
+
+    return true;
+}
+
+static bool snapshot_take_pool(SnapshotReader* reader, DtEcsPool* pool) {
+    const u16* count = snapshot_take(reader, sizeof(pool->count));
+    if (!count)
+        return false;
+
+    pool->count = *count;
+
+    if (pool->type == DT_COMPONENT_POOL)
+        return snapshot_take_container(reader, &((DtComponentPool*) pool->data)->entities);
+
+    DtTagPool* tag_pool = pool->data;
+    const u64* size = snapshot_take(reader, sizeof(u64));
+    const TagBucket* buckets = size ? snapshot_take(reader, *size * sizeof(TagBucket)) : NULL;
+    if (!buckets)
+        return false;
+
+    const u64 copied = *size < tag_pool->size ? *size : tag_pool->size;
+    memcpy(tag_pool->buckets, buckets, copied * sizeof(TagBucket));
+    memset(tag_pool->buckets + copied, 0, (tag_pool->size - copied) * sizeof(TagBucket));
+
+    return true;
+}
+
+static void snapshot_clear_container(DtEntityContainer* container) {
+    container->count = 0;
+    for (DtEntity i = 0; i < container->sparse_size; i++)
+        container->sparse_entities[i] = DT_ENTITY_NULL;
+}
+
+static void snapshot_clear_pool(DtEcsPool* pool) {
+    pool->count = 0;
+
+    if (pool->type == DT_COMPONENT_POOL) {
+        snapshot_clear_container(&((DtComponentPool*) pool->data)->entities);
+        return;
+    }
+
+    DtTagPool* tag_pool = pool->data;
+    memset(tag_pool->buckets, 0, tag_pool->size * sizeof(TagBucket));
+}
@@ -0,0 +1,278 @@
+#define DT_ALLOC_TAG DT_ALLOC_SYSTEMS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "DtEcs.h"
+#include "Jobs/DtJobs.h"
+#include "RegisterHandler.h"
+
+typedef struct {
+    DtSystemSchedule* schedule;
+    u16 system;
+} ScheduleJob;
+
+/**
+ * @brief edges are kept as compressed rows, dependents of system i are
+ * dependents[offsets[i]..offsets[i + 1]), every system runs as job of DtJobs
+ */
+struct DtSystemSchedule {
+    u16 count;
+    u16* dependencies;
+    u32* offsets;
+    u16* dependents;
+
+    atomic_ushort* remaining;
+    ScheduleJob* jobs;
+    DtJobCounter frame;
+
+    DtSystemRun run;
+    void* data;
+};
+
+_Thread_local DtSystemAccess* dt_current_system_access = NULL;
+_Thread_local DtSystemAccess* dt_running_system_access = NULL;
+_Thread_local bool dt_running_system_concurrent = false;
+
+/**
+ * @brief add id to set if it's not there yet
+ */
+static void access_set_add(DT_VEC(u16) * set, u16 id);
+static bool access_sets_intersect(DT_VEC(u16) first, DT_VEC(u16) second);
+
+static void schedule_release_graph(DtSystemSchedule* schedule);
+
+/**
+ * @brief run system and submit dependents which don't wait for anything else
+ */
+static void schedule_job(void* data);
+
+void dt_system_access_read(DtSystemAccess* access, const u16 ecs_manager_id) {
+    access_set_add(&access->reads, ecs_manager_id);
+}
+
+void dt_system_access_write(DtSystemAccess* access, const u16 ecs_manager_id) {
+    access_set_add(&access->writes, ecs_manager_id);
+}
+
+void dt_system_access_found_structural(DtSystemAccess* access) {
+    if (access->exclusive)
+        return;
+
+    // change would race with systems of same batch, nothing is mutated yet
+    if (dt_running_system_concurrent) {
+        fprintf(stderr, "[ERROR] system made structural change without DT_STRUCTURAL_ATTR "
+                        "while other systems run, register it with DT_STRUCTURAL_ATTR\n");
+        exit(1);
+    }
+
+    fprintf(stderr, "[WARNING] system made structural change without DT_STRUCTURAL_ATTR, "
+                    "it won't run together with others\n");
+    access->structural = true;
+    access->structural_found = true;
+}
+
+bool dt_system_access_conflicts(const DtSystemAccess* first, const DtSystemAccess* second) {
+    // structural changes touch entity infos, filters and recycle list shared by all pools
+    if (first->exclusive || second->exclusive || first->structural || second->structural)
+        return true;
+
+    return access_sets_intersect(first->writes, second->writes) ||
+           access_sets_intersect(first->writes, second->reads) ||
+           access_sets_intersect(first->reads, second->writes);
+}
+
+bool dt_system_access_declare(DtSystemAccess* access, DtEcsManager* manager,
+                              const DtAttributeData* attributes, const u16 attribute_count) {
+    bool declared = false;
+
+    for (u16 i = 0; i < attribute_count; i++) {
+        const DtAttributeData* attribute = &attributes[i];
+        const bool reads = strcmp(attribute->attribute_name, DT_READS_ATTR_TAG) == 0;
+        const bool writes = strcmp(attribute->attribute_name, DT_WRITES_ATTR_TAG) == 0;
+
+        if (strcmp(attribute->attribute_name, DT_EXCLUSIVE_ATTR_TAG) == 0) {
+            access->exclusive = true;
+            declared = true;
+            continue;
+        }
+        if (strcmp(attribute->attribute_name, DT_STRUCTURAL_ATTR_TAG) == 0) {
+            access->structural = true;
+            declared = true;
+            continue;
+        }
+        if (!reads && !writes)
+            continue;
+
+        declared = true;
+        const DtEcsPool* pool = dt_ecs_manager_get_pool(manager, attribute->data);
+        if (!pool) {
+            fprintf(stderr, "[WARNING] access to unknown component %s, system becomes exclusive\n",
+                    (char*) attribute->data);
+            access->exclusive = true;
+        } else if (reads) {
+            dt_system_access_read(access, pool->ecs_manager_id);
+        } else {
+            dt_system_access_write(access, pool->ecs_manager_id);
+        }
+    }
+
+    return declared;
+}
+
+void dt_system_access_clear(DtSystemAccess* access) {
+    if (access->reads)
+        dt_vec_free(access->reads);
+    if (access->writes)
+        dt_vec_free(access->writes);
+
+    *access = (DtSystemAccess) {0};
+}
+
+DtSystemSchedule* dt_system_schedule_new(void) {
+    DtSystemSchedule* schedule = DT_CALLOC(1, sizeof(DtSystemSchedule));
+    if (!schedule) {
+        printf("[DEBUG]\t Failed to allocate memory for system schedule\n");
+        exit(1);
+    }
+
+    return schedule;
+}
+
+void dt_system_schedule_build(DtSystemSchedule* schedule, const DtSystemAccess* access,
+                              const u16 count) {
+    schedule_release_graph(schedule);
+
+    schedule->count = count;
+    schedule->dependencies = DT_CALLOC(count + 1, sizeof(u16));
+    schedule->offsets = DT_CALLOC(count + 1, sizeof(u32));
+    schedule->remaining = DT_CALLOC(count + 1, sizeof(atomic_ushort));
+    schedule->jobs = DT_CALLOC(count + 1, sizeof(ScheduleJob));
+
+    for (u16 i = 0; i < count; i++)
+        schedule->jobs[i] = (ScheduleJob) {.schedule = schedule, .system = i};
+
+    // earlier system in priority order always goes first when they conflict
+    u32 edges = 0;
+    for (u16 before = 0; before < count; before++) {
+        schedule->offsets[before] = edges;
+        for (u16 after = before + 1; after < count; after++) {
+            if (dt_system_access_conflicts(&access[before], &access[after]))
+                edges++;
+        }
+    }
+    schedule->offsets[count] = edges;
+
+    schedule->dependents = DT_CALLOC(edges + 1, sizeof(u16));
+    u32 edge = 0;
+    for (u16 before = 0; before < count; before++) {
+        for (u16 after = before + 1; after < count; after++) {
+            if (!dt_system_access_conflicts(&access[before], &access[after]))
+                continue;
+
+            schedule->dependents[edge++] = after;
+            schedule->dependencies[after]++;
+        }
+    }
+}
+
+u16 dt_system_schedule_count(const DtSystemSchedule* schedule) { return schedule->count; }
+
+bool dt_system_schedule_depends(const DtSystemSchedule* schedule, const u16 before,
+                                const u16 after) {
+    if (before >= schedule->count || after >= schedule->count)
+        return false;
+
+    for (u32 edge = schedule->offsets[before]; edge < schedule->offsets[before + 1]; edge++) {
+        if (schedule->dependents[edge] == after)
+            return true;
+    }
+
+    return false;
+}
+
+void dt_system_schedule_run(DtSystemSchedule* schedule, const DtSystemRun run, void* data) {
+    schedule->run = run;
+    schedule->data = data;
+
+    for (u16 i = 0; i < schedule->count; i++)
+        atomic_store_explicit(&schedule->remaining[i], schedule->dependencies[i],
+                              memory_order_relaxed);
+
+    for (u16 i = 0; i < schedule->count; i++) {
+        if (schedule->dependencies[i] == 0)
+            dt_job_submit(schedule_job, &schedule->jobs[i], &schedule->frame);
+    }
+
+    dt_job_wait(&schedule->frame);
+
+    schedule->run = NULL;
+    schedule->data = NULL;
+}
+
+void dt_system_schedule_free(DtSystemSchedule* schedule) {
+    schedule_release_graph(schedule);
+    DT_FREE(schedule);
+}
+
+static void access_set_add(DT_VEC(u16) * set, u16 id) {
+    if (!*set)
+        *set = DT_VEC_NEW(u16, 4);
+
+    const size_t count = dt_vec_count(*set);
+    for (size_t i = 0; i < count; i++) {
+        if ((*set)[i] == id)
+            return;
+    }
+
+    DT_VEC_ADD(*set, id);
+}
+
+static bool access_sets_intersect(DT_VEC(u16) first, DT_VEC(u16) second) {
+    if (!first || !second)
+        return false;
+
+    const size_t first_count = dt_vec_count(first);
+    const size_t second_count = dt_vec_count(second);
+    for (size_t i = 0; i < first_count; i++) {
+        for (size_t j = 0; j < second_count; j++) {
+            if (first[i] == second[j])
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static void schedule_release_graph(DtSystemSchedule* schedule) {
+    DT_FREE(schedule->dependencies);
+    DT_FREE(schedule->offsets);
+    DT_FREE(schedule->dependents);
+    DT_FREE(schedule->remaining);
+    DT_FREE(schedule->jobs);
+
+    schedule->dependencies = NULL;
+    schedule->offsets = NULL;
+    schedule->dependents = NULL;
+    schedule->remaining = NULL;
+    schedule->jobs = NULL;
+    schedule->count = 0;
+}
+
+static void schedule_job(void* data) {
+    const ScheduleJob* job = data;
+    DtSystemSchedule* schedule = job->schedule;
+
+    schedule->run(schedule->data, job->system);
+
+    // frame counter isn't released before this job returns, so dependents are counted in time
+    for (u32 edge = schedule->offsets[job->system]; edge < schedule->offsets[job->system + 1];
+         edge++) {
+        const u16 dependent = schedule->dependents[edge];
+        if (atomic_fetch_sub_explicit(&schedule->remaining[dependent], 1, memory_order_acq_rel) ==
+            1)
+            dt_job_submit(schedule_job, &schedule->jobs[dependent], &schedule->frame);
+    }
+}
@@ -1,15 +1,118 @@
+#define DT_ALLOC_TAG DT_ALLOC_SYSTEMS
+
 #include <stdlib.h>
+#include <string.h>
 
 #include "DtAllocators.h"
 #include "DtEcs.h"
+#include "DtTime.h"
+#include "Jobs/DtJobs.h"
+#include "Profiling/DtAllocTracker.h"
+#include "Profiling/DtTrace.h"
+#include "RegisterHandler.h"
 
-static int cmp_updaters(const void* s1, const void* s2) {
-    return ((UpdateSystem*) s1)->priority - ((UpdateSystem*) s2)->priority;
-}
+#ifdef DT_PROFILE_SYSTEMS
+_Thread_local DtSystemStats* dt_current_system_stats = NULL;
 
-static int cmp_drawers(const void* s1, const void* s2) {
-    return ((DrawSystem*) s1)->priority - ((DrawSystem*) s2)->priority;
-}
+// handler may run inside system of other handler, so outer stats are restored
+#define SYSTEM_STATS_BEGIN(stats)                                                                  \
+    DtSystemStats* const outer_stats = dt_current_system_stats;                                    \
+    dt_current_system_stats = (stats);                                                             \
+    const u64 stats_start = dt_time_now_ns();
+
+#define SYSTEM_STATS_END(stats)                                                                    \
+    system_stats_add_sample((stats), dt_time_now_ns() - stats_start);                             \
+    dt_current_system_stats = outer_stats;
+
+#define SYSTEM_STATS_SKIP(stats) (stats)->skipped++;
+
+static void system_stats_add_sample(DtSystemStats* stats, u64 duration);
+static const DtSystemStats* system_stats_find(char** names, const DtSystemStats* stats,
+                                              const char* name);
+#else
+#define SYSTEM_STATS_BEGIN(stats)
+#define SYSTEM_STATS_END(stats)
+#define SYSTEM_STATS_SKIP(stats)
+#endif /*DT_PROFILE_SYSTEMS*/
+
+#ifdef DT_TRACK_ALLOCATIONS
+#define ALLOC_GUARD_ENTER(name)                                                                    \
+    const char* const outer_guard = dt_alloc_guard_enter((name) ? (name) : "unnamed")
+#define ALLOC_GUARD_LEAVE() dt_alloc_guard_leave(outer_guard)
+#else
+#define ALLOC_GUARD_ENTER(name)
+#define ALLOC_GUARD_LEAVE()
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+_Thread_local float dt_current_draw_alpha = 0.0f;
+
+/**
+ * @brief stable sort of systems by priority, names (and stats) are moved with systems
+ */
+static void sort_updaters(const UpdateHandler* handler);
+static void sort_drawers(const DrawHandler* handler);
+static void render_snapshot_free(DtRenderSnapshot* snapshot);
+
+/**
+ * @brief replace access collected from init by one declared on registration
+ */
+static void update_access_from_attributes(const UpdateHandler* handler, size_t system);
+static void update_system_run(const UpdateHandler* handler, size_t system, DtUpdateContext* ctx);
+
+/**
+ * @brief count frame and time of system, true if it has to run now, elapsed is time
+ * since its previous run then
+ */
+static bool run_condition_pass(const DtRunCondition* condition, DtRunState* state, float delta,
+                               float* elapsed);
+static bool run_condition_watched(const DtRunCondition* condition);
+static bool run_condition_timed(const DtRunCondition* condition);
+
+/**
+ * @brief check run_if of draw system, its rate is measured by clock
+ */
+static bool draw_run_pass(const DrawHandler* handler, size_t system);
+
+/**
+ * @brief draw systems with extract if extracted is set and ones without it if live is set
+ */
+static void draw_systems_run(const DrawHandler* handler, bool extracted, bool live);
+
+/**
+ * @brief call slices of systems in turns until all are done or budget is spent, next
+ * frame starts from system which didn't get its turn
+ */
+static void update_slices_run(const UpdateHandler* handler, DtUpdateContext* ctx);
+static DtSliceResult update_slice_run(const UpdateHandler* handler, size_t system,
+                                      DtSliceContext* ctx);
+static void update_slices_free(DtUpdateSlices* slices);
+
+/**
+ * @brief take steps from accumulator, write alpha into context and run fixed_update of
+ * systems once per step, all steps of frame go one after another
+ */
+static void update_fixed_run(const UpdateHandler* handler, DtUpdateContext* ctx);
+static void update_fixed_system_run(const UpdateHandler* handler, size_t system,
+                                    DtUpdateContext* ctx);
+static void update_fixed_schedule_run(void* data, u16 system);
+
+typedef struct {
+    const UpdateHandler* handler;
+    DtUpdateContext* ctx;
+} UpdateScheduleRun;
+
+static void update_schedule_run(void* data, u16 system);
+
+/**
+ * @brief rebuild schedule if system was found structural during frame
+ */
+static void update_schedule_refresh(const UpdateHandler* handler);
+
+/**
+ * @brief system of parallel schedule may run together with others, exclusive and
+ * structural ones always run alone
+ */
+static bool update_system_concurrent(const DtSystemAccess* access);
 
 UpdateHandler* dt_update_handler_new(DtEcsManager* manager, u16 updater_count) {
     UpdateHandler* system_handler = DT_MALLOC(sizeof(UpdateHandler));
@@ -17,7 +120,28 @@ UpdateHandler* dt_update_handler_new(DtEcsManager* manager, u16 updater_count) {
     *system_handler = (UpdateHandler) {
         .manager = manager,
         .systems = DT_VEC_NEW(UpdateSystem*, updater_count),
-        .names = DT_VEC_NEW(char*, updater_count)
+        .names = DT_VEC_NEW(char*, updater_count),
+#ifdef DT_PROFILE_SYSTEMS
+        .stats = DT_VEC_NEW(DtSystemStats, updater_count),
+#endif /*DT_PROFILE_SYSTEMS*/
+        .access = DT_VEC_NEW(DtSystemAccess, updater_count),
+        .runs = DT_VEC_NEW(DtRunState, updater_count),
+        .schedule = dt_system_schedule_new(),
+        .slices = DT_MALLOC(sizeof(DtUpdateSlices)),
+        .fixed = DT_MALLOC(sizeof(DtUpdateFixed)),
+    };
+
+    if (!system_handler->slices || !system_handler->fixed) {
+        printf("[DEBUG]\t Failed to allocate memory for update handler\n");
+        exit(1);
+    }
+
+    *system_handler->slices = (DtUpdateSlices) {
+        .states = DT_VEC_NEW(DtSliceState, updater_count),
+        .budget_ns = DT_UPDATE_SLICE_BUDGET_NS,
+    };
+    *system_handler->fixed = (DtUpdateFixed) {
+        .max_steps = DT_UPDATE_FIXED_MAX_STEPS,
     };
 
     return system_handler;
@@ -26,24 +150,90 @@ UpdateHandler* dt_update_handler_new(DtEcsManager* manager, u16 updater_count) {
 void dt_update_handler_add(UpdateHandler* handler, UpdateSystem* system, char* name) {
     DT_VEC_ADD(handler->systems, system);
     DT_VEC_ADD(handler->names, name);
+#ifdef DT_PROFILE_SYSTEMS
+    DT_VEC_ADD(handler->stats, (DtSystemStats) {0});
+#endif /*DT_PROFILE_SYSTEMS*/
+    DT_VEC_ADD(handler->access, (DtSystemAccess) {0});
+    DT_VEC_ADD(handler->runs, (DtRunState) {0});
 }
 
 void dt_update_handler_init(const UpdateHandler* handler) {
-    qsort(handler->systems, dt_vec_count(handler->systems), sizeof(UpdateSystem*), cmp_updaters);
+    sort_updaters(handler);
 
-    FOREACH(UpdateSystem*, system, DT_VEC_ITERATOR(handler->systems), {
+    const size_t count = dt_vec_count(handler->systems);
+    for (size_t i = 0; i < count; i++) {
+        UpdateSystem* system = handler->systems[i];
+        dt_system_access_clear(&handler->access[i]);
+
+        dt_current_system_access = &handler->access[i];
         if (system->init)
             system->init(handler->manager, system->data);
-    });
+        dt_current_system_access = NULL;
+
+        update_access_from_attributes(handler, i);
+    }
+
+    dt_system_schedule_build(handler->schedule, handler->access, count);
+    memset(handler->runs, 0, count * sizeof(DtRunState));
+
+    // cursors follow systems sorted by priority
+    DtUpdateSlices* slices = handler->slices;
+    dt_vec_header(slices->states)->count = 0;
+    slices->sliced_count = 0;
+    slices->next = 0;
+    for (size_t i = 0; i < count; i++) {
+        DT_VEC_ADD(slices->states, ((DtSliceState) {0}));
+        if (handler->systems[i]->slice)
+            slices->sliced_count++;
+    }
+
+    handler->fixed->accumulator = 0.0f;
+    handler->fixed->fixed_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (handler->systems[i]->fixed_update)
+            handler->fixed->fixed_count++;
+    }
 }
 
 void dt_update_handler_update(const UpdateHandler* handler, DtUpdateContext* ctx) {
-    FOREACH(UpdateSystem*, system, DT_VEC_ITERATOR(handler->systems), {
-        if (system->update)
-            system->update(system->data, ctx);
-    });
+    const size_t count = dt_vec_count(handler->systems);
+
+    // events and changes of previous frame are read by systems of this one
+    dt_ecs_manager_swap_events(handler->manager);
+    dt_ecs_manager_swap_observers(handler->manager);
+
+    update_fixed_run(handler, ctx);
+
+    if (handler->parallel && dt_jobs_workers_count() > 0 && count > 1 &&
+        dt_system_schedule_count(handler->schedule) == count) {
+        UpdateScheduleRun run = {
+            .handler = handler,
+            .ctx = ctx,
+        };
+        dt_system_schedule_run(handler->schedule, update_schedule_run, &run);
+    } else {
+        for (size_t i = 0; i < count; i++)
+            update_system_run(handler, i, ctx);
+    }
+
+    update_slices_run(handler, ctx);
+    update_schedule_refresh(handler);
 }
 
+void dt_update_handler_set_parallel(UpdateHandler* handler, const bool parallel) {
+    handler->parallel = parallel;
+}
+
+void dt_update_handler_set_slice_budget(UpdateHandler* handler, const u64 budget_ns) {
+    handler->slices->budget_ns = budget_ns;
+}
+
+void dt_update_handler_set_fixed_max_steps(UpdateHandler* handler, const u16 max_steps) {
+    handler->fixed->max_steps = max_steps;
+}
+
+bool dt_slice_expired(const DtSliceContext* ctx) { return dt_time_now_ns() >= ctx->deadline_ns; }
+
 void dt_update_handler_destroy(const UpdateHandler* handler) {
     FOREACH(UpdateSystem*, system, DT_VEC_ITERATOR(handler->systems), {
         if (system->destroy)
@@ -51,9 +241,60 @@ void dt_update_handler_destroy(const UpdateHandler* handler) {
     });
 }
 
+void dt_update_handler_clear(UpdateHandler* handler) {
+    dt_vec_free(handler->systems);
+    dt_vec_free(handler->names);
+    handler->systems = DT_VEC_NEW(UpdateSystem*, 0);
+    handler->names = DT_VEC_NEW(char*, 0);
+#ifdef DT_PROFILE_SYSTEMS
+    dt_vec_free(handler->stats);
+    handler->stats = DT_VEC_NEW(DtSystemStats, 0);
+#endif /*DT_PROFILE_SYSTEMS*/
+
+    const size_t count = dt_vec_count(handler->access);
+    for (size_t i = 0; i < count; i++)
+        dt_system_access_clear(&handler->access[i]);
+    dt_vec_free(handler->access);
+    handler->access = DT_VEC_NEW(DtSystemAccess, 0);
+    dt_system_schedule_build(handler->schedule, handler->access, 0);
+    dt_vec_free(handler->runs);
+    handler->runs = DT_VEC_NEW(DtRunState, 0);
+
+    dt_vec_header(handler->slices->states)->count = 0;
+    handler->slices->sliced_count = 0;
+    handler->fixed->fixed_count = 0;
+}
+
 void dt_update_handler_free(UpdateHandler* handler) {
     dt_vec_free(handler->systems);
-    free(handler);
+    dt_vec_free(handler->names);
+#ifdef DT_PROFILE_SYSTEMS
+    dt_vec_free(handler->stats);
+#endif /*DT_PROFILE_SYSTEMS*/
+
+    const size_t count = dt_vec_count(handler->access);
+    for (size_t i = 0; i < count; i++)
+        dt_system_access_clear(&handler->access[i]);
+    dt_vec_free(handler->access);
+    dt_vec_free(handler->runs);
+    dt_system_schedule_free(handler->schedule);
+    update_slices_free(handler->slices);
+    DT_FREE(handler->fixed);
+    DT_FREE(handler);
+}
+
+const DtSystemStats* dt_update_handler_get_stats(const UpdateHandler* handler, const char* name) {
+#ifdef DT_PROFILE_SYSTEMS
+    return system_stats_find(handler->names, handler->stats, name);
+#else
+    return NULL;
+#endif /*DT_PROFILE_SYSTEMS*/
+}
+
+void dt_update_handler_reset_stats(const UpdateHandler* handler) {
+#ifdef DT_PROFILE_SYSTEMS
+    memset(handler->stats, 0, dt_vec_count(handler->stats) * sizeof(DtSystemStats));
+#endif /*DT_PROFILE_SYSTEMS*/
 }
 
 DrawHandler* dt_draw_handler_new(DtEcsManager* manager, u16 drawers_count) {
@@ -62,7 +303,21 @@ DrawHandler* dt_draw_handler_new(DtEcsManager* manager, u16 drawers_count) {
     *handler = (DrawHandler) {
         .manager = manager,
         .systems = DT_VEC_NEW(DrawSystem*, drawers_count),
-        .names = DT_VEC_NEW(char*, drawers_count)
+        .names = DT_VEC_NEW(char*, drawers_count),
+#ifdef DT_PROFILE_SYSTEMS
+        .stats = DT_VEC_NEW(DtSystemStats, drawers_count),
+#endif /*DT_PROFILE_SYSTEMS*/
+        .runs = DT_VEC_NEW(DtRunState, drawers_count),
+        .snapshot = DT_MALLOC(sizeof(DtRenderSnapshot)),
+    };
+
+    if (!handler->snapshot) {
+        printf("[DEBUG]\t Failed to allocate memory for render snapshot\n");
+        exit(1);
+    }
+    *handler->snapshot = (DtRenderSnapshot) {
+        .frames = {DT_VEC_NEW(DtRenderStream, drawers_count),
+                   DT_VEC_NEW(DtRenderStream, drawers_count)},
     };
 
     return handler;
@@ -71,42 +326,553 @@ DrawHandler* dt_draw_handler_new(DtEcsManager* manager, u16 drawers_count) {
 void dt_draw_handler_add(DrawHandler* handler, const DrawSystem* system, char* name) {
     DT_VEC_ADD(handler->systems, system);
     DT_VEC_ADD(handler->names, name);
+    DT_VEC_ADD(handler->snapshot->frames[0], (DtRenderStream) {0});
+    DT_VEC_ADD(handler->snapshot->frames[1], (DtRenderStream) {0});
+#ifdef DT_PROFILE_SYSTEMS
+    DT_VEC_ADD(handler->stats, (DtSystemStats) {0});
+#endif /*DT_PROFILE_SYSTEMS*/
+    DT_VEC_ADD(handler->runs, (DtRunState) {0});
 }
 
 void dt_draw_handler_init(const DrawHandler* handler) {
-    qsort(handler->systems, dt_vec_count(handler->systems), sizeof(DrawSystem*), cmp_drawers);
+    sort_drawers(handler);
+
     FOREACH(DrawSystem*, system, DT_VEC_ITERATOR(handler->systems), {
         if (system->init)
             system->init(handler->manager, system->data);
     });
+    memset(handler->runs, 0, dt_vec_count(handler->runs) * sizeof(DtRunState));
 }
 
 void dt_draw_handler_draw(const DrawHandler* handler) {
+    DtRenderSnapshot* snapshot = handler->snapshot;
+
+    // pools are updated by frame pipeline, systems without extract wait for its end
+    if (snapshot->updating) {
+        draw_systems_run(handler, true, false);
+        snapshot->live_deferred = true;
+        return;
+    }
+
+    draw_systems_run(handler, true, true);
+}
+
+void dt_draw_handler_begin_update(const DrawHandler* handler) {
+    handler->snapshot->updating = true;
+}
+
+void dt_draw_handler_end_update(const DrawHandler* handler) {
+    DtRenderSnapshot* snapshot = handler->snapshot;
+
+    snapshot->updating = false;
+    if (snapshot->live_deferred)
+        draw_systems_run(handler, false, true);
+    snapshot->live_deferred = false;
+}
+
+void dt_draw_handler_extract(const DrawHandler* handler) {
+    DT_TRACE_FUNCTION();
+    const size_t count = dt_vec_count(handler->systems);
+    DtRenderStream* streams = handler->snapshot->frames[!handler->snapshot->drawn];
+
+    for (size_t i = 0; i < count; i++) {
+        DrawSystem* system = handler->systems[i];
+        if (!system->extract)
+            continue;
+
+        streams[i].skipped = !draw_run_pass(handler, i);
+        if (streams[i].skipped)
+            continue;
+
+        ALLOC_GUARD_ENTER(handler->names[i]);
+        system->extract(system->data, &streams[i]);
+        ALLOC_GUARD_LEAVE();
+    }
+}
+
+void dt_draw_handler_swap(const DrawHandler* handler) {
+    handler->snapshot->drawn = !handler->snapshot->drawn;
+}
+
+void dt_draw_handler_set_alpha(const DrawHandler* handler, const float alpha) {
+    handler->snapshot->alpha[!handler->snapshot->drawn] = alpha;
+}
+
+void* dt_render_stream_reserve(DtRenderStream* stream, const u32 item_size, const u32 count) {
+    const size_t size = (size_t) item_size * count;
+    if (size > stream->capacity) {
+        // stream grows twice so changing entity count doesn't reallocate every frame
+        const size_t capacity = size > stream->capacity * 2 ? size : stream->capacity * 2;
+        void* items = DT_REALLOC(stream->items, capacity);
+        if (!items) {
+            printf("[DEBUG]\t Failed to allocate memory for render stream\n");
+            exit(1);
+        }
+
+        stream->items = items;
+        stream->capacity = capacity;
+    }
+
+    stream->item_size = item_size;
+    stream->count = count;
+
+    return stream->items;
+}
+
+void dt_render_stream_free(DtRenderStream* stream) {
+    DT_FREE(stream->items);
+    *stream = (DtRenderStream) {0};
+}
+
+void dt_draw_handler_destroy(const DrawHandler* handler) {
     FOREACH(DrawSystem*, system, DT_VEC_ITERATOR(handler->systems), {
-        if (system->draw)
-            system->draw(system->data);
+        if (system->destroy)
+            system->destroy(system->data);
     });
 }
 
-void dt_draw_handler_destroy(const DrawHandler* handler) {
-    (&dt_vec_header(handler->systems)->iterator)->start(
-        (&dt_vec_header(handler->systems)->iterator)->enumerable);
-    DrawSystem* system;
-    while ((&dt_vec_header(handler->systems)->iterator)->
-        has_current((&dt_vec_header(handler->systems)->iterator)->enumerable)) {
-        system = *(DrawSystem**) (&dt_vec_header(handler->systems)->iterator)->current(
-            (&dt_vec_header(handler->systems)->iterator)->enumerable);
-        {
-            if (system->destroy)
-                system->destroy(system->data);
-        };
-        (&dt_vec_header(handler->systems)->iterator)->next(
-            (&dt_vec_header(handler->systems)->iterator)->enumerable);
-        }
+void dt_draw_handler_clear(DrawHandler* handler) {
+    dt_vec_free(handler->systems);
+    dt_vec_free(handler->names);
+    handler->systems = DT_VEC_NEW(DrawSystem*, 0);
+    handler->names = DT_VEC_NEW(char*, 0);
+    render_snapshot_free(handler->snapshot);
+    *handler->snapshot = (DtRenderSnapshot) {
+        .frames = {DT_VEC_NEW(DtRenderStream, 0), DT_VEC_NEW(DtRenderStream, 0)},
+    };
+#ifdef DT_PROFILE_SYSTEMS
+    dt_vec_free(handler->stats);
+    handler->stats = DT_VEC_NEW(DtSystemStats, 0);
+#endif /*DT_PROFILE_SYSTEMS*/
+    dt_vec_free(handler->runs);
+    handler->runs = DT_VEC_NEW(DtRunState, 0);
 }
 
 void dt_draw_handler_free(DrawHandler* handler) {
     dt_vec_free(handler->systems);
     dt_vec_free(handler->names);
-    free(handler);
+    render_snapshot_free(handler->snapshot);
+    DT_FREE(handler->snapshot);
+#ifdef DT_PROFILE_SYSTEMS
+    dt_vec_free(handler->stats);
+#endif /*DT_PROFILE_SYSTEMS*/
+    dt_vec_free(handler->runs);
+    DT_FREE(handler);
+}
+
+const DtSystemStats* dt_draw_handler_get_stats(const DrawHandler* handler, const char* name) {
+#ifdef DT_PROFILE_SYSTEMS
+    return system_stats_find(handler->names, handler->stats, name);
+#else
+    return NULL;
+#endif /*DT_PROFILE_SYSTEMS*/
+}
+
+void dt_draw_handler_reset_stats(const DrawHandler* handler) {
+#ifdef DT_PROFILE_SYSTEMS
+    memset(handler->stats, 0, dt_vec_count(handler->stats) * sizeof(DtSystemStats));
+#endif /*DT_PROFILE_SYSTEMS*/
+}
+
+u64 dt_system_stats_average_ns(const DtSystemStats* stats) {
+    return stats && stats->calls ? stats->total_ns / stats->calls : 0;
+}
+
+static void sort_updaters(const UpdateHandler* handler) {
+    const size_t count = dt_vec_count(handler->systems);
+
+    for (size_t i = 1; i < count; i++) {
+        UpdateSystem* system = handler->systems[i];
+        char* name = handler->names[i];
+#ifdef DT_PROFILE_SYSTEMS
+        const DtSystemStats stats = handler->stats[i];
+#endif /*DT_PROFILE_SYSTEMS*/
+        const DtSystemAccess access = handler->access[i];
+
+        size_t j = i;
+        for (; j > 0 && handler->systems[j - 1]->priority > system->priority; j--) {
+            handler->systems[j] = handler->systems[j - 1];
+            handler->names[j] = handler->names[j - 1];
+#ifdef DT_PROFILE_SYSTEMS
+            handler->stats[j] = handler->stats[j - 1];
+#endif /*DT_PROFILE_SYSTEMS*/
+            handler->access[j] = handler->access[j - 1];
+        }
+
+        handler->systems[j] = system;
+        handler->names[j] = name;
+#ifdef DT_PROFILE_SYSTEMS
+        handler->stats[j] = stats;
+#endif /*DT_PROFILE_SYSTEMS*/
+        handler->access[j] = access;
+    }
+}
+
+static void update_access_from_attributes(const UpdateHandler* handler, const size_t system) {
+    const DtUpdateData* data =
+        handler->names[system] ? dt_update_get_data_by_name(handler->names[system]) : NULL;
+    DtSystemAccess* access = &handler->access[system];
+
+    DtSystemAccess declared = {0};
+    if (data && dt_system_access_declare(&declared, handler->manager, data->attributes,
+                                         data->attribute_count)) {
+        dt_system_access_clear(access);
+        *access = declared;
+    } else if (!access->reads && !access->writes) {
+        // nothing is known about system, it may touch anything
+        access->exclusive = true;
+    }
+}
+
+static void update_system_run(const UpdateHandler* handler, const size_t system,
+                              DtUpdateContext* ctx) {
+    UpdateSystem* update_system = handler->systems[system];
+    if (!update_system->update)
+        return;
+
+    float elapsed;
+    if (!run_condition_pass(&update_system->run_if, &handler->runs[system], ctx->delta_time,
+                            &elapsed)) {
+        SYSTEM_STATS_SKIP(&handler->stats[system]);
+        return;
+    }
+
+    // context is shared by systems running at the same time, timed one gets own copy
+    DtUpdateContext timed_ctx;
+    if (run_condition_timed(&update_system->run_if)) {
+        timed_ctx = *ctx;
+        timed_ctx.delta_time = elapsed;
+        ctx = &timed_ctx;
+    }
+
+    DT_TRACE_ZONE(handler->names[system]);
+    ALLOC_GUARD_ENTER(handler->names[system]);
+    SYSTEM_STATS_BEGIN(&handler->stats[system]);
+    DtSystemAccess* const outer_access = dt_running_system_access;
+    dt_running_system_access = &handler->access[system];
+    update_system->update(update_system->data, ctx);
+    dt_running_system_access = outer_access;
+    SYSTEM_STATS_END(&handler->stats[system]);
+    ALLOC_GUARD_LEAVE();
+}
+
+static void update_fixed_run(const UpdateHandler* handler, DtUpdateContext* ctx) {
+    DtUpdateFixed* fixed = handler->fixed;
+    ctx->fixed_steps = 0;
+    ctx->alpha = 0.0f;
+    if (ctx->fixed_delta_time <= 0.0f)
+        return;
+
+    fixed->accumulator += ctx->delta_time;
+    while (fixed->accumulator >= ctx->fixed_delta_time && ctx->fixed_steps < fixed->max_steps) {
+        fixed->accumulator -= ctx->fixed_delta_time;
+        ctx->fixed_steps++;
+    }
+
+    // simulation falls behind instead of spending next frames on catch up
+    if (fixed->accumulator >= ctx->fixed_delta_time)
+        fixed->accumulator = 0.0f;
+    ctx->alpha = fixed->accumulator / ctx->fixed_delta_time;
+
+    if (fixed->fixed_count == 0 || ctx->fixed_steps == 0)
+        return;
+
+    DT_TRACE_FUNCTION();
+    const size_t count = dt_vec_count(handler->systems);
+    const bool parallel = handler->parallel && dt_jobs_workers_count() > 0 &&
+                          fixed->fixed_count > 1 &&
+                          dt_system_schedule_count(handler->schedule) == count;
+    UpdateScheduleRun run = {
+        .handler = handler,
+        .ctx = ctx,
+    };
+
+    for (u16 step = 0; step < ctx->fixed_steps; step++) {
+        if (parallel) {
+            dt_system_schedule_run(handler->schedule, update_fixed_schedule_run, &run);
+        } else {
+            for (size_t i = 0; i < count; i++)
+                update_fixed_system_run(handler, i, ctx);
+        }
+    }
+}
+
+static void update_fixed_system_run(const UpdateHandler* handler, const size_t system,
+                                    DtUpdateContext* ctx) {
+    UpdateSystem* update_system = handler->systems[system];
+    if (!update_system->fixed_update)
+        return;
+
+    DT_TRACE_ZONE(handler->names[system]);
+    ALLOC_GUARD_ENTER(handler->names[system]);
+    SYSTEM_STATS_BEGIN(&handler->stats[system]);
+    DtSystemAccess* const outer_access = dt_running_system_access;
+    dt_running_system_access = &handler->access[system];
+    update_system->fixed_update(update_system->data, ctx);
+    dt_running_system_access = outer_access;
+    SYSTEM_STATS_END(&handler->stats[system]);
+    ALLOC_GUARD_LEAVE();
+}
+
+static void update_fixed_schedule_run(void* data, const u16 system) {
+    const UpdateScheduleRun* run = data;
+
+    const bool outer_concurrent = dt_running_system_concurrent;
+    dt_running_system_concurrent |= update_system_concurrent(&run->handler->access[system]);
+    update_fixed_system_run(run->handler, system, run->ctx);
+    dt_running_system_concurrent = outer_concurrent;
+}
+
+static bool run_condition_pass(const DtRunCondition* condition, DtRunState* state,
+                               const float delta, float* elapsed) {
+    state->frames++;
+    state->elapsed += delta;
+
+    if (condition->every_frames > 1 && state->frames < condition->every_frames)
+        return false;
+    if (condition->rate_hz > 0.0f && state->elapsed < 1.0f / condition->rate_hz)
+        return false;
+
+    // due run is spent even when there is nothing to do
+    *elapsed = state->elapsed;
+    state->frames = 0;
+    state->elapsed = 0.0f;
+
+    if (condition->filter && condition->filter->entities.count == 0)
+        return false;
+
+    return run_condition_watched(condition);
+}
+
+static bool run_condition_watched(const DtRunCondition* condition) {
+    bool watching = false;
+    for (u8 i = 0; i < DT_RUN_WATCH_COUNT; i++) {
+        if (!condition->watch[i])
+            continue;
+
+        u16 count;
+        dt_ecs_observer_entities(condition->watch[i], &count);
+        if (count > 0)
+            return true;
+
+        watching = true;
+    }
+
+    return !watching;
+}
+
+static bool run_condition_timed(const DtRunCondition* condition) {
+    return condition->every_frames > 1 || condition->rate_hz > 0.0f;
+}
+
+static void draw_systems_run(const DrawHandler* handler, const bool extracted,
+                             const bool live) {
+    const size_t count = dt_vec_count(handler->systems);
+    const DtRenderSnapshot* snapshot = handler->snapshot;
+    const DtRenderStream* streams = snapshot->frames[snapshot->drawn];
+
+    // draw handler of game is drawn by system of editor handler
+    const float outer_alpha = dt_current_draw_alpha;
+
+    for (size_t i = 0; i < count; i++) {
+        DrawSystem* system = handler->systems[i];
+        const bool from_stream = system->extract && system->draw_extracted;
+        if (!from_stream && !system->draw)
+            continue;
+        if (from_stream ? !extracted : !live)
+            continue;
+
+        // systems with extract are checked once per frame by extract
+        if (system->extract ? streams[i].skipped : !draw_run_pass(handler, i)) {
+            SYSTEM_STATS_SKIP(&handler->stats[i]);
+            continue;
+        }
+
+        // live pools are already at state of update which is extracted next
+        dt_current_draw_alpha =
+            from_stream ? snapshot->alpha[snapshot->drawn] : snapshot->alpha[!snapshot->drawn];
+
+        DT_TRACE_ZONE(handler->names[i]);
+        ALLOC_GUARD_ENTER(handler->names[i]);
+        SYSTEM_STATS_BEGIN(&handler->stats[i]);
+        if (from_stream)
+            system->draw_extracted(system->data, &streams[i]);
+        else
+            system->draw(system->data);
+        SYSTEM_STATS_END(&handler->stats[i]);
+        ALLOC_GUARD_LEAVE();
+    }
+
+    dt_current_draw_alpha = outer_alpha;
+}
+
+static bool draw_run_pass(const DrawHandler* handler, const size_t system) {
+    const DtRunCondition* condition = &handler->systems[system]->run_if;
+    DtRunState* state = &handler->runs[system];
+
+    // clock is read only when it's needed
+    float delta = 0.0f;
+    if (condition->rate_hz > 0.0f) {
+        const u64 now = dt_time_now_ns();
+        delta = state->last_ns ? (float) (now - state->last_ns) / 1e9f : 0.0f;
+        state->last_ns = now;
+    }
+
+    float elapsed;
+    return run_condition_pass(condition, state, delta, &elapsed);
+}
+
+static void update_slices_run(const UpdateHandler* handler, DtUpdateContext* ctx) {
+    DtUpdateSlices* slices = handler->slices;
+    if (slices->sliced_count == 0)
+        return;
+
+    const size_t count = dt_vec_count(slices->states);
+    slices->frame++;
+
+    DtSliceContext slice_ctx = {
+        .update = ctx,
+        .deadline_ns = dt_time_now_ns() + slices->budget_ns,
+    };
+
+    bool pending = true;
+    bool called = false;
+    while (pending) {
+        pending = false;
+
+        for (size_t turn = 0; turn < count; turn++) {
+            const size_t i = (slices->next + turn) % count;
+            DtSliceState* state = &slices->states[i];
+            if (!handler->systems[i]->slice || state->done_frame == slices->frame)
+                continue;
+
+            if (called && dt_slice_expired(&slice_ctx)) {
+                slices->next = i;
+                return;
+            }
+
+            slice_ctx.cursor = state->cursor;
+            const DtSliceResult result = update_slice_run(handler, i, &slice_ctx);
+            state->cursor = slice_ctx.cursor;
+            called = true;
+
+            if (result == DT_SLICE_DONE)
+                state->done_frame = slices->frame;
+            else
+                pending = true;
+        }
+    }
+
+    slices->next = (slices->next + 1) % count;
+}
+
+static DtSliceResult update_slice_run(const UpdateHandler* handler, const size_t system,
+                                      DtSliceContext* ctx) {
+    UpdateSystem* update_system = handler->systems[system];
+
+    DT_TRACE_ZONE(handler->names[system]);
+    ALLOC_GUARD_ENTER(handler->names[system]);
+    SYSTEM_STATS_BEGIN(&handler->stats[system]);
+    const DtSliceResult result = update_system->slice(update_system->data, ctx);
+    SYSTEM_STATS_END(&handler->stats[system]);
+    ALLOC_GUARD_LEAVE();
+
+    return result;
+}
+
+static void update_slices_free(DtUpdateSlices* slices) {
+    dt_vec_free(slices->states);
+    DT_FREE(slices);
+}
+
+static void update_schedule_run(void* data, const u16 system) {
+    const UpdateScheduleRun* run = data;
+
+    const bool outer_concurrent = dt_running_system_concurrent;
+    dt_running_system_concurrent |= update_system_concurrent(&run->handler->access[system]);
+    update_system_run(run->handler, system, run->ctx);
+    dt_running_system_concurrent = outer_concurrent;
+}
+
+static bool update_system_concurrent(const DtSystemAccess* access) {
+    return !access->exclusive && !access->structural;
+}
+
+static void update_schedule_refresh(const UpdateHandler* handler) {
+    const size_t count = dt_vec_count(handler->access);
+
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+        found |= handler->access[i].structural_found;
+        handler->access[i].structural_found = false;
+    }
+
+    if (found)
+        dt_system_schedule_build(handler->schedule, handler->access, count);
+}
+
+static void sort_drawers(const DrawHandler* handler) {
+    const size_t count = dt_vec_count(handler->systems);
+    DtRenderStream* first = handler->snapshot->frames[0];
+    DtRenderStream* second = handler->snapshot->frames[1];
+
+    for (size_t i = 1; i < count; i++) {
+        DrawSystem* system = handler->systems[i];
+        char* name = handler->names[i];
+        const DtRenderStream first_stream = first[i];
+        const DtRenderStream second_stream = second[i];
+#ifdef DT_PROFILE_SYSTEMS
+        const DtSystemStats stats = handler->stats[i];
+#endif /*DT_PROFILE_SYSTEMS*/
+
+        size_t j = i;
+        for (; j > 0 && handler->systems[j - 1]->priority > system->priority; j--) {
+            handler->systems[j] = handler->systems[j - 1];
+            handler->names[j] = handler->names[j - 1];
+            first[j] = first[j - 1];
+            second[j] = second[j - 1];
+#ifdef DT_PROFILE_SYSTEMS
+            handler->stats[j] = handler->stats[j - 1];
+#endif /*DT_PROFILE_SYSTEMS*/
+        }
+
+        handler->systems[j] = system;
+        handler->names[j] = name;
+        first[j] = first_stream;
+        second[j] = second_stream;
+#ifdef DT_PROFILE_SYSTEMS
+        handler->stats[j] = stats;
+#endif /*DT_PROFILE_SYSTEMS*/
+    }
+}
+
+static void render_snapshot_free(DtRenderSnapshot* snapshot) {
+    for (int frame = 0; frame < 2; frame++) {
+        const size_t count = dt_vec_count(snapshot->frames[frame]);
+        for (size_t i = 0; i < count; i++)
+            dt_render_stream_free(&snapshot->frames[frame][i]);
+        dt_vec_free(snapshot->frames[frame]);
+    }
+}
+
+#ifdef DT_PROFILE_SYSTEMS
+static void system_stats_add_sample(DtSystemStats* stats, const u64 duration) {
+    stats->last_ns = duration;
+    stats->total_ns += duration;
+    if (duration > stats->max_ns)
+        stats->max_ns = duration;
+    stats->calls++;
+}
+
+static const DtSystemStats* system_stats_find(char** names, const DtSystemStats* stats,
+                                              const char* name) {
+    const size_t count = dt_vec_count(names);
+
+    for (size_t i = 0; i < count; i++) {
+        if (names[i] && strcmp(names[i], name) == 0)
+            return &stats[i];
+    }
+
+    return NULL;
 }
+#endif /*DT_PROFILE_SYSTEMS*/
@@ -1,14 +1,18 @@
+#define DT_ALLOC_TAG DT_ALLOC_POOLS
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "DtAllocators.h"
 #include "DtEcs.h"
+#include "Profiling/DtTrace.h"
 #include "RegisterHandler.h"
 
 static bool has = true;
 
 static void tag_pool_add(void*, DtEntity, const void*);
+static void tag_pool_add_range(void*, const DtEntity*, u16, const void*);
 static void* tag_pool_get(const void*, DtEntity);
 static bool tag_pool_has(const void* pool, DtEntity entity);
 static void tag_pool_reset(void* pool, DtEntity entity);
@@ -21,6 +25,11 @@ static bool tag_pool_has_current(void*);
 static void tag_pool_next(void*);
 static void tag_pool_free(void*);
 
+/**
+ * @brief grow buckets up to entity, ids of loaded ranges may be over size of manager
+ */
+static bool tag_pool_reserve(DtTagPool* tag_pool, DtEntity entity);
+
 //TODO: split decl def
 static int get_hash(const char* name) {
     int hash = 2147483647;
@@ -50,6 +59,7 @@ DtEcsPool* dt_tag_pool_new(const DtEcsManager* manager, const char* name) {
                 .type = DT_TAG_POOL,
 
                 .add = tag_pool_add,
+                .add_range = tag_pool_add_range,
                 .get = tag_pool_get,
                 .has = tag_pool_has,
                 .reset = tag_pool_reset,
@@ -66,7 +76,7 @@ DtEcsPool* dt_tag_pool_new(const DtEcsManager* manager, const char* name) {
                         .enumerable = pool,
                     },
             },
-        .buckets = calloc(num_buckets, sizeof(TagBucket)),
+        .buckets = DT_CALLOC(num_buckets, sizeof(TagBucket)),
         .size = num_buckets,
         .max_entities = num_buckets * BUCKET_SIZE,
     };
@@ -76,12 +86,38 @@ DtEcsPool* dt_tag_pool_new(const DtEcsManager* manager, const char* name) {
 
 static void tag_pool_add(void* pool, DtEntity entity, const void* data) {
     DtTagPool* tag_pool = pool;
+    if (!tag_pool_reserve(tag_pool, entity))
+        return;
 
     const size_t bucket_idx = entity / BUCKET_SIZE;
     const size_t bit_offset = entity % BUCKET_SIZE;
 
     tag_pool->buckets[bucket_idx] |= 1 << bit_offset;
-    tag_pool->pool.count++;
+}
+
+static void tag_pool_add_range(void* pool, const DtEntity* entities, const u16 count,
+                               const void* data) {
+    DtTagPool* tag_pool = pool;
+
+    for (u16 i = 0; i < count; i++) {
+        if (tag_pool_has(tag_pool, entities[i]) || !tag_pool_reserve(tag_pool, entities[i]))
+            continue;
+
+        tag_pool->buckets[entities[i] / BUCKET_SIZE] |= 1 << entities[i] % BUCKET_SIZE;
+    }
+}
+
+static bool tag_pool_reserve(DtTagPool* tag_pool, const DtEntity entity) {
+    if (entity < tag_pool->max_entities)
+        return true;
+
+    if (entity == DT_ENTITY_NULL) {
+        fprintf(stderr, "[WARNING] null entity can't be added to %s pool\n", tag_pool->pool.name);
+        return false;
+    }
+
+    tag_pool_resize(tag_pool, entity + 1);
+    return entity < tag_pool->max_entities;
 }
 
 static void* tag_pool_get(const void* data, DtEntity entity) {
@@ -124,12 +160,13 @@ static void tag_pool_remove(void* pool, const DtEntity entity) {
 }
 
 static void tag_pool_resize(void* pool, const u16 new_max_entities) {
+    DT_TRACE_FUNCTION();
     DtTagPool* tag_pool = pool;
 
     const size_t new_capacity = (new_max_entities + BUCKET_SIZE - 1) / BUCKET_SIZE;
     const size_t new_size = new_capacity * sizeof(TagBucket);
 
-    TagBucket* new_buckets = realloc(tag_pool->buckets, new_size);
+    TagBucket* new_buckets = DT_REALLOC(tag_pool->buckets, new_size);
     if (!new_buckets) {
         printf("[DEBUG] Failed to resize tag pool to %d entities\n", new_max_entities);
         return;
@@ -155,6 +192,7 @@ static void tag_pool_start(void* data) {
 
 static void* tag_pool_current(void* data) {
     DtTagPool* tag_pool = data;
+    DT_SYSTEM_STATS_ADD(entities_visited, 1);
     tag_pool->iterator_entity =
         __builtin_ctz(tag_pool->iterator_bucket) + sizeof(TagBucket) * tag_pool->iterator_ptr;
 
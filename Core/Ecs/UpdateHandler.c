@@ -1,3 +1,5 @@
+#define DT_ALLOC_TAG DT_ALLOC_SYSTEMS
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,6 +12,12 @@ static int id_counter = 0;
 static const DtUpdateData** update_data_by_id = NULL;
 static const DtUpdateData** update_data_by_name = NULL;
 
+/**
+ * @brief search system in loaded modules, list of modules is read only while
+ * worlds simulate
+ */
+static const DtUpdateData* dt_update_get_from_modules(const char* name);
+
 void dt_update_increment_count() { size++; }
 
 static int dt_update_get_hash(const char* name) {
@@ -22,6 +30,12 @@ static int dt_update_get_hash(const char* name) {
 }
 
 void dt_update_register(DtUpdateData* data) {
+    if (dt_registries_frozen()) {
+        fprintf(stderr, "[WARNING] registries are frozen, %s update system isn't registered\n",
+                data->name);
+        return;
+    }
+
     if (!size)
         size = 107ULL;
     if (!update_data_by_id) {
@@ -58,39 +72,40 @@ const DtUpdateData* dt_update_get_data_by_id(const u16 id) {
 }
 
 const DtUpdateData* dt_update_get_data_by_name(const char* name) {
+    if (!update_data_by_name)
+        return NULL;
+
     u64 idx = dt_update_get_hash(name) % size;
     const u64 start = idx;
 
     while (update_data_by_name[idx] != NULL && strcmp(update_data_by_name[idx]->name, name) != 0) {
         idx = (idx + 1) % size;
-        if (idx == start) {
-            DtEnvironment* env = dt_environment_instance();
-            FOREACH(ModuleInfo, info, &env->modules.iterator, {
-                const DtUpdateData* data = info.environment->get_update(name);
-                if (data)
-                    return data;
-            });
-
-            return NULL;
-        }
+        if (idx == start)
+            return dt_update_get_from_modules(name);
     }
 
     if (update_data_by_name[idx] != NULL) {
         return update_data_by_name[idx];
     }
 
-    DtEnvironment* env = dt_environment_instance();
-
-    FOREACH(ModuleInfo*, info, &env->modules.iterator, {
-        const DtUpdateData* data = info->environment->get_update(name);
-        if (data)
-            return data;
-    });
-
-    return NULL;
+    return dt_update_get_from_modules(name);
 }
 
 const DtUpdateData** dt_update_get_all(u16* size_out) {
     *size_out = id_counter;
     return update_data_by_id;
 }
+
+static const DtUpdateData* dt_update_get_from_modules(const char* name) {
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
+        const DtUpdateData* data = env->modules_list[i]->environment->get_update(name);
+        if (data)
+            return data;
+    }
+
+    return NULL;
+}
@@ -2,6 +2,7 @@
 #define EXECUTE_ORDER_H
 
 #define DT_ORDER_REGISTER_COUNT 101
+#define DT_ORDER_INIT_TYPES 101
 #define DT_ORDER_REGISTER 102
 #define DT_ORDER_INIT_ENVIRONMENT 103
 
@@ -0,0 +1,80 @@
+#ifndef DT_JOBS_H
+#define DT_JOBS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "DtNumericalTypes.h"
+
+/*=============================================================================
+ *                            Система задач (DtJobs)
+ *============================================================================*/
+
+/**
+ * @brief every worker owns work-stealing deque, jobs submitted by worker go to its own
+ * deque, by main thread to main deque, by other threads to shared queue, idle workers
+ * steal from others
+ *
+ * @note before dt_jobs_init and after dt_jobs_shutdown jobs run inline in submitting thread
+ */
+typedef void (*DtJobFunc)(void* data);
+
+/**
+ * @brief count of unfinished jobs, it's incremented on submit and decremented when job
+ * returns, zero initialized counter is ready to use
+ */
+typedef struct {
+    atomic_uint pending;
+} DtJobCounter;
+
+/**
+ * @brief start workers, calling thread becomes main one
+ *
+ * @param workers count of worker threads, 0 takes one per core except main
+ */
+void dt_jobs_init(u16 workers);
+
+/**
+ * @brief wait all queued jobs and stop workers
+ */
+void dt_jobs_shutdown(void);
+
+u16 dt_jobs_workers_count(void);
+
+bool dt_jobs_is_main_thread(void);
+
+/**
+ * @brief count of thread indices, workers and main thread, 1 before init
+ */
+u16 dt_jobs_threads_count(void);
+
+/**
+ * @brief index of calling thread below dt_jobs_threads_count(), main thread and threads
+ * outside of pool share the last one, so state kept by it needs owner
+ */
+u16 dt_jobs_thread_index(void);
+
+/**
+ * @brief queue job for any thread
+ *
+ * @param counter optional counter to wait job with
+ *
+ * @note job memory is ring of thread, one thread can't have more than 4096 jobs in flight
+ */
+void dt_job_submit(DtJobFunc func, void* data, DtJobCounter* counter);
+
+/**
+ * @brief queue job which runs only on main thread, for raylib calls
+ */
+void dt_job_submit_main(DtJobFunc func, void* data, DtJobCounter* counter);
+
+/**
+ * @brief run other jobs until counter becomes zero, main thread runs main jobs too
+ */
+void dt_job_wait(DtJobCounter* counter);
+
+/**
+ * @brief run queued main jobs, called by main loop once per frame
+ */
+void dt_jobs_run_main(void);
+
+#endif /*DT_JOBS_H*/
@@ -0,0 +1,489 @@
+#define DT_ALLOC_TAG DT_ALLOC_JOBS
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "Jobs/DtJobs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif /*_WIN32*/
+
+#define JOB_DEQUE_SIZE 4096
+#define JOB_DEQUE_MASK (JOB_DEQUE_SIZE - 1)
+#define JOB_RING_SIZE 4096
+#define JOB_SPIN_COUNT 64
+
+typedef struct {
+    DtJobFunc func;
+    void* data;
+    DtJobCounter* counter;
+
+    /**
+     * @brief slot of ring is taken until job is done, job out of full ring is on heap
+     */
+    atomic_bool pending;
+    bool heap;
+} DtJob;
+
+/**
+ * @brief Chase-Lev deque, owner pushes and pops bottom, thieves take top,
+ * full deque makes owner put job to shared queue
+ */
+typedef struct {
+    atomic_llong top;
+    atomic_llong bottom;
+    _Atomic(DtJob*) buffer[JOB_DEQUE_SIZE];
+} JobDeque;
+
+/**
+ * @brief jobs of one submitting thread are taken from its ring in turn, rings
+ * live until shutdown, slot of job in flight isn't reused
+ */
+typedef struct JobRing {
+    DtJob jobs[JOB_RING_SIZE];
+    u32 next;
+
+    struct JobRing* next_ring;
+} JobRing;
+
+/**
+ * @brief queue protected by lock, jobs are taken from head
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    DT_VEC(DtJob*) jobs;
+    size_t head;
+} JobQueue;
+
+static JobDeque* deques = NULL;
+static pthread_t* threads = NULL;
+static u16 workers_count = 0;
+static u16 deques_count = 0;
+static atomic_bool running = false;
+static pthread_t main_thread;
+
+static JobQueue shared_queue;
+static JobQueue main_queue;
+
+static JobRing* rings = NULL;
+static pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static u32 generation = 0;
+
+static atomic_uint queued = 0;
+static atomic_uint in_flight = 0;
+static atomic_uint sleepers = 0;
+static pthread_mutex_t sleep_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sleep_cond = PTHREAD_COND_INITIALIZER;
+
+static _Thread_local JobDeque* local_deque = NULL;
+static _Thread_local u16 local_index = 0;
+static _Thread_local JobRing* local_ring = NULL;
+static _Thread_local u32 local_generation = 0;
+
+static bool deque_push(JobDeque* deque, DtJob* job);
+static DtJob* deque_pop(JobDeque* deque);
+static DtJob* deque_steal(JobDeque* deque);
+
+static void queue_init(JobQueue* queue);
+static void queue_push(JobQueue* queue, DtJob* job);
+static DtJob* queue_pop(JobQueue* queue);
+static void queue_free(JobQueue* queue);
+
+/**
+ * @brief allocate job ring of calling thread, pool threads do it on start so
+ * steady frames don't allocate
+ */
+static void local_ring_prepare(void);
+static DtJob* job_new(DtJobFunc func, void* data, DtJobCounter* counter);
+static void job_run(DtJob* job);
+
+/**
+ * @brief run job taken from queue or deque, shutdown waits for them
+ */
+static void job_run_queued(DtJob* job);
+static void job_queued(void);
+
+/**
+ * @brief take job from own deque, shared queue or other deques
+ */
+static DtJob* find_job(void);
+static void* worker_main(void* data);
+static u16 cores_count(void);
+
+void dt_jobs_init(u16 workers) {
+    if (atomic_load(&running)) {
+        fprintf(stderr, "[WARNING] jobs are already initialized\n");
+        return;
+    }
+
+    if (workers == 0)
+        workers = cores_count() > 1 ? cores_count() - 1 : 1;
+
+    main_thread = pthread_self();
+    queue_init(&shared_queue);
+    queue_init(&main_queue);
+
+    // last deque belongs to main thread
+    deques = DT_CALLOC(workers + 1, sizeof(JobDeque));
+    threads = DT_MALLOC(sizeof(pthread_t) * workers);
+    if (!deques || !threads) {
+        printf("[DEBUG]\t Failed to allocate memory for jobs\n");
+        exit(1);
+    }
+
+    deques_count = workers + 1;
+    local_deque = &deques[workers];
+    local_index = workers;
+    local_ring_prepare();
+    atomic_store(&running, true);
+
+    for (u16 i = 0; i < workers; i++) {
+        if (pthread_create(&threads[workers_count], NULL, worker_main,
+                           (void*) (uintptr_t) workers_count) != 0) {
+            fprintf(stderr, "[WARNING] only %u of %u job workers started\n", workers_count,
+                    workers);
+            break;
+        }
+        workers_count++;
+    }
+
+    printf("[DEBUG] jobs initialized with %u workers\n", workers_count);
+}
+
+void dt_jobs_shutdown(void) {
+    if (!atomic_load(&running))
+        return;
+
+    // main jobs can't be left behind, workers finish the rest before stop
+    while (atomic_load(&in_flight) > 0) {
+        dt_jobs_run_main();
+        DtJob* job = find_job();
+        if (job)
+            job_run_queued(job);
+        else
+            sched_yield();
+    }
+
+    pthread_mutex_lock(&sleep_lock);
+    atomic_store(&running, false);
+    pthread_cond_broadcast(&sleep_cond);
+    pthread_mutex_unlock(&sleep_lock);
+
+    for (u16 i = 0; i < workers_count; i++)
+        pthread_join(threads[i], NULL);
+
+    DT_FREE(threads);
+    DT_FREE(deques);
+    threads = NULL;
+    deques = NULL;
+    workers_count = 0;
+    deques_count = 0;
+    local_deque = NULL;
+
+    queue_free(&shared_queue);
+    queue_free(&main_queue);
+
+    pthread_mutex_lock(&rings_lock);
+    while (rings) {
+        JobRing* next = rings->next_ring;
+        DT_FREE(rings);
+        rings = next;
+    }
+    generation++;
+    pthread_mutex_unlock(&rings_lock);
+}
+
+u16 dt_jobs_workers_count(void) { return workers_count; }
+
+u16 dt_jobs_threads_count(void) { return deques_count ? deques_count : 1; }
+
+u16 dt_jobs_thread_index(void) {
+    if (!deques_count)
+        return 0;
+
+    return local_deque ? local_index : deques_count - 1;
+}
+
+bool dt_jobs_is_main_thread(void) {
+    return !atomic_load(&running) || pthread_equal(pthread_self(), main_thread);
+}
+
+void dt_job_submit(const DtJobFunc func, void* data, DtJobCounter* counter) {
+    if (counter)
+        atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+
+    if (!atomic_load_explicit(&running, memory_order_acquire)) {
+        job_run(&(DtJob) {.func = func, .data = data, .counter = counter});
+        return;
+    }
+
+    atomic_fetch_add_explicit(&in_flight, 1, memory_order_relaxed);
+    DtJob* job = job_new(func, data, counter);
+    if (!local_deque || !deque_push(local_deque, job))
+        queue_push(&shared_queue, job);
+
+    job_queued();
+}
+
+void dt_job_submit_main(const DtJobFunc func, void* data, DtJobCounter* counter) {
+    if (counter)
+        atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+
+    if (!atomic_load_explicit(&running, memory_order_acquire)) {
+        job_run(&(DtJob) {.func = func, .data = data, .counter = counter});
+        return;
+    }
+
+    atomic_fetch_add_explicit(&in_flight, 1, memory_order_relaxed);
+    queue_push(&main_queue, job_new(func, data, counter));
+}
+
+void dt_job_wait(DtJobCounter* counter) {
+    const bool main = dt_jobs_is_main_thread();
+    u32 idle = 0;
+
+    while (atomic_load_explicit(&counter->pending, memory_order_acquire) > 0) {
+        DtJob* job = main ? queue_pop(&main_queue) : NULL;
+        if (!job)
+            job = find_job();
+
+        if (job) {
+            job_run_queued(job);
+            idle = 0;
+        } else if (++idle > JOB_SPIN_COUNT) {
+            sched_yield();
+        }
+    }
+}
+
+void dt_jobs_run_main(void) {
+    if (!atomic_load(&running) || !dt_jobs_is_main_thread())
+        return;
+
+    DtJob* job;
+    while ((job = queue_pop(&main_queue)))
+        job_run_queued(job);
+}
+
+static bool deque_push(JobDeque* deque, DtJob* job) {
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    const long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= JOB_DEQUE_SIZE)
+        return false;
+
+    atomic_store_explicit(&deque->buffer[bottom & JOB_DEQUE_MASK], job, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+static DtJob* deque_pop(JobDeque* deque) {
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    DtJob* job =
+        atomic_load_explicit(&deque->buffer[bottom & JOB_DEQUE_MASK], memory_order_relaxed);
+    if (top == bottom) {
+        // last job, race with thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed))
+            job = NULL;
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return job;
+}
+
+static DtJob* deque_steal(JobDeque* deque) {
+    long long top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+    if (top >= bottom)
+        return NULL;
+
+    DtJob* job = atomic_load_explicit(&deque->buffer[top & JOB_DEQUE_MASK], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed))
+        return NULL;
+
+    return job;
+}
+
+static void queue_init(JobQueue* queue) {
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->jobs = DT_VEC_NEW(DtJob*, 64);
+    queue->head = 0;
+}
+
+static void queue_push(JobQueue* queue, DtJob* job) {
+    pthread_mutex_lock(&queue->lock);
+    DT_VEC_ADD(queue->jobs, job);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static DtJob* queue_pop(JobQueue* queue) {
+    pthread_mutex_lock(&queue->lock);
+
+    DtJob* job = NULL;
+    if (queue->head < dt_vec_count(queue->jobs)) {
+        job = queue->jobs[queue->head++];
+
+        // queue is drained, storage is reused from start
+        if (queue->head == dt_vec_count(queue->jobs)) {
+            dt_vec_header(queue->jobs)->count = 0;
+            queue->head = 0;
+        }
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+    return job;
+}
+
+static void queue_free(JobQueue* queue) {
+    dt_vec_free(queue->jobs);
+    pthread_mutex_destroy(&queue->lock);
+}
+
+static void local_ring_prepare(void) {
+    // rings of previous init are already freed by shutdown
+    if (local_ring && local_generation == generation)
+        return;
+
+    local_ring = DT_CALLOC(1, sizeof(JobRing));
+    if (!local_ring) {
+        printf("[DEBUG]\t Failed to allocate memory for job ring\n");
+        exit(1);
+    }
+
+    pthread_mutex_lock(&rings_lock);
+    local_generation = generation;
+    local_ring->next_ring = rings;
+    rings = local_ring;
+    pthread_mutex_unlock(&rings_lock);
+}
+
+static DtJob* job_new(const DtJobFunc func, void* data, DtJobCounter* counter) {
+    local_ring_prepare();
+
+    DtJob* job = &local_ring->jobs[local_ring->next % JOB_RING_SIZE];
+
+    // oldest slot is still queued or running, ring is full of jobs in flight
+    if (atomic_load_explicit(&job->pending, memory_order_acquire)) {
+        job = DT_MALLOC(sizeof(DtJob));
+        if (!job) {
+            printf("[DEBUG]\t Failed to allocate memory for job\n");
+            exit(1);
+        }
+        job->heap = true;
+    } else {
+        local_ring->next++;
+        job->heap = false;
+    }
+
+    job->func = func;
+    job->data = data;
+    job->counter = counter;
+    atomic_store_explicit(&job->pending, true, memory_order_relaxed);
+
+    return job;
+}
+
+static void job_run(DtJob* job) {
+    DtJobCounter* counter = job->counter;
+    job->func(job->data);
+
+    // job can't be touched after its slot is released
+    if (job->heap)
+        DT_FREE(job);
+    else
+        atomic_store_explicit(&job->pending, false, memory_order_release);
+
+    if (counter)
+        atomic_fetch_sub_explicit(&counter->pending, 1, memory_order_release);
+}
+
+static void job_run_queued(DtJob* job) {
+    job_run(job);
+    atomic_fetch_sub_explicit(&in_flight, 1, memory_order_acq_rel);
+}
+
+static void job_queued(void) {
+    atomic_fetch_add_explicit(&queued, 1, memory_order_seq_cst);
+
+    if (atomic_load_explicit(&sleepers, memory_order_seq_cst) > 0) {
+        pthread_mutex_lock(&sleep_lock);
+        pthread_cond_signal(&sleep_cond);
+        pthread_mutex_unlock(&sleep_lock);
+    }
+}
+
+static DtJob* find_job(void) {
+    if (!deques)
+        return NULL;
+
+    DtJob* job = local_deque ? deque_pop(local_deque) : NULL;
+    if (!job)
+        job = queue_pop(&shared_queue);
+
+    // victims are walked from own neighbour, so thieves don't crowd one deque
+    for (u16 i = 1; !job && i <= deques_count; i++)
+        job = deque_steal(&deques[(local_index + i) % deques_count]);
+
+    if (job)
+        atomic_fetch_sub_explicit(&queued, 1, memory_order_relaxed);
+
+    return job;
+}
+
+static void* worker_main(void* data) {
+    local_index = (u16) (uintptr_t) data;
+    local_deque = &deques[local_index];
+    local_ring_prepare();
+    u32 idle = 0;
+
+    while (atomic_load_explicit(&running, memory_order_acquire)) {
+        DtJob* job = find_job();
+        if (job) {
+            job_run_queued(job);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < JOB_SPIN_COUNT) {
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&sleep_lock);
+        atomic_fetch_add_explicit(&sleepers, 1, memory_order_seq_cst);
+        if (atomic_load_explicit(&queued, memory_order_seq_cst) == 0 &&
+            atomic_load_explicit(&running, memory_order_acquire))
+            pthread_cond_wait(&sleep_cond, &sleep_lock);
+        atomic_fetch_sub_explicit(&sleepers, 1, memory_order_seq_cst);
+        pthread_mutex_unlock(&sleep_lock);
+        idle = 0;
+    }
+
+    return NULL;
+}
+
+static u16 cores_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (u16) info.dwNumberOfProcessors;
+#else
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (u16) count : 1;
+#endif /*_WIN32*/
+}
@@ -0,0 +1,386 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Profiling/DtAllocTracker.h"
+
+static const char* tag_names[DT_ALLOC_TAGS_COUNT] = {
+    "other",   "pools",   "containers", "filters", "entity_info", "systems", "scenes",
+    "vectors", "rbtree",  "arenas",     "modules", "profiling",   "jobs",
+};
+
+const char* dt_alloc_tag_name(const DtAllocTag tag) {
+    return tag < DT_ALLOC_TAGS_COUNT ? tag_names[tag] : "unknown";
+}
+
+#ifdef DT_TRACK_ALLOCATIONS
+#include <stdatomic.h>
+
+#ifdef __GLIBC__
+#include <execinfo.h>
+#define GUARD_HAS_BACKTRACE
+#endif /*__GLIBC__*/
+
+#define ALLOC_TABLE_START_SIZE 4096
+#define GUARD_MAX_VIOLATIONS 32
+#define GUARD_BACKTRACE_DEPTH 16
+
+/**
+ * @brief tracked block, size is kept here so blocks don't need header and memory
+ * freed by plain free or allocated by strdup doesn't break tracking
+ */
+typedef struct {
+    void* ptr;
+    size_t size;
+    DtAllocTag tag;
+} AllocEntry;
+
+typedef struct {
+    DtAllocStats stats;
+    u64 current_frame_allocs;
+    u64 current_frame_bytes;
+} TagStats;
+
+typedef struct {
+    const char* system;
+    DtAllocTag tag;
+    size_t size;
+
+    void* frames[GUARD_BACKTRACE_DEPTH];
+    int frames_count;
+} GuardViolation;
+
+/**
+ * @brief table is filled with raw calloc, tracking of tracker would recurse
+ */
+static AllocEntry* table = NULL;
+static size_t table_size = 0;
+static size_t table_count = 0;
+
+static TagStats tag_stats[DT_ALLOC_TAGS_COUNT];
+static atomic_flag lock = ATOMIC_FLAG_INIT;
+
+static DtAllocGuardMode guard_mode = DT_ALLOC_GUARD_OFF;
+static u32 guard_warmup = 0;
+static atomic_bool guard_active = false;
+static _Thread_local const char* guard_system = NULL;
+
+static GuardViolation violations[GUARD_MAX_VIOLATIONS];
+static u64 violations_count = 0;
+
+static void tracker_lock(void);
+static void tracker_unlock(void);
+static size_t table_index(const void* ptr);
+static void table_grow(void);
+static void table_insert(void* ptr, size_t size, DtAllocTag tag);
+static void table_remove(const void* ptr);
+
+/**
+ * @brief record or abort on allocation inside of system when guard is active
+ */
+static void guard_check(size_t size, DtAllocTag tag);
+static void guard_print_violation(FILE* file, const GuardViolation* violation);
+
+void* dt_tracked_malloc(const size_t size, const DtAllocTag tag) {
+    guard_check(size, tag);
+
+    tracker_lock();
+    void* ptr = malloc(size);
+    if (ptr)
+        table_insert(ptr, size, tag);
+    tracker_unlock();
+
+    return ptr;
+}
+
+void* dt_tracked_calloc(const size_t count, const size_t size, const DtAllocTag tag) {
+    guard_check(count * size, tag);
+
+    tracker_lock();
+    void* ptr = calloc(count, size);
+    if (ptr)
+        table_insert(ptr, count * size, tag);
+    tracker_unlock();
+
+    return ptr;
+}
+
+void* dt_tracked_realloc(void* ptr, const size_t size, const DtAllocTag tag) {
+    guard_check(size, tag);
+
+    tracker_lock();
+    void* new_ptr = realloc(ptr, size);
+    if (new_ptr || size == 0) {
+        if (ptr)
+            table_remove(ptr);
+        if (new_ptr)
+            table_insert(new_ptr, size, tag);
+    }
+    tracker_unlock();
+
+    return new_ptr;
+}
+
+void dt_tracked_free(void* ptr) {
+    if (!ptr)
+        return;
+
+    tracker_lock();
+    table_remove(ptr);
+    free(ptr);
+    tracker_unlock();
+}
+
+bool dt_alloc_get_stats(const DtAllocTag tag, DtAllocStats* stats) {
+    if (tag >= DT_ALLOC_TAGS_COUNT) {
+        *stats = (DtAllocStats) {0};
+        return false;
+    }
+
+    tracker_lock();
+    *stats = tag_stats[tag].stats;
+    tracker_unlock();
+
+    return true;
+}
+
+void dt_alloc_frame_mark(void) {
+    tracker_lock();
+    for (int i = 0; i < DT_ALLOC_TAGS_COUNT; i++) {
+        tag_stats[i].stats.frame_allocs = tag_stats[i].current_frame_allocs;
+        tag_stats[i].stats.frame_bytes = tag_stats[i].current_frame_bytes;
+        tag_stats[i].current_frame_allocs = 0;
+        tag_stats[i].current_frame_bytes = 0;
+    }
+
+    if (guard_mode != DT_ALLOC_GUARD_OFF && !atomic_load(&guard_active) && --guard_warmup == 0)
+        atomic_store(&guard_active, true);
+    tracker_unlock();
+}
+
+void dt_alloc_report(FILE* file) {
+    DtAllocStats stats[DT_ALLOC_TAGS_COUNT];
+    for (int i = 0; i < DT_ALLOC_TAGS_COUNT; i++)
+        dt_alloc_get_stats(i, &stats[i]);
+
+    fprintf(file, "%-12s %12s %12s %10s %12s %12s %12s\n", "tag", "live bytes", "peak bytes",
+            "live", "allocs", "frame allocs", "frame bytes");
+
+    for (int i = 0; i < DT_ALLOC_TAGS_COUNT; i++) {
+        fprintf(file, "%-12s %12llu %12llu %10llu %12llu %12llu %12llu\n", tag_names[i],
+                (unsigned long long) stats[i].live_bytes, (unsigned long long) stats[i].peak_bytes,
+                (unsigned long long) stats[i].live_count,
+                (unsigned long long) stats[i].total_allocs,
+                (unsigned long long) stats[i].frame_allocs,
+                (unsigned long long) stats[i].frame_bytes);
+    }
+}
+
+void dt_alloc_guard_arm(const DtAllocGuardMode mode, const u32 warmup_frames) {
+    tracker_lock();
+    guard_mode = mode;
+    guard_warmup = warmup_frames;
+    violations_count = 0;
+    atomic_store(&guard_active, mode != DT_ALLOC_GUARD_OFF && warmup_frames == 0);
+    tracker_unlock();
+}
+
+bool dt_alloc_guard_is_active(void) { return atomic_load(&guard_active); }
+
+const char* dt_alloc_guard_enter(const char* system) {
+    const char* previous = guard_system;
+    guard_system = system;
+
+    return previous;
+}
+
+void dt_alloc_guard_leave(const char* previous) { guard_system = previous; }
+
+u64 dt_alloc_guard_violations(void) {
+    tracker_lock();
+    const u64 count = violations_count;
+    tracker_unlock();
+
+    return count;
+}
+
+void dt_alloc_guard_report(FILE* file) {
+    tracker_lock();
+    const u64 count = violations_count;
+    const u64 recorded = count < GUARD_MAX_VIOLATIONS ? count : GUARD_MAX_VIOLATIONS;
+
+    fprintf(file, "%llu allocations inside of systems after warm up\n", (unsigned long long) count);
+    for (u64 i = 0; i < recorded; i++)
+        guard_print_violation(file, &violations[i]);
+    tracker_unlock();
+}
+
+static void guard_check(const size_t size, const DtAllocTag tag) {
+    if (!guard_system || !atomic_load_explicit(&guard_active, memory_order_relaxed))
+        return;
+
+    GuardViolation violation = {
+        .system = guard_system,
+        .tag = tag,
+        .size = size,
+    };
+#ifdef GUARD_HAS_BACKTRACE
+    violation.frames_count = backtrace(violation.frames, GUARD_BACKTRACE_DEPTH);
+#endif /*GUARD_HAS_BACKTRACE*/
+
+    if (guard_mode == DT_ALLOC_GUARD_ABORT) {
+        guard_print_violation(stderr, &violation);
+        abort();
+    }
+
+    tracker_lock();
+    if (violations_count < GUARD_MAX_VIOLATIONS)
+        violations[violations_count] = violation;
+    violations_count++;
+    tracker_unlock();
+}
+
+static void guard_print_violation(FILE* file, const GuardViolation* violation) {
+    fprintf(file, "[WARNING] system \"%s\" allocated %llu bytes (%s) in steady state frame\n",
+            violation->system, (unsigned long long) violation->size,
+            dt_alloc_tag_name(violation->tag));
+
+#ifdef GUARD_HAS_BACKTRACE
+    fflush(file);
+    backtrace_symbols_fd(violation->frames, violation->frames_count, fileno(file));
+#endif /*GUARD_HAS_BACKTRACE*/
+}
+
+static void tracker_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire)) {
+    }
+}
+
+static void tracker_unlock(void) { atomic_flag_clear_explicit(&lock, memory_order_release); }
+
+static size_t table_index(const void* ptr) {
+    // low bits are always zero because of malloc alignment
+    const u64 key = (u64) (uintptr_t) ptr >> 4;
+    return (size_t) (key * 0x9E3779B97F4A7C15ULL) & (table_size - 1);
+}
+
+static void table_grow(void) {
+    AllocEntry* old_table = table;
+    const size_t old_size = table_size;
+
+    table_size = table_size ? table_size * 2 : ALLOC_TABLE_START_SIZE;
+    table = calloc(table_size, sizeof(AllocEntry));
+    if (!table) {
+        fprintf(stderr, "[WARNING] allocation tracker table calloc failed\n");
+        exit(1);
+    }
+
+    for (size_t i = 0; i < old_size; i++) {
+        if (!old_table[i].ptr)
+            continue;
+
+        size_t idx = table_index(old_table[i].ptr);
+        while (table[idx].ptr)
+            idx = (idx + 1) & (table_size - 1);
+        table[idx] = old_table[i];
+    }
+
+    free(old_table);
+}
+
+static void table_insert(void* ptr, const size_t size, const DtAllocTag tag) {
+    // address freed by plain free can come back from malloc, its stale entry is dropped
+    table_remove(ptr);
+
+    if ((table_count + 1) * 2 > table_size)
+        table_grow();
+
+    size_t idx = table_index(ptr);
+    while (table[idx].ptr)
+        idx = (idx + 1) & (table_size - 1);
+
+    table[idx] = (AllocEntry) {.ptr = ptr, .size = size, .tag = tag};
+    table_count++;
+
+    TagStats* stats = &tag_stats[tag < DT_ALLOC_TAGS_COUNT ? tag : DT_ALLOC_OTHER];
+    stats->stats.live_bytes += size;
+    stats->stats.live_count++;
+    stats->stats.total_allocs++;
+    stats->current_frame_allocs++;
+    stats->current_frame_bytes += size;
+
+    if (stats->stats.live_bytes > stats->stats.peak_bytes)
+        stats->stats.peak_bytes = stats->stats.live_bytes;
+}
+
+static void table_remove(const void* ptr) {
+    if (!table_count)
+        return;
+
+    size_t idx = table_index(ptr);
+    while (table[idx].ptr && table[idx].ptr != ptr)
+        idx = (idx + 1) & (table_size - 1);
+
+    if (!table[idx].ptr)
+        return;
+
+    TagStats* stats = &tag_stats[table[idx].tag < DT_ALLOC_TAGS_COUNT ? table[idx].tag : 0];
+    stats->stats.live_bytes -= table[idx].size;
+    stats->stats.live_count--;
+    stats->stats.total_frees++;
+
+    // backward shift keeps probe chains without tombstones
+    size_t hole = idx;
+    size_t next = (hole + 1) & (table_size - 1);
+    while (table[next].ptr) {
+        const size_t home = table_index(table[next].ptr);
+        const bool movable =
+            hole <= next ? home <= hole || home > next : home <= hole && home > next;
+        if (movable) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & (table_size - 1);
+    }
+
+    table[hole] = (AllocEntry) {0};
+    table_count--;
+}
+#else
+void* dt_tracked_malloc(const size_t size, const DtAllocTag tag) { return malloc(size); }
+
+void* dt_tracked_calloc(const size_t count, const size_t size, const DtAllocTag tag) {
+    return calloc(count, size);
+}
+
+void* dt_tracked_realloc(void* ptr, const size_t size, const DtAllocTag tag) {
+    return realloc(ptr, size);
+}
+
+void dt_tracked_free(void* ptr) { free(ptr); }
+
+bool dt_alloc_get_stats(const DtAllocTag tag, DtAllocStats* stats) {
+    *stats = (DtAllocStats) {0};
+    return false;
+}
+
+void dt_alloc_frame_mark(void) {}
+
+void dt_alloc_report(FILE* file) {
+    fprintf(file, "allocation report is empty, built without DT_TRACK_ALLOCATIONS\n");
+}
+
+void dt_alloc_guard_arm(const DtAllocGuardMode mode, const u32 warmup_frames) {
+    if (mode != DT_ALLOC_GUARD_OFF)
+        fprintf(stderr, "[WARNING] allocation guard needs DT_TRACK_ALLOCATIONS, ignored\n");
+}
+
+bool dt_alloc_guard_is_active(void) { return false; }
+
+const char* dt_alloc_guard_enter(const char* system) { return NULL; }
+
+void dt_alloc_guard_leave(const char* previous) {}
+
+u64 dt_alloc_guard_violations(void) { return 0; }
+
+void dt_alloc_guard_report(FILE* file) {}
+#endif /*DT_TRACK_ALLOCATIONS*/
@@ -0,0 +1,115 @@
+#ifndef DT_ALLOC_TRACKER_H
+#define DT_ALLOC_TRACKER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "DtNumericalTypes.h"
+
+/*=============================================================================
+ *                      Учет выделений памяти (DtAllocTracker)
+ *============================================================================*/
+
+/**
+ * @brief subsystem allocation is counted for, translation unit selects its tag by defining
+ * DT_ALLOC_TAG before includes, DT_ALLOC_OTHER is used otherwise
+ */
+typedef enum {
+    DT_ALLOC_OTHER,
+    DT_ALLOC_POOLS,
+    DT_ALLOC_CONTAINERS,
+    DT_ALLOC_FILTERS,
+    DT_ALLOC_ENTITY_INFO,
+    DT_ALLOC_SYSTEMS,
+    DT_ALLOC_SCENES,
+    DT_ALLOC_VECTORS,
+    DT_ALLOC_RBTREE,
+    DT_ALLOC_ARENAS,
+    DT_ALLOC_MODULES,
+    DT_ALLOC_PROFILING,
+    DT_ALLOC_JOBS,
+    DT_ALLOC_TAGS_COUNT,
+} DtAllocTag;
+
+typedef struct {
+    u64 live_bytes;
+    u64 peak_bytes;
+    u64 live_count;
+
+    u64 total_allocs;
+    u64 total_frees;
+
+    /**
+     * @brief allocations done between two last dt_alloc_frame_mark calls
+     */
+    u64 frame_allocs;
+    u64 frame_bytes;
+} DtAllocStats;
+
+/**
+ * @brief tracked versions of allocation functions, used by DT_MALLOC family
+ * when built with DT_TRACK_ALLOCATIONS
+ *
+ * @note memory from untracked malloc or strdup can be passed to dt_tracked_free,
+ * it's released without changing stats
+ */
+void* dt_tracked_malloc(size_t size, DtAllocTag tag);
+void* dt_tracked_calloc(size_t count, size_t size, DtAllocTag tag);
+void* dt_tracked_realloc(void* ptr, size_t size, DtAllocTag tag);
+void dt_tracked_free(void* ptr);
+
+const char* dt_alloc_tag_name(DtAllocTag tag);
+
+/**
+ * @brief return false and zero stats if built without DT_TRACK_ALLOCATIONS
+ */
+bool dt_alloc_get_stats(DtAllocTag tag, DtAllocStats* stats);
+
+/**
+ * @brief close current frame, frame_allocs and frame_bytes of stats describe it after call
+ */
+void dt_alloc_frame_mark(void);
+
+/**
+ * @brief print live, peak and per frame figures of every tag
+ */
+void dt_alloc_report(FILE* file);
+
+/*=============================================================================
+ *                   Запрет выделений в кадре (DtAllocGuard)
+ *============================================================================*/
+
+/**
+ * @brief steady state frames must not allocate, guard catches DT_MALLOC, DT_CALLOC and
+ * DT_REALLOC called while update or draw system runs, works only with DT_TRACK_ALLOCATIONS
+ */
+typedef enum {
+    DT_ALLOC_GUARD_OFF,
+    DT_ALLOC_GUARD_RECORD,
+    DT_ALLOC_GUARD_ABORT,
+} DtAllocGuardMode;
+
+/**
+ * @brief guard becomes active after warmup_frames calls of dt_alloc_frame_mark,
+ * record mode keeps violations with backtraces, abort mode prints first one and aborts
+ */
+void dt_alloc_guard_arm(DtAllocGuardMode mode, u32 warmup_frames);
+
+bool dt_alloc_guard_is_active(void);
+
+/**
+ * @brief set system of calling thread, allocations outside of systems aren't checked
+ *
+ * @return system which was set before, it's restored by leave
+ */
+const char* dt_alloc_guard_enter(const char* system);
+void dt_alloc_guard_leave(const char* previous);
+
+u64 dt_alloc_guard_violations(void);
+
+/**
+ * @brief print recorded violations with system, tag, size and backtrace
+ */
+void dt_alloc_guard_report(FILE* file);
+
+#endif /*DT_ALLOC_TRACKER_H*/
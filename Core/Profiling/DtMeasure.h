@@ -0,0 +1,35 @@
+#ifndef DT_MEASURE_H
+#define DT_MEASURE_H
+
+#include <stdio.h>
+#include "DtNumericalTypes.h"
+
+/*=============================================================================
+ *                     Общее для замеров (бенчмарки, headless)
+ *============================================================================*/
+
+#ifdef _WIN32
+#define DT_NULL_DEVICE "NUL"
+#else
+#define DT_NULL_DEVICE "/dev/null"
+#endif /*_WIN32*/
+
+/**
+ * @brief qsort comparator of u64 samples in ascending order
+ */
+static inline int dt_measure_compare_u64(const void* a, const void* b) {
+    const u64 lhs = *(const u64*) a;
+    const u64 rhs = *(const u64*) b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief redirect stdout to null device, engine logs every structural change to stdout,
+ * it would dominate measured times, warnings and reports go to stderr
+ */
+static inline void dt_measure_mute_stdout(void) {
+    if (!freopen(DT_NULL_DEVICE, "w", stdout))
+        fprintf(stderr, "[WARNING] can't mute engine output\n");
+}
+
+#endif /*DT_MEASURE_H*/
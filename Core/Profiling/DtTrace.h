@@ -0,0 +1,81 @@
+#ifndef DT_TRACE_H
+#define DT_TRACE_H
+
+#include <stdbool.h>
+#include "DtNumericalTypes.h"
+
+/*=============================================================================
+ *                          Трассировка (DtTrace)
+ *============================================================================*/
+
+/**
+ * @brief scoped zones are recorded only inside captured frames range and only when
+ * built with DT_TRACE, every thread writes into its own buffer without locks
+ *
+ * @note zone name isn't copied, it must live until trace is dumped
+ */
+
+#ifdef DT_TRACE
+#include <stdatomic.h>
+#include "DtTime.h"
+
+typedef struct {
+    const char* name;
+    u64 start;
+} DtTraceZone;
+
+extern atomic_bool dt_trace_recording;
+
+void dt_trace_push(const char* name, u64 start, u64 end);
+
+static inline DtTraceZone dt_trace_zone_begin(const char* name) {
+    const bool recording = atomic_load_explicit(&dt_trace_recording, memory_order_relaxed);
+    return (DtTraceZone) {
+        .name = name,
+        .start = recording ? dt_time_now_ns() : 0,
+    };
+}
+
+static inline void dt_trace_zone_end(const DtTraceZone* zone) {
+    if (zone->start)
+        dt_trace_push(zone->name, zone->start, dt_time_now_ns());
+}
+
+#define DT_TRACE_CONCAT_(a, b) a##b
+#define DT_TRACE_CONCAT(a, b) DT_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief record zone from this line to end of enclosing block
+ */
+#define DT_TRACE_ZONE(name)                                                                        \
+    __attribute__((cleanup(dt_trace_zone_end))) const DtTraceZone DT_TRACE_CONCAT(                 \
+        dt_trace_zone_, __LINE__) = dt_trace_zone_begin(name)
+#else
+#define DT_TRACE_ZONE(name) ((void) 0)
+#endif /*DT_TRACE*/
+
+/**
+ * @brief record zone named after enclosing function
+ */
+#define DT_TRACE_FUNCTION() DT_TRACE_ZONE(__func__)
+
+/**
+ * @brief record next frames, previous capture is dropped
+ */
+void dt_trace_capture(u32 frames);
+
+/**
+ * @brief mark end of frame, starts and stops requested capture
+ *
+ * @return true on frame when requested capture was completed
+ */
+bool dt_trace_frame_mark(void);
+
+bool dt_trace_is_capturing(void);
+
+/**
+ * @brief write captured zones of all threads in Chrome trace json format
+ */
+bool dt_trace_dump(const char* path);
+
+#endif /*DT_TRACE_H*/
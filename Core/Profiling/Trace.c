@@ -0,0 +1,197 @@
+#define DT_ALLOC_TAG DT_ALLOC_PROFILING
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "DtAllocators.h"
+#include "Profiling/DtTrace.h"
+
+#ifdef DT_TRACE
+#define TRACE_BUFFER_SIZE 65536
+#define TRACE_FRAME_ZONE "frame"
+
+typedef struct {
+    const char* name;
+    u64 start;
+    u64 end;
+} TraceEvent;
+
+/**
+ * @brief events are written only by owner thread, count is published with release
+ * so dump sees complete events, buffer is reset by owner on first push of new capture
+ */
+typedef struct TraceBuffer {
+    TraceEvent events[TRACE_BUFFER_SIZE];
+    atomic_uint count;
+    atomic_uint generation;
+    atomic_uint dropped;
+    u32 thread_id;
+
+    struct TraceBuffer* next;
+} TraceBuffer;
+
+atomic_bool dt_trace_recording = false;
+
+static _Atomic(TraceBuffer*) buffers = NULL;
+static atomic_uint capture_generation = 0;
+static atomic_uint threads_count = 0;
+static _Thread_local TraceBuffer* local_buffer = NULL;
+
+static bool capture_requested = false;
+static u32 frames_left = 0;
+static u64 capture_start = 0;
+static u64 frame_start = 0;
+
+static TraceBuffer* trace_buffer_new(void);
+static void trace_write_name(FILE* file, const char* name);
+
+void dt_trace_push(const char* name, const u64 start, const u64 end) {
+    TraceBuffer* buffer = local_buffer ? local_buffer : trace_buffer_new();
+
+    const u32 generation = atomic_load_explicit(&capture_generation, memory_order_acquire);
+    if (atomic_load_explicit(&buffer->generation, memory_order_relaxed) != generation) {
+        atomic_store_explicit(&buffer->count, 0, memory_order_relaxed);
+        atomic_store_explicit(&buffer->dropped, 0, memory_order_relaxed);
+        atomic_store_explicit(&buffer->generation, generation, memory_order_release);
+    }
+
+    const u32 count = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+    if (count == TRACE_BUFFER_SIZE) {
+        atomic_fetch_add_explicit(&buffer->dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[count] = (TraceEvent) {
+        .name = name,
+        .start = start,
+        .end = end,
+    };
+    atomic_store_explicit(&buffer->count, count + 1, memory_order_release);
+}
+
+void dt_trace_capture(const u32 frames) {
+    if (frames == 0)
+        return;
+
+    atomic_store_explicit(&dt_trace_recording, false, memory_order_relaxed);
+    capture_requested = true;
+    frames_left = frames;
+}
+
+bool dt_trace_frame_mark(void) {
+    const u64 now = dt_time_now_ns();
+
+    if (capture_requested) {
+        capture_requested = false;
+        atomic_fetch_add_explicit(&capture_generation, 1, memory_order_release);
+        atomic_store_explicit(&dt_trace_recording, true, memory_order_relaxed);
+
+        capture_start = now;
+        frame_start = now;
+        return false;
+    }
+
+    if (!atomic_load_explicit(&dt_trace_recording, memory_order_relaxed))
+        return false;
+
+    dt_trace_push(TRACE_FRAME_ZONE, frame_start, now);
+    frame_start = now;
+
+    if (--frames_left > 0)
+        return false;
+
+    atomic_store_explicit(&dt_trace_recording, false, memory_order_relaxed);
+    return true;
+}
+
+bool dt_trace_is_capturing(void) {
+    return capture_requested || atomic_load_explicit(&dt_trace_recording, memory_order_relaxed);
+}
+
+bool dt_trace_dump(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    const u32 generation = atomic_load_explicit(&capture_generation, memory_order_acquire);
+    bool first = true;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    for (const TraceBuffer* buffer = atomic_load(&buffers); buffer; buffer = buffer->next) {
+        if (atomic_load_explicit(&buffer->generation, memory_order_acquire) != generation)
+            continue;
+
+        fprintf(file,
+                "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                "\"args\":{\"name\":\"thread %u\"}}",
+                first ? "" : ",", buffer->thread_id, buffer->thread_id);
+        first = false;
+
+        const u32 count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+        for (u32 i = 0; i < count; i++) {
+            const TraceEvent* event = &buffer->events[i];
+            if (event->start < capture_start)
+                continue;
+
+            fprintf(file, ",\n{\"name\":");
+            trace_write_name(file, event->name);
+            fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer->thread_id, (double) (event->start - capture_start) / 1000.0,
+                    (double) (event->end - event->start) / 1000.0);
+        }
+
+        const u32 dropped = atomic_load_explicit(&buffer->dropped, memory_order_relaxed);
+        if (dropped)
+            fprintf(stderr, "[WARNING] trace buffer of thread %u dropped %u zones\n",
+                    buffer->thread_id, dropped);
+    }
+
+    fprintf(file, "\n]}\n");
+    const bool ok = !ferror(file);
+    fclose(file);
+
+    return ok;
+}
+
+static TraceBuffer* trace_buffer_new(void) {
+    TraceBuffer* buffer = DT_MALLOC(sizeof(TraceBuffer));
+    if (!buffer) {
+        printf("[DEBUG] Failed to allocate trace buffer\n");
+        exit(1);
+    }
+
+    atomic_init(&buffer->count, 0);
+    atomic_init(&buffer->generation, 0);
+    atomic_init(&buffer->dropped, 0);
+    buffer->thread_id = atomic_fetch_add(&threads_count, 1);
+
+    TraceBuffer* head = atomic_load(&buffers);
+    do {
+        buffer->next = head;
+    } while (!atomic_compare_exchange_weak(&buffers, &head, buffer));
+
+    local_buffer = buffer;
+    return buffer;
+}
+
+static void trace_write_name(FILE* file, const char* name) {
+    fputc('"', file);
+    for (const char* c = name ? name : "unknown"; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', file);
+        if ((unsigned char) *c >= 0x20)
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+#else
+void dt_trace_capture(const u32 frames) {
+    printf("[DEBUG] trace capture of %u frames ignored, built without DT_TRACE\n", frames);
+}
+
+bool dt_trace_frame_mark(void) { return false; }
+
+bool dt_trace_is_capturing(void) { return false; }
+
+bool dt_trace_dump(const char* path) { return false; }
+#endif /*DT_TRACE*/
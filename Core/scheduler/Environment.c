@@ -1,10 +1,15 @@
+#define DT_ALLOC_TAG DT_ALLOC_MODULES
+
 #include "Collections/Collections.h"
 #include "DtAllocators.h"
 #include "ExecuteOrder.h"
+#include "Profiling/DtTrace.h"
 #include "RuntimeScheduler.h"
 
 static DtEnvironment environment;
 
+static ModuleInfo* module_load(DtEnvironment* env, const char* path);
+
 static int get_hash(const char* name) {
     int hash = 2147483647;
     while (*name) {
@@ -19,10 +24,17 @@ __attribute__((constructor(DT_ORDER_INIT_ENVIRONMENT))) static void initialize_e
         .active_scene = NULL,
         .modules = dt_rb_tree_new(),
         .scenes = dt_rb_tree_new(),
+        .modules_list = DT_VEC_NEW(ModuleInfo*, 4),
+        .scenes_lock = PTHREAD_MUTEX_INITIALIZER,
 
         .get_component = dt_component_get_data_by_name,
         .get_update = dt_update_get_data_by_name,
         .get_draw = dt_draw_get_data_by_name,
+        .get_event = dt_event_get_data_by_name,
+
+        .submit_job = dt_job_submit,
+        .submit_main_job = dt_job_submit_main,
+        .wait_jobs = dt_job_wait,
     };
 
     environment.modules.iterator.enumerable = &environment.modules;
@@ -38,6 +50,21 @@ __attribute__((constructor(DT_ORDER_INIT_ENVIRONMENT))) static void initialize_e
 DtEnvironment* dt_environment_instance(void) { return &environment; }
 
 ModuleInfo* dt_module_load(DtEnvironment* env, const char* path) {
+    DT_TRACE_FUNCTION();
+
+    // constructors of module register its types
+    const bool frozen = dt_registries_frozen();
+    dt_registries_unfreeze();
+
+    ModuleInfo* info = module_load(env, path);
+
+    if (frozen)
+        dt_registries_freeze();
+
+    return info;
+}
+
+static ModuleInfo* module_load(DtEnvironment* env, const char* path) {
     DT_LIB_HANDLE lib = DT_LIB_LOAD(path);
     if (!lib) {
         fprintf(stderr, "[DEBUG] library hasn't loaded: %s\n", path);
@@ -78,6 +105,7 @@ ModuleInfo* dt_module_load(DtEnvironment* env, const char* path) {
     };
 
     dt_rb_tree_add(&env->modules, info, hash);
+    DT_VEC_ADD(env->modules_list, info);
     if (info->initialize)
         info->initialize(env);
 
@@ -99,28 +127,40 @@ void dt_module_unload(DtEnvironment* env, ModuleInfo* info) {
         info->deinitialize(env);
 
     dt_rb_tree_remove(&env->modules, get_hash(info->name));
+    DT_VEC_REMOVE(env->modules_list, info);
     DT_LIB_CLOSE(info->handle);
 }
 
-const DtScene* dt_scenes_get_active(void) { return environment.active_scene; }
+const DtScene* dt_scenes_get_active(void) {
+    pthread_mutex_lock(&environment.scenes_lock);
+    const DtScene* scene = environment.active_scene;
+    pthread_mutex_unlock(&environment.scenes_lock);
+
+    return scene;
+}
 
 const DtScene* dt_scenes_set_active(const char* name) {
-    const DtScene* scene = environment.active_scene;
     const u64 hash = get_hash(name);
+
+    pthread_mutex_lock(&environment.scenes_lock);
+    const DtScene* scene = environment.active_scene;
     DtScene* new_scene = dt_rb_tree_get(&environment.scenes, hash);
 
-    if (!new_scene)
-        return NULL;
+    if (new_scene)
+        environment.active_scene = new_scene;
+    pthread_mutex_unlock(&environment.scenes_lock);
 
-    environment.active_scene = new_scene;
-    return scene;
+    return new_scene ? scene : NULL;
 }
 
 const DtScene* dt_scenes_set_active_by(const DtScene* scene) {
     if (!scene)
         return NULL;
 
+    pthread_mutex_lock(&environment.scenes_lock);
     const DtScene* prev_scene = environment.active_scene;
     environment.active_scene = scene;
+    pthread_mutex_unlock(&environment.scenes_lock);
+
     return prev_scene;
 }
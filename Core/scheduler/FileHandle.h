@@ -40,4 +40,44 @@
 #define DT_EXPORT __attribute__((visibility("default")))
 #endif /*_WIN32*/
 
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief read-only view of a file mapped into memory
+ */
+typedef struct {
+    const void* data;
+    size_t size;
+
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif /*_WIN32*/
+} DtMappedFile;
+
+/**
+ * @brief map whole file into memory for reading
+ *
+ * @param path path to file
+ * @param file output mapping
+ *
+ * @note return false if file can't be opened or mapped
+ */
+bool dt_file_map(const char* path, DtMappedFile* file);
+
+/**
+ * @brief unmap file mapped by dt_file_map
+ */
+void dt_file_unmap(DtMappedFile* file);
+
+/**
+ * @brief atomically replace dst with src, src is removed
+ *
+ * @note return false if file can't be replaced, dst is kept untouched then
+ */
+bool dt_file_replace(const char* src, const char* dst);
+
 #endif /*FILE_HANDLE_H*/
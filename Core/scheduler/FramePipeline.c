@@ -0,0 +1,25 @@
+#include "Jobs/DtJobs.h"
+#include "Profiling/DtTrace.h"
+#include "RuntimeScheduler.h"
+
+static void frame_pipeline_job(void* data);
+
+void dt_frame_pipeline_begin(DtFramePipeline* pipeline) {
+    dt_draw_handler_begin_update(pipeline->scene->draw_handler);
+    dt_job_submit(frame_pipeline_job, pipeline, &pipeline->counter);
+}
+
+void dt_frame_pipeline_end(DtFramePipeline* pipeline) {
+    dt_job_wait(&pipeline->counter);
+    dt_draw_handler_end_update(pipeline->scene->draw_handler);
+    dt_draw_handler_swap(pipeline->scene->draw_handler);
+}
+
+static void frame_pipeline_job(void* data) {
+    DT_TRACE_FUNCTION();
+    DtFramePipeline* pipeline = data;
+
+    dt_update_handler_update(pipeline->scene->update_handler, &pipeline->ctx);
+    dt_draw_handler_set_alpha(pipeline->scene->draw_handler, pipeline->ctx.alpha);
+    dt_draw_handler_extract(pipeline->scene->draw_handler);
+}
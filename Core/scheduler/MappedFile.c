@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include "FileHandle.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /*_WIN32*/
+
+#ifdef _WIN32
+bool dt_file_map(const char* path, DtMappedFile* file) {
+    *file = (DtMappedFile) {0};
+
+    file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file->file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->file, &size)) {
+        CloseHandle(file->file);
+        return false;
+    }
+
+    file->size = (size_t) size.QuadPart;
+    if (file->size == 0)
+        return true;
+
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!file->mapping) {
+        fprintf(stderr, "[ERROR] Could not map file %s\n", path);
+        CloseHandle(file->file);
+        return false;
+    }
+
+    file->data = MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!file->data) {
+        fprintf(stderr, "[ERROR] Could not map file %s\n", path);
+        CloseHandle(file->mapping);
+        CloseHandle(file->file);
+        return false;
+    }
+
+    return true;
+}
+
+void dt_file_unmap(DtMappedFile* file) {
+    if (file->data)
+        UnmapViewOfFile(file->data);
+    if (file->mapping)
+        CloseHandle(file->mapping);
+    if (file->file && file->file != INVALID_HANDLE_VALUE)
+        CloseHandle(file->file);
+
+    *file = (DtMappedFile) {0};
+}
+
+bool dt_file_replace(const char* src, const char* dst) {
+    if (!MoveFileExA(src, dst, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        fprintf(stderr, "[ERROR] Could not replace file %s\n", dst);
+        return false;
+    }
+
+    return true;
+}
+#else
+bool dt_file_map(const char* path, DtMappedFile* file) {
+    *file = (DtMappedFile) {.fd = -1};
+
+    file->fd = open(path, O_RDONLY);
+    if (file->fd < 0) {
+        fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(file->fd, &st) != 0) {
+        close(file->fd);
+        file->fd = -1;
+        return false;
+    }
+
+    file->size = (size_t) st.st_size;
+    if (file->size == 0)
+        return true;
+
+    void* data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "[ERROR] Could not map file %s\n", path);
+        close(file->fd);
+        file->fd = -1;
+        return false;
+    }
+
+    madvise(data, file->size, MADV_SEQUENTIAL);
+    file->data = data;
+
+    return true;
+}
+
+void dt_file_unmap(DtMappedFile* file) {
+    if (file->data)
+        munmap((void*) file->data, file->size);
+    if (file->fd >= 0)
+        close(file->fd);
+
+    *file = (DtMappedFile) {.fd = -1};
+}
+
+bool dt_file_replace(const char* src, const char* dst) {
+    if (rename(src, dst) != 0) {
+        fprintf(stderr, "[ERROR] Could not replace file %s\n", dst);
+        return false;
+    }
+
+    return true;
+}
+#endif /*_WIN32*/
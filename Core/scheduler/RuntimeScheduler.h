@@ -1,8 +1,10 @@
 #ifndef LAZY_LOAD_H
 #define LAZY_LOAD_H
 #include <cjson/cJSON.h>
+#include <pthread.h>
 #include "Ecs/RegisterHandler.h"
 #include "FileHandle.h"
+#include "Jobs/DtJobs.h"
 
 #define DT_MODULE_INITIALIZE dt_module_initialize
 #define DT_MODULE_INITIALIZE_STR "dt_module_initialize"
@@ -34,7 +36,9 @@ typedef struct {
     DrawHandler* draw_handler;
 } DtScene;
 
-// TODO: comments
+/**
+ * @brief load every .dt.scene and .dt.bscene file of directory, subdirectories are skipped
+ */
 void dt_add_scenes(const char* directory);
 // TODO: comments
 const DtScene* dt_add_scene(const char* path);
@@ -53,6 +57,124 @@ void dt_scene_unload_by(const DtScene* scene);
 // TODO: comments
 bool dt_scenes_scene_is_loaded(const char* name);
 
+/**
+ * @brief serialize scene into json in .dt.scene format
+ */
+cJSON* dt_scene_to_json(const DtScene* scene);
+
+/**
+ * @brief serialize single entity with its components and parent
+ */
+cJSON* dt_scene_entity_to_json(const DtEcsManager* manager, DtEntity entity);
+
+/**
+ * @brief save scene into .dt.scene file
+ */
+bool dt_scene_save_json(const DtScene* scene, const char* path);
+
+/**
+ * @brief cache of serialized entities for incremental saving in background
+ */
+typedef struct DtSceneSaver DtSceneSaver;
+
+/**
+ * @brief saver without cached entities, first save serializes whole scene
+ */
+DtSceneSaver* dt_scene_saver_new(void);
+
+/**
+ * @brief mark entity as changed since last save, new entities are found automatically
+ */
+void dt_scene_saver_mark_dirty(DtSceneSaver* saver, DtEntity entity);
+
+/**
+ * @brief drop all cached entities, next save serializes whole scene
+ *
+ * @note call it whenever manager of saved scene is replaced or restored, cached entities
+ * aren't matched against manager
+ */
+void dt_scene_saver_mark_all(DtSceneSaver* saver);
+
+/**
+ * @brief copy dirty entities, then serialize them and write scene file on background thread
+ *
+ * @note previous save is waited first, scene may change as soon as it returns, file is
+ * written into temporary file and replaces path only when fully written
+ */
+bool dt_scene_saver_save_async(DtSceneSaver* saver, const DtScene* scene, const char* path);
+
+/**
+ * @brief wait for running save, return false if last save failed
+ */
+bool dt_scene_saver_wait(DtSceneSaver* saver);
+
+/**
+ * @brief wait for running save and free saver with its cached entities
+ */
+void dt_scene_saver_free(DtSceneSaver* saver);
+
+/**
+ * @brief scene state kept while module with its components and systems is reloaded
+ */
+typedef struct DtSceneReload DtSceneReload;
+
+/**
+ * @brief capture component layouts and system names of scene, call before module is unloaded
+ *
+ * @note initialized systems must be destroyed by caller before unload
+ */
+DtSceneReload* dt_scene_reload_begin(const DtScene* scene);
+
+/**
+ * @brief migrate scene pools in place and create scene systems from reloaded module
+ *
+ * @note reload is freed in any case, new systems aren't initialized
+ * @return false if components can't be migrated, scene must be loaded from file then
+ */
+bool dt_scene_reload_end(const DtScene* scene, DtSceneReload* reload);
+
+/**
+ * @brief save scene into compiled .dt.bscene file
+ *
+ * @note components are stored as raw columns and loaded without parsing,
+ * column is skipped on load if component layout was changed
+ */
+bool dt_scene_save_binary(const DtScene* scene, const char* path);
+
+/**
+ * @brief load compiled .dt.bscene file, scene isn't added to environment
+ */
+DtScene* dt_scene_parse_binary(const char* path, DtEnvironment* env);
+
+/**
+ * @brief load prefab from .dt.scene or .dt.bscene file, all alive entities are frozen
+ */
+DtPrefab* dt_prefab_load(const char* path);
+
+/**
+ * @brief update of next frame running as job beside drawing of previous one
+ */
+typedef struct {
+    const DtScene* scene;
+    DtUpdateContext ctx;
+    DtJobCounter counter;
+} DtFramePipeline;
+
+/**
+ * @brief start update and extraction of scene as job, draw handler of scene keeps
+ * drawing previously extracted frame until dt_frame_pipeline_end
+ *
+ * @note draw systems without extract read live pools, they are skipped by draw and run
+ * by dt_frame_pipeline_end once update is done
+ */
+void dt_frame_pipeline_begin(DtFramePipeline* pipeline);
+
+/**
+ * @brief wait for update of frame, draw systems without extract and make extracted frame
+ * drawn, call after drawing
+ */
+void dt_frame_pipeline_end(DtFramePipeline* pipeline);
+
 // TODO: add comment
 typedef struct {
     char* name;
@@ -70,6 +192,17 @@ struct DtEnvironment {
     DtRbTree modules;
     DtRbTree scenes;
 
+    /**
+     * @brief loaded modules as plain array, registry lookups read it from any thread
+     * instead of iterator of modules tree, it's changed only by module load and unload
+     */
+    DT_VEC(ModuleInfo*) modules_list;
+
+    /**
+     * @brief guards scenes tree and active scene, worlds may load scenes in parallel
+     */
+    pthread_mutex_t scenes_lock;
+
     const DtComponentData** components;
     u16 components_count;
     const DtUpdateData** updaters;
@@ -83,12 +216,22 @@ struct DtEnvironment {
     const DtComponentData* (*get_component)(const char* name);
     const DtUpdateData* (*get_update)(const char* name);
     const DtDrawData* (*get_draw)(const char* name);
+    const DtEventData* (*get_event)(const char* name);
+
+    void (*submit_job)(DtJobFunc func, void* data, DtJobCounter* counter);
+    void (*submit_main_job)(DtJobFunc func, void* data, DtJobCounter* counter);
+    void (*wait_jobs)(DtJobCounter* counter);
 };
 
 // TODO: comments
 typedef void (*DtEnvironmentHandle)(DtEnvironment*);
 
-// TODO: comments
+/**
+ * @brief load module and register its types, frozen registries are unfrozen while
+ * module is initialized
+ *
+ * @warning modules mustn't be loaded or unloaded while worlds simulate
+ */
 ModuleInfo* dt_module_load(DtEnvironment* env, const char* path);
 
 // TODO: comments
@@ -110,6 +253,12 @@ void dt_link_parser_json_to_type(const char* type, const char* base_type);
 DT_EXPORT
 void dt_parse_json_to_type(const char* type, cJSON* src, void* dst);
 
+/**
+ * @brief return parser registered for type or NULL
+ */
+DT_EXPORT
+TypeParser dt_get_parser_json_to_type(const char* type);
+
 // TODO: comments
 DT_EXPORT
 void dt_add_serializer_type_to_json(const char* type, TypeSerializer serializer);
@@ -118,4 +267,10 @@ void dt_add_serializer_type_to_json(const char* type, TypeSerializer serializer)
 DT_EXPORT
 cJSON* dt_serialize_type_to_json(const char* type, const void* src);
 
+/**
+ * @brief return serializer registered for type or NULL
+ */
+DT_EXPORT
+TypeSerializer dt_get_serializer_type_to_json(const char* type);
+
 #endif /*LAZY_LOAD_H*/
@@ -0,0 +1,498 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define DT_SCENE_BINARY_MAGIC 0x42535444 /* "DTSB" */
+#define DT_SCENE_BINARY_VERSION 1
+#define DT_SCENE_BINARY_ALIGN 8
+#define DT_SCENE_BINARY_NULL_STRING 0xFFFFFFFFu
+
+/**
+ * @brief header of compiled scene file
+ *
+ * @note file layout: header, system names, hierarchy table, component columns.
+ * every section is aligned to DT_SCENE_BINARY_ALIGN
+ */
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 entity_count;
+    DtEcsManagerConfig config;
+    u16 update_count;
+    u16 draw_count;
+    u16 column_count;
+    u16 padding;
+} DtSceneBinaryHeader;
+
+/**
+ * @brief header of one component column
+ *
+ * @note followed by name, entities[count], rows[count] in registered field layout and
+ * strings of char* fields (u32 length + bytes for every char* field of every row)
+ */
+typedef struct {
+    u64 layout_hash;
+    u32 component_size;
+    u32 strings_size;
+    u16 count;
+    u16 name_length;
+    u32 padding;
+} DtSceneBinaryColumn;
+
+typedef struct {
+    const u8* data;
+    size_t size;
+    size_t offset;
+} BinaryReader;
+
+static size_t align_size(size_t size);
+static const void* reader_take(BinaryReader* reader, size_t size);
+static bool write_section(FILE* file, const void* data, size_t size);
+static bool write_padding(FILE* file, size_t size);
+static bool write_string_field(FILE* file, const char* str);
+static bool is_string_field(const DtComponentData* data, u16 field);
+static u16 get_pool_entities(const DtEcsManager* manager, const DtEcsPool* pool,
+                             DtEntity* entities);
+static u32 get_column_strings_size(const DtComponentData* data, const DtEcsPool* pool,
+                                   const DtEntity* entities, u16 count);
+static bool write_column(FILE* file, const DtEcsManager* manager, const DtEcsPool* pool,
+                         DtEntity* entities);
+static bool read_systems(BinaryReader* reader, const DtSceneBinaryHeader* header, DtScene* scene);
+static bool read_column(BinaryReader* reader, const DtSceneBinaryHeader* header, DtScene* scene);
+
+/**
+ * @brief string fields of rows copied from file, strings are owned by rows until pool takes them
+ */
+static void patch_strings_clear(const DtComponentData* data, u8* patched,
+                                const DtSceneBinaryColumn* column);
+static void patch_strings_free(const DtComponentData* data, u8* patched,
+                               const DtSceneBinaryColumn* column);
+
+static size_t align_size(const size_t size) {
+    return (size + DT_SCENE_BINARY_ALIGN - 1) & ~(size_t) (DT_SCENE_BINARY_ALIGN - 1);
+}
+
+static const void* reader_take(BinaryReader* reader, const size_t size) {
+    const size_t aligned = align_size(size);
+    if (reader->offset + aligned > reader->size)
+        return NULL;
+
+    const void* ptr = reader->data + reader->offset;
+    reader->offset += aligned;
+    return ptr;
+}
+
+static bool write_section(FILE* file, const void* data, const size_t size) {
+    if (size && fwrite(data, 1, size, file) != size)
+        return false;
+
+    return write_padding(file, size);
+}
+
+static bool write_padding(FILE* file, const size_t size) {
+    static const u8 zeros[DT_SCENE_BINARY_ALIGN] = {0};
+
+    const size_t padding = align_size(size) - size;
+    return padding == 0 || fwrite(zeros, 1, padding, file) == padding;
+}
+
+static bool write_string_field(FILE* file, const char* str) {
+    const u32 length = str ? (u32) strlen(str) : DT_SCENE_BINARY_NULL_STRING;
+
+    if (fwrite(&length, sizeof(u32), 1, file) != 1)
+        return false;
+
+    return !str || length == 0 || fwrite(str, 1, length, file) == length;
+}
+
+static bool is_string_field(const DtComponentData* data, const u16 field) {
+    return strcmp(data->field_types[field], "char*") == 0;
+}
+
+static u16 get_pool_entities(const DtEcsManager* manager, const DtEcsPool* pool,
+                             DtEntity* entities) {
+    if (pool->type == DT_COMPONENT_POOL) {
+        const DtEntityContainer* container = &((const DtComponentPool*) pool->data)->entities;
+        memcpy(entities, container->entities, container->count * sizeof(DtEntity));
+        return container->count;
+    }
+
+    u16 count = 0;
+    for (DtEntity e = 0; e < manager->entities_ptr; e++) {
+        if (manager->sparse_entities[e].alive && dt_ecs_pool_has(pool, e))
+            entities[count++] = e;
+    }
+
+    return count;
+}
+
+static u32 get_column_strings_size(const DtComponentData* data, const DtEcsPool* pool,
+                                   const DtEntity* entities, const u16 count) {
+    u32 size = 0;
+
+    for (u16 f = 0; f < data->field_count; f++) {
+        if (!is_string_field(data, f))
+            continue;
+
+        for (u16 i = 0; i < count; i++) {
+            const char* str =
+                *(char**) ((u8*) dt_ecs_pool_get(pool, entities[i]) + data->field_offsets[f]);
+            size += sizeof(u32) + (str ? (u32) strlen(str) : 0);
+        }
+    }
+
+    return size;
+}
+
+static bool write_column(FILE* file, const DtEcsManager* manager, const DtEcsPool* pool,
+                         DtEntity* entities) {
+    const DtComponentData* data = dt_component_get_data_by_name(pool->name);
+    if (!data)
+        return true;
+
+    const u16 count = get_pool_entities(manager, pool, entities);
+    if (count == 0)
+        return true;
+
+    const u32 component_size = pool->type == DT_COMPONENT_POOL ? (u32) data->component_size : 0;
+
+    const DtSceneBinaryColumn column = {
+        .layout_hash = data->layout_hash,
+        .component_size = component_size,
+        .strings_size = component_size ? get_column_strings_size(data, pool, entities, count) : 0,
+        .count = count,
+        .name_length = (u16) strlen(data->name),
+    };
+
+    if (!write_section(file, &column, sizeof(column)) ||
+        !write_section(file, data->name, column.name_length) ||
+        !write_section(file, entities, count * sizeof(DtEntity)))
+        return false;
+
+    if (component_size == 0)
+        return true;
+
+    u8* rows = DT_MALLOC((size_t) count * component_size);
+    for (u16 i = 0; i < count; i++) {
+        u8* row = rows + (size_t) i * component_size;
+        memcpy(row, dt_ecs_pool_get(pool, entities[i]), component_size);
+
+        for (u16 f = 0; f < data->field_count; f++) {
+            if (is_string_field(data, f))
+                memset(row + data->field_offsets[f], 0, sizeof(char*));
+        }
+    }
+
+    bool ok = write_section(file, rows, (size_t) count * component_size);
+    DT_FREE(rows);
+
+    if (!ok || column.strings_size == 0)
+        return ok;
+
+    for (u16 f = 0; f < data->field_count && ok; f++) {
+        if (!is_string_field(data, f))
+            continue;
+
+        for (u16 i = 0; i < count && ok; i++) {
+            const char* str =
+                *(char**) ((u8*) dt_ecs_pool_get(pool, entities[i]) + data->field_offsets[f]);
+            ok = write_string_field(file, str);
+        }
+    }
+
+    return ok && write_padding(file, column.strings_size);
+}
+
+bool dt_scene_save_binary(const DtScene* scene, const char* path) {
+    const DtEcsManager* manager = scene->manager;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+        return false;
+    }
+
+    u16 column_count = 0;
+    FOREACH(DtEcsPool*, pool, DT_VEC_ITERATOR(manager->pools), {
+        if (pool->count > 0 && dt_component_get_data_by_name(pool->name))
+            column_count++;
+    });
+
+    const DtSceneBinaryHeader header = {
+        .magic = DT_SCENE_BINARY_MAGIC,
+        .version = DT_SCENE_BINARY_VERSION,
+        .entity_count = manager->entities_ptr,
+        .config = dt_ecs_manager_get_config(manager),
+        .update_count = (u16) dt_vec_count(scene->update_handler->names),
+        .draw_count = (u16) dt_vec_count(scene->draw_handler->names),
+        .column_count = column_count,
+    };
+
+    bool ok = write_section(file, &header, sizeof(header));
+
+    size_t names_size = 0;
+    FOREACH(char*, name, DT_VEC_ITERATOR(scene->update_handler->names), {
+        const u16 length = (u16) strlen(name);
+        ok = ok && fwrite(&length, sizeof(u16), 1, file) == 1 &&
+             fwrite(name, 1, length, file) == length;
+        names_size += sizeof(u16) + length;
+    });
+    FOREACH(char*, name, DT_VEC_ITERATOR(scene->draw_handler->names), {
+        const u16 length = (u16) strlen(name);
+        ok = ok && fwrite(&length, sizeof(u16), 1, file) == 1 &&
+             fwrite(name, 1, length, file) == length;
+        names_size += sizeof(u16) + length;
+    });
+    ok = ok && write_padding(file, names_size);
+
+    DtEntity* parents = DT_MALLOC(manager->entities_ptr * sizeof(DtEntity) + 1);
+    u8* alive = DT_MALLOC(manager->entities_ptr + 1);
+    for (DtEntity e = 0; e < manager->entities_ptr; e++) {
+        parents[e] = manager->sparse_entities[e].parent;
+        alive[e] = manager->sparse_entities[e].alive;
+    }
+
+    ok = ok && write_section(file, parents, manager->entities_ptr * sizeof(DtEntity)) &&
+         write_section(file, alive, manager->entities_ptr);
+
+    DT_FREE(parents);
+    DT_FREE(alive);
+
+    DtEntity* entities = DT_MALLOC(manager->entities_ptr * sizeof(DtEntity) + 1);
+    FOREACH(DtEcsPool*, pool, DT_VEC_ITERATOR(manager->pools), {
+        if (ok && pool->count > 0)
+            ok = write_column(file, manager, pool, entities);
+    });
+    DT_FREE(entities);
+
+    fclose(file);
+
+    if (!ok)
+        fprintf(stderr, "[ERROR] Failed to write binary scene %s\n", path);
+
+    return ok;
+}
+
+static bool read_systems(BinaryReader* reader, const DtSceneBinaryHeader* header, DtScene* scene) {
+    scene->update_handler = dt_update_handler_new(scene->manager, header->update_count);
+    scene->draw_handler = dt_draw_handler_new(scene->manager, header->draw_count);
+
+    const size_t start = reader->offset;
+    size_t offset = start;
+    char name[256];
+
+    for (u32 i = 0; i < (u32) header->update_count + header->draw_count; i++) {
+        u16 length;
+        if (offset + sizeof(u16) > reader->size)
+            return false;
+        memcpy(&length, reader->data + offset, sizeof(u16));
+        offset += sizeof(u16);
+
+        if (offset + length > reader->size || length >= sizeof(name))
+            return false;
+        memcpy(name, reader->data + offset, length);
+        name[length] = '\0';
+        offset += length;
+
+        if (i < header->update_count) {
+            const DtUpdateData* data = dt_update_get_data_by_name(name);
+            if (data)
+                dt_update_handler_add(scene->update_handler, data->new(), data->name);
+        } else {
+            const DtDrawData* data = dt_draw_get_data_by_name(name);
+            if (data)
+                dt_draw_handler_add(scene->draw_handler, data->new(), data->name);
+        }
+    }
+
+    return reader_take(reader, offset - start) != NULL;
+}
+
+static bool read_column(BinaryReader* reader, const DtSceneBinaryHeader* header, DtScene* scene) {
+    const DtSceneBinaryColumn* column = reader_take(reader, sizeof(DtSceneBinaryColumn));
+    if (!column)
+        return false;
+
+    const char* name_ptr = reader_take(reader, column->name_length);
+    const DtEntity* entities = reader_take(reader, column->count * sizeof(DtEntity));
+    const u8* rows = reader_take(reader, (size_t) column->count * column->component_size);
+    const u8* strings = reader_take(reader, column->strings_size);
+
+    if (!name_ptr || !entities || !rows || !strings)
+        return false;
+
+    for (u16 i = 0; i < column->count; i++) {
+        if (entities[i] >= header->entity_count)
+            return false;
+    }
+
+    char* name = DT_STACK_ALLOC(column->name_length + 1);
+    memcpy(name, name_ptr, column->name_length);
+    name[column->name_length] = '\0';
+
+    const DtComponentData* data = dt_component_get_data_by_name(name);
+    if (!data) {
+        fprintf(stderr, "[WARNING] binary scene has unknown component %s\n", name);
+        return true;
+    }
+
+    if (data->layout_hash != column->layout_hash) {
+        fprintf(stderr, "[WARNING] layout of %s was changed, column skipped\n", name);
+        return true;
+    }
+
+    DtEcsPool* pool = dt_ecs_manager_get_pool(scene->manager, data->name);
+
+    if (column->component_size == 0) {
+        dt_ecs_pool_add_range(pool, entities, column->count, NULL);
+        return true;
+    }
+
+    if (column->strings_size == 0) {
+        dt_ecs_pool_add_range(pool, entities, column->count, rows);
+        return true;
+    }
+
+    const size_t rows_size = (size_t) column->count * column->component_size;
+    u8* patched = DT_MALLOC(rows_size);
+    memcpy(patched, rows, rows_size);
+
+    // string slots hold file offsets until patched, clear them so failed column can free them
+    patch_strings_clear(data, patched, column);
+
+    size_t offset = 0;
+    bool ok = true;
+    for (u16 f = 0; f < data->field_count && ok; f++) {
+        if (!is_string_field(data, f))
+            continue;
+
+        for (u16 i = 0; i < column->count; i++) {
+            u32 length;
+            if (offset + sizeof(u32) > column->strings_size) {
+                ok = false;
+                break;
+            }
+            memcpy(&length, strings + offset, sizeof(u32));
+            offset += sizeof(u32);
+
+            char* str = NULL;
+            if (length != DT_SCENE_BINARY_NULL_STRING) {
+                if (offset + length > column->strings_size) {
+                    ok = false;
+                    break;
+                }
+                str = DT_MALLOC(length + 1);
+                memcpy(str, strings + offset, length);
+                str[length] = '\0';
+                offset += length;
+            }
+
+            memcpy(patched + (size_t) i * column->component_size + data->field_offsets[f], &str,
+                   sizeof(char*));
+        }
+    }
+
+    if (ok)
+        dt_ecs_pool_add_range(pool, entities, column->count, patched);
+    else
+        patch_strings_free(data, patched, column);
+
+    DT_FREE(patched);
+    return ok;
+}
+
+static void patch_strings_clear(const DtComponentData* data, u8* patched,
+                                const DtSceneBinaryColumn* column) {
+    for (u16 f = 0; f < data->field_count; f++) {
+        if (!is_string_field(data, f))
+            continue;
+
+        for (u16 i = 0; i < column->count; i++)
+            memset(patched + (size_t) i * column->component_size + data->field_offsets[f], 0,
+                   sizeof(char*));
+    }
+}
+
+static void patch_strings_free(const DtComponentData* data, u8* patched,
+                               const DtSceneBinaryColumn* column) {
+    for (u16 f = 0; f < data->field_count; f++) {
+        if (!is_string_field(data, f))
+            continue;
+
+        for (u16 i = 0; i < column->count; i++) {
+            char* str;
+            memcpy(&str, patched + (size_t) i * column->component_size + data->field_offsets[f],
+                   sizeof(char*));
+            DT_FREE(str);
+        }
+    }
+}
+
+DtScene* dt_scene_parse_binary(const char* path, DtEnvironment* env) {
+    DtMappedFile file;
+    if (!dt_file_map(path, &file))
+        return NULL;
+
+    BinaryReader reader = {
+        .data = file.data,
+        .size = file.size,
+        .offset = 0,
+    };
+
+    const DtSceneBinaryHeader* header = reader_take(&reader, sizeof(DtSceneBinaryHeader));
+    if (!header || header->magic != DT_SCENE_BINARY_MAGIC ||
+        header->version != DT_SCENE_BINARY_VERSION) {
+        fprintf(stderr, "[ERROR] file hasn't binary scene data %s\n", path);
+        dt_file_unmap(&file);
+        return NULL;
+    }
+
+    DtScene* scene = DT_MALLOC(sizeof(DtScene));
+    *scene = (DtScene) {
+        .environment = env,
+        .manager = dt_ecs_manager_new(header->config),
+    };
+
+    bool ok = read_systems(&reader, header, scene);
+
+    const DtEntity* parents = ok ? reader_take(&reader, header->entity_count * sizeof(DtEntity))
+                                 : NULL;
+    const u8* alive = parents ? reader_take(&reader, header->entity_count) : NULL;
+    ok = ok && alive;
+
+    if (ok) {
+        for (u32 i = 0; i < header->entity_count; i++)
+            dt_ecs_manager_new_entity(scene->manager);
+
+        for (u16 i = 0; i < header->column_count && ok; i++)
+            ok = read_column(&reader, header, scene);
+
+        for (DtEntity e = 0; e < header->entity_count && ok; e++) {
+            if (parents[e] != DT_ENTITY_NULL)
+                dt_ecs_manager_set_parent(scene->manager, e, parents[e]);
+        }
+
+        for (DtEntity e = 0; e < header->entity_count && ok; e++) {
+            if (!alive[e])
+                dt_ecs_manager_kill_entity(scene->manager, e);
+        }
+    }
+
+    dt_file_unmap(&file);
+
+    if (!ok) {
+        fprintf(stderr, "[ERROR] binary scene is corrupted %s\n", path);
+        dt_update_handler_free(scene->update_handler);
+        dt_draw_handler_free(scene->draw_handler);
+        dt_ecs_manager_free(scene->manager);
+        DT_FREE(scene);
+        return NULL;
+    }
+
+    return scene;
+}
@@ -1,20 +1,67 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
 #include <cjson/cJSON.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "Collections/Collections.h"
 #include "DtAllocators.h"
+#include "Profiling/DtTrace.h"
 #include "scheduler/RuntimeScheduler.h"
 
 
 #define SCENE_EXTENSION ".dt.scene"
+#define BINARY_SCENE_EXTENSION ".dt.bscene"
+
+#define SCENE_ARENA_BLOCK_SIZE 4096
+#define SCENE_PATH_MAX_LENGTH 512
+#define SCENE_NUMBER_MAX_LENGTH 64
+
+/**
+ * @brief cursor over scene json, values are read straight from source
+ * without building cJSON tree, transient strings live in arena
+ */
+typedef struct {
+    const char* src;
+    size_t size;
+    size_t pos;
+    bool failed;
+
+    DtArena* arena;
+} SceneReader;
+
+typedef struct {
+    DtEntity child;
+    DtEntity parent;
+} SceneParentLink;
 
 static DtScene* dt_scene_parse(const char* path, DtEnvironment* env);
-static DtScene* dt_scene_parse_from_json(const char* scene_info, DtEnvironment* env);
-static void dt_scene_parse_ecs_manager(cJSON* json_cfg, DtScene* scene);
-static void dt_scene_parse_update_systems(cJSON* systems, DtScene* scene);
-static void dt_scene_parse_draw_systems(cJSON* systems, DtScene* scene);
-static void dt_scene_parse_entities(cJSON* entities, DtScene* scene);
+static DtScene* dt_scene_parse_from_json(const char* scene_info, size_t size, DtEnvironment* env);
+static void dt_scene_ensure_manager(DtScene* scene);
+static void dt_scene_parse_ecs_manager(SceneReader* reader, DtScene* scene);
+static void dt_scene_parse_update_systems(SceneReader* reader, DtScene* scene);
+static void dt_scene_parse_draw_systems(SceneReader* reader, DtScene* scene);
+static void dt_scene_parse_entities(SceneReader* reader, DtScene* scene,
+                                    DT_VEC(SceneParentLink) * links);
+static void dt_scene_parse_component(SceneReader* reader, DtScene* scene, DtEntity entity);
+static void dt_scene_parse_values(SceneReader* reader, const DtComponentData* data,
+                                  void* instance);
+
+static void reader_fail(SceneReader* reader);
+static void reader_skip_ws(SceneReader* reader);
+static char reader_peek(SceneReader* reader);
+static bool reader_consume(SceneReader* reader, char c);
+static bool reader_expect(SceneReader* reader, char c);
+static const char* reader_object_next(SceneReader* reader, bool* first);
+static bool reader_array_next(SceneReader* reader, bool* first);
+static u32 reader_read_hex(SceneReader* reader);
+static char* reader_read_string(SceneReader* reader);
+static double reader_read_number(SceneReader* reader);
+static bool reader_read_literal(SceneReader* reader, const char* literal);
+static void reader_skip_value(SceneReader* reader);
+static void reader_link_node(cJSON* parent, cJSON* child);
+static cJSON* reader_read_node(SceneReader* reader);
 
 static u64 get_scene_hash(const char* name) {
     int hash = 2147483647;
@@ -25,34 +72,92 @@ static u64 get_scene_hash(const char* name) {
     return hash;
 }
 
-static int is_scene(const char* filename) {
+static int has_extension(const char* filename, const char* extension) {
     const size_t len_filename = strlen(filename);
-    const size_t len_ext = strlen(SCENE_EXTENSION);
+    const size_t len_ext = strlen(extension);
 
     if (len_filename < len_ext)
         return 0;
-    return strcmp(filename + len_filename - len_ext, SCENE_EXTENSION) == 0;
+    return strcmp(filename + len_filename - len_ext, extension) == 0;
+}
+
+/**
+ * @brief return length of scene extension or 0 if file is not a scene
+ */
+static size_t is_scene(const char* filename) {
+    if (has_extension(filename, SCENE_EXTENSION))
+        return strlen(SCENE_EXTENSION);
+    if (has_extension(filename, BINARY_SCENE_EXTENSION))
+        return strlen(BINARY_SCENE_EXTENSION);
+    return 0;
+}
+
+void dt_add_scenes(const char* directory) {
+    DT_TRACE_FUNCTION();
+    char path[SCENE_PATH_MAX_LENGTH];
+
+#ifdef _WIN32
+    char pattern[SCENE_PATH_MAX_LENGTH];
+    snprintf(pattern, sizeof(pattern), "%s\\*", directory);
+
+    WIN32_FIND_DATAA entry;
+    const HANDLE find = FindFirstFileA(pattern, &entry);
+    if (find == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "[DEBUG] Can't open scenes directory: %s\n", directory);
+        return;
+    }
+
+    do {
+        if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY || !is_scene(entry.cFileName))
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s", directory, entry.cFileName);
+        dt_add_scene(path);
+    } while (FindNextFileA(find, &entry));
+
+    FindClose(find);
+#else
+    DIR* dir = opendir(directory);
+    if (!dir) {
+        fprintf(stderr, "[DEBUG] Can't open scenes directory: %s\n", directory);
+        return;
+    }
+
+    const struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_type == DT_DIR || !is_scene(entry->d_name))
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+        dt_add_scene(path);
+    }
+
+    closedir(dir);
+#endif /*_WIN32*/
 }
 
 const DtScene* dt_add_scene(const char* path) {
+    DT_TRACE_FUNCTION();
     DtEnvironment* env = dt_environment_instance();
-    if (!is_scene(path)) {
+    const size_t len_ext = is_scene(path);
+    if (!len_ext) {
         fprintf(stderr, "[DEBUG] File is not a scene or doesn't exist: %s\n", path);
         return NULL;
     }
 
-    char* file_name = strrchr(path, '/') + 1;
-    if (file_name == NULL)
-        file_name = path;
+    const char* slash = strrchr(path, '/');
+    const char* file_name = slash ? slash + 1 : path;
 #if defined(_WIN32) || defined(_WIN64)
-    char* win_file_name = strrchr(path, '\\');
-    if (win_file_name != NULL)
-        file_name = win_file_name;
+    const char* win_file_name = strrchr(path, '\\');
+    if (win_file_name != NULL && win_file_name + 1 > file_name)
+        file_name = win_file_name + 1;
 #endif
 
-    size_t len = strlen(file_name) - strlen(SCENE_EXTENSION);
+    size_t len = strlen(file_name) - len_ext;
 
-    DtScene* scene = dt_scene_parse(path, env);
+    DtScene* scene = has_extension(path, BINARY_SCENE_EXTENSION)
+                         ? dt_scene_parse_binary(path, env)
+                         : dt_scene_parse(path, env);
     if (!scene) {
         fprintf(stderr, "[DEBUG] Failed to parse scene: %s\n", path);
         return NULL;
@@ -64,14 +169,17 @@ const DtScene* dt_add_scene(const char* path) {
 
     scene->name = name;
 
+    pthread_mutex_lock(&env->scenes_lock);
     dt_rb_tree_add(&env->scenes, scene, get_scene_hash(name));
+    pthread_mutex_unlock(&env->scenes_lock);
 
     return scene;
 }
 
 const DtScene* dt_add_scene_from_json(const char* json, const char* name) {
+    DT_TRACE_FUNCTION();
     DtEnvironment* env = dt_environment_instance();
-    DtScene* scene = dt_scene_parse_from_json(json, env);
+    DtScene* scene = dt_scene_parse_from_json(json, strlen(json), env);
     if (!scene) {
         fprintf(stderr, "[DEBUG] Failed to parse scene: %s\n", "from source");
         return NULL;
@@ -79,60 +187,66 @@ const DtScene* dt_add_scene_from_json(const char* json, const char* name) {
 
     char* name_copy = strdup(name);
     scene->name = name_copy;
+    pthread_mutex_lock(&env->scenes_lock);
     dt_rb_tree_add(&env->scenes, scene, get_scene_hash(name));
+    pthread_mutex_unlock(&env->scenes_lock);
 
     return scene;
 }
 
-static DtScene* dt_scene_parse(const char* path, DtEnvironment* env) {
-    FILE* file = fopen(path, "rb");
+DtPrefab* dt_prefab_load(const char* path) {
+    if (!is_scene(path)) {
+        fprintf(stderr, "[DEBUG] File is not a scene or doesn't exist: %s\n", path);
+        return NULL;
+    }
 
-    if (file == NULL) {
-        fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+    DtEnvironment* env = dt_environment_instance();
+    DtScene* scene = has_extension(path, BINARY_SCENE_EXTENSION)
+                         ? dt_scene_parse_binary(path, env)
+                         : dt_scene_parse(path, env);
+    if (!scene) {
+        fprintf(stderr, "[DEBUG] Failed to parse prefab: %s\n", path);
         return NULL;
     }
 
-    fseek(file, 0, SEEK_END);
+    DtPrefab* prefab = dt_prefab_from_manager(scene->manager);
 
-    i32 size = (i32) ftell(file);
-    fseek(file, 0, SEEK_SET);
+    dt_update_handler_free(scene->update_handler);
+    dt_draw_handler_free(scene->draw_handler);
+    dt_ecs_manager_free(scene->manager);
+    DT_FREE(scene);
 
-    char* scene_info = DT_MALLOC(size + 1);
-    fread(scene_info, 1, size, file);
+    return prefab;
+}
 
-    cJSON* root = cJSON_Parse(scene_info);
-    if (root == NULL) {
-        fprintf(stderr, "[ERROR] file hasn't scene data%s\n", path);
+static DtScene* dt_scene_parse(const char* path, DtEnvironment* env) {
+    DtMappedFile file;
+    if (!dt_file_map(path, &file))
         return NULL;
-    }
-
-    cJSON* manager_config = cJSON_GetObjectItem(root, "manager_config");
-    cJSON* update_systems = cJSON_GetObjectItem(root, "update_systems");
-    cJSON* draw_systems = cJSON_GetObjectItem(root, "draw_systems");
-    cJSON* entities = cJSON_GetObjectItem(root, "entities");
-
-#ifdef DEBUG
-    if (!manager_config) {
-        fprintf(stderr, "[WARNING] file hasn't manager_config data%s\n", path);
-    }
 
-    if (!update_systems) {
-        fprintf(stderr, "[WARNING] file hasn't update_systems data%s\n", path);
-    }
+    DtScene* scene = dt_scene_parse_from_json(file.data, file.size, env);
+    if (!scene)
+        fprintf(stderr, "[ERROR] file hasn't scene data %s\n", path);
 
-    if (!draw_systems) {
-        fprintf(stderr, "[WARNING] file hasn't draw_systems data%s\n", path);
-    }
+    dt_file_unmap(&file);
+    return scene;
+}
 
-    if (!entities) {
-        fprintf(stderr, "[WARNING] file hasn't entities data%s\n", path);
-    }
-#endif
+static DtScene* dt_scene_parse_from_json(const char* scene_info, const size_t size,
+                                         DtEnvironment* env) {
+    DtArena arena = dt_arena_new(SCENE_ARENA_BLOCK_SIZE);
+    SceneReader reader = {
+        .src = scene_info,
+        .size = size,
+        .pos = 0,
+        .failed = false,
+        .arena = &arena,
+    };
 
     DtScene* scene = DT_MALLOC(sizeof(DtScene));
 
     if (scene == NULL) {
-        fprintf(stderr, "[error] didn't manage to allocate memory for scene%s\n", path);
+        fprintf(stderr, "[error] didn't manage to allocate memory for scene\n");
         return NULL;
     }
 
@@ -140,190 +254,596 @@ static DtScene* dt_scene_parse(const char* path, DtEnvironment* env) {
         .environment = env,
     };
 
-    dt_scene_parse_ecs_manager(manager_config, scene);
-    dt_scene_parse_update_systems(update_systems, scene);
-    dt_scene_parse_draw_systems(draw_systems, scene);
-    dt_scene_parse_entities(entities, scene);
+    DT_VEC(SceneParentLink) links = DT_VEC_NEW(SceneParentLink, 0);
+
+    reader_expect(&reader, '{');
+
+    bool first = true;
+    const char* key;
+    while ((key = reader_object_next(&reader, &first))) {
+        if (strcmp(key, "manager_config") == 0 && !scene->manager) {
+            dt_scene_parse_ecs_manager(&reader, scene);
+        } else if (strcmp(key, "update_systems") == 0 && !scene->update_handler) {
+            dt_scene_ensure_manager(scene);
+            dt_scene_parse_update_systems(&reader, scene);
+        } else if (strcmp(key, "draw_systems") == 0 && !scene->draw_handler) {
+            dt_scene_ensure_manager(scene);
+            dt_scene_parse_draw_systems(&reader, scene);
+        } else if (strcmp(key, "entities") == 0) {
+            dt_scene_ensure_manager(scene);
+            dt_scene_parse_entities(&reader, scene, &links);
+        } else {
+            reader_skip_value(&reader);
+        }
+    }
 
+    dt_scene_ensure_manager(scene);
+    if (!scene->update_handler)
+        scene->update_handler = dt_update_handler_new(scene->manager, 0);
+    if (!scene->draw_handler)
+        scene->draw_handler = dt_draw_handler_new(scene->manager, 0);
+
+    FOREACH(SceneParentLink, link, DT_VEC_ITERATOR(links),
+            { dt_ecs_manager_set_parent(scene->manager, link.child, link.parent); });
+
+    dt_vec_free(links);
+    dt_arena_free(&arena);
+
+    if (reader.failed) {
+        fprintf(stderr, "[ERROR] scene json is broken at %zu\n", reader.pos);
+        dt_update_handler_free(scene->update_handler);
+        dt_draw_handler_free(scene->draw_handler);
+        dt_ecs_manager_free(scene->manager);
+        DT_FREE(scene);
+        return NULL;
+    }
 
-    fclose(file);
-    free(scene_info);
     return scene;
 }
 
-static DtScene* dt_scene_parse_from_json(const char* scene_info, DtEnvironment* env) {
-    cJSON* root = cJSON_Parse(scene_info);
-    if (root == NULL) {
-        fprintf(stderr, "[ERROR] file hasn't scene data%s\n", "from source");
-        return NULL;
+static void dt_scene_ensure_manager(DtScene* scene) {
+    if (!scene->manager)
+        scene->manager = dt_ecs_manager_new((DtEcsManagerConfig) {0});
+}
+
+static void dt_scene_parse_ecs_manager(SceneReader* reader, DtScene* scene) {
+    DtEcsManagerConfig cfg = {0};
+
+#define READ_CFG_FIELD(key, field)                                                                 \
+    if (strcmp(key, #field) == 0) {                                                                \
+        cfg.field = (int) reader_read_number(reader);                                              \
+        continue;                                                                                  \
+    }
+
+    reader_expect(reader, '{');
+
+    bool first = true;
+    const char* key;
+    while ((key = reader_object_next(reader, &first))) {
+        READ_CFG_FIELD(key, dense_size);
+        READ_CFG_FIELD(key, sparse_size);
+        READ_CFG_FIELD(key, recycle_size);
+        READ_CFG_FIELD(key, children_size);
+        READ_CFG_FIELD(key, components_count);
+        READ_CFG_FIELD(key, pools_size);
+        READ_CFG_FIELD(key, include_mask_count);
+        READ_CFG_FIELD(key, exclude_mask_count);
+        READ_CFG_FIELD(key, filters_size);
+        READ_CFG_FIELD(key, masks_size);
+
+        reader_skip_value(reader);
     }
 
-    cJSON* manager_config = cJSON_GetObjectItem(root, "manager_config");
-    cJSON* update_systems = cJSON_GetObjectItem(root, "update_systems");
-    cJSON* draw_systems = cJSON_GetObjectItem(root, "draw_systems");
-    cJSON* entities = cJSON_GetObjectItem(root, "entities");
+#undef READ_CFG_FIELD
 
-#ifdef DEBUG
-    if (!manager_config) {
-        fprintf(stderr, "[WARNING] file hasn't manager_config data%s\n", "from source");
+    scene->manager = dt_ecs_manager_new(cfg);
+}
+
+static void dt_scene_parse_update_systems(SceneReader* reader, DtScene* scene) {
+    scene->update_handler = dt_update_handler_new(scene->manager, 0);
+
+    const DtArenaMark mark = dt_arena_mark(reader->arena);
+    reader_expect(reader, '[');
+
+    bool first = true;
+    while (reader_array_next(reader, &first)) {
+        const DtUpdateData* data = NULL;
+        const char* name = reader_read_string(reader);
+        if (name && (data = dt_update_get_data_by_name(name))) {
+            dt_update_handler_add(scene->update_handler, data->new(), data->name);
+        }
     }
 
-    if (!update_systems) {
-        fprintf(stderr, "[WARNING] file hasn't update_systems data%s\n", "from source");
+    dt_arena_reset_to(reader->arena, mark);
+}
+
+static void dt_scene_parse_draw_systems(SceneReader* reader, DtScene* scene) {
+    scene->draw_handler = dt_draw_handler_new(scene->manager, 0);
+
+    const DtArenaMark mark = dt_arena_mark(reader->arena);
+    reader_expect(reader, '[');
+
+    bool first = true;
+    while (reader_array_next(reader, &first)) {
+        const DtDrawData* data = NULL;
+        const char* name = reader_read_string(reader);
+        if (name && (data = dt_draw_get_data_by_name(name))) {
+            dt_draw_handler_add(scene->draw_handler, data->new(), data->name);
+        }
     }
 
-    if (!draw_systems) {
-        fprintf(stderr, "[WARNING] file hasn't draw_systems data%s\n", "from source");
+    dt_arena_reset_to(reader->arena, mark);
+}
+
+static void dt_scene_parse_entities(SceneReader* reader, DtScene* scene,
+                                    DT_VEC(SceneParentLink) * links) {
+    const DtArenaMark mark = dt_arena_mark(reader->arena);
+    reader_expect(reader, '{');
+
+    bool first = true;
+    const char* key;
+    while ((key = reader_object_next(reader, &first))) {
+        const DtEntity id = (DtEntity) atoi(key);
+        const DtEntity entity = dt_ecs_manager_new_entity(scene->manager);
+
+        reader_expect(reader, '{');
+
+        bool first_field = true;
+        const char* field;
+        while ((field = reader_object_next(reader, &first_field))) {
+            if (strcmp(field, "components") == 0) {
+                reader_expect(reader, '[');
+
+                bool first_component = true;
+                while (reader_array_next(reader, &first_component)) {
+                    if (reader_peek(reader) == '"') {
+                        const char* name = reader_read_string(reader);
+                        if (name)
+                            dt_ecs_manager_entity_add_component(scene->manager, entity, name, NULL);
+                    } else {
+                        dt_scene_parse_component(reader, scene, entity);
+                    }
+                }
+            } else if (strcmp(field, "parent") == 0) {
+                SceneParentLink link = {
+                    .child = id,
+                    .parent = (DtEntity) reader_read_number(reader),
+                };
+                DT_VEC_ADD(*links, link);
+            } else {
+                reader_skip_value(reader);
+            }
+        }
+
+        dt_arena_reset_to(reader->arena, mark);
     }
+}
 
-    if (!entities) {
-        fprintf(stderr, "[WARNING] file hasn't entities data%s\n", "from source");
+static void dt_scene_parse_component(SceneReader* reader, DtScene* scene, const DtEntity entity) {
+    const char* name = NULL;
+    size_t values_pos = 0;
+
+    reader_expect(reader, '{');
+
+    bool first = true;
+    const char* key;
+    while ((key = reader_object_next(reader, &first))) {
+        if (strcmp(key, "name") == 0) {
+            name = reader_read_string(reader);
+        } else if (strcmp(key, "values") == 0) {
+            reader_skip_ws(reader);
+            values_pos = reader->pos;
+            reader_skip_value(reader);
+        } else {
+            reader_skip_value(reader);
+        }
     }
-#endif
 
-    DtScene* scene = DT_MALLOC(sizeof(DtScene));
+    if (!name || reader->failed)
+        return;
 
-    if (scene == NULL) {
-        fprintf(stderr, "[error] didn't manage to allocate memory for scene%s\n", "from source");
+    const DtComponentData* data = dt_component_get_data_by_name(name);
+    if (data == NULL)
+        return;
+
+    void* instance = NULL;
+    if (values_pos) {
+        instance = dt_arena_alloc(reader->arena, data->component_size);
+        memset(instance, 0, data->component_size);
+
+        const size_t end_pos = reader->pos;
+        reader->pos = values_pos;
+        dt_scene_parse_values(reader, data, instance);
+        reader->pos = end_pos;
+    }
+
+    dt_ecs_manager_entity_add_component(scene->manager, entity, name, instance);
+}
+
+static void dt_scene_parse_values(SceneReader* reader, const DtComponentData* data,
+                                  void* instance) {
+    const DtFieldPlan* plans = dt_component_get_plans(data);
+
+    reader_expect(reader, '{');
+
+    bool first = true;
+    const char* key;
+    while ((key = reader_object_next(reader, &first))) {
+        const i32 i = dt_component_get_field_index(data, key);
+        if (i == -1) {
+            reader_skip_value(reader);
+            continue;
+        }
+
+        const DtArenaMark mark = dt_arena_mark(reader->arena);
+        cJSON* value = reader_read_node(reader);
+        if (value && plans[i].parse)
+            plans[i].parse(value, (u8*) instance + plans[i].offset);
+        else if (value)
+            dt_parse_json_to_type(data->field_types[i], value, (u8*) instance + plans[i].offset);
+        dt_arena_reset_to(reader->arena, mark);
+    }
+}
+
+static void reader_fail(SceneReader* reader) { reader->failed = true; }
+
+static void reader_skip_ws(SceneReader* reader) {
+    while (reader->pos < reader->size) {
+        const char c = reader->src[reader->pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            return;
+        reader->pos++;
+    }
+}
+
+static char reader_peek(SceneReader* reader) {
+    reader_skip_ws(reader);
+    return reader->pos < reader->size && !reader->failed ? reader->src[reader->pos] : '\0';
+}
+
+static bool reader_consume(SceneReader* reader, const char c) {
+    if (reader_peek(reader) != c)
+        return false;
+
+    reader->pos++;
+    return true;
+}
+
+static bool reader_expect(SceneReader* reader, const char c) {
+    if (reader_consume(reader, c))
+        return true;
+
+    reader_fail(reader);
+    return false;
+}
+
+static const char* reader_object_next(SceneReader* reader, bool* first) {
+    if (reader->failed)
+        return NULL;
+
+    if (*first) {
+        *first = false;
+        if (reader_consume(reader, '}'))
+            return NULL;
+    } else if (!reader_consume(reader, ',')) {
+        reader_expect(reader, '}');
         return NULL;
     }
 
-    *scene = (DtScene) {
-        .environment = env,
-    };
+    const char* key = reader_read_string(reader);
+    if (!key || !reader_expect(reader, ':'))
+        return NULL;
+
+    return key;
+}
 
-    dt_scene_parse_ecs_manager(manager_config, scene);
-    dt_scene_parse_update_systems(update_systems, scene);
-    dt_scene_parse_draw_systems(draw_systems, scene);
-    dt_scene_parse_entities(entities, scene);
+static bool reader_array_next(SceneReader* reader, bool* first) {
+    if (reader->failed)
+        return false;
 
-    return scene;
+    if (*first) {
+        *first = false;
+        return !reader_consume(reader, ']');
+    }
+
+    if (reader_consume(reader, ','))
+        return true;
+
+    reader_expect(reader, ']');
+    return false;
 }
 
-static void dt_scene_parse_ecs_manager(cJSON* json_cfg, DtScene* scene) {
-    if (!json_cfg) {
-        scene->manager = dt_ecs_manager_new((DtEcsManagerConfig){0});
-        return;
+static u32 reader_read_hex(SceneReader* reader) {
+    if (reader->pos + 4 > reader->size) {
+        reader_fail(reader);
+        return 0;
     }
 
-    DtEcsManagerConfig cfg;
-
-#define GET_JSON_INT(json, field)                                                                  \
-    ({                                                                                             \
-        cJSON* item = cJSON_GetObjectItem(json, #field);                                           \
-        if (item) {                                                                                \
-            cfg.field = (int) cJSON_GetNumberValue(item);                                          \
-        } else {                                                                                   \
-            fprintf(stderr, "[WARNING] Scene hasn't \"" #field "\" data\n");                        \
-            cfg.field = 0;                                                                         \
-        }                                                                                          \
-    })
-
-    GET_JSON_INT(json_cfg, dense_size);
-    GET_JSON_INT(json_cfg, sparse_size);
-    GET_JSON_INT(json_cfg, recycle_size);
-    GET_JSON_INT(json_cfg, children_size);
-    GET_JSON_INT(json_cfg, components_count);
-    GET_JSON_INT(json_cfg, pools_size);
-    GET_JSON_INT(json_cfg, include_mask_count);
-    GET_JSON_INT(json_cfg, exclude_mask_count);
-    GET_JSON_INT(json_cfg, filters_size);
-    GET_JSON_INT(json_cfg, masks_size);
-
-#undef GET_JSON_INT
+    u32 code = 0;
+    for (int i = 0; i < 4; i++) {
+        const char c = reader->src[reader->pos++];
+        code <<= 4;
+        if (c >= '0' && c <= '9')
+            code |= c - '0';
+        else if (c >= 'a' && c <= 'f')
+            code |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            code |= c - 'A' + 10;
+        else
+            reader_fail(reader);
+    }
 
-    scene->manager = dt_ecs_manager_new(cfg);
+    return code;
 }
 
-static void dt_scene_parse_update_systems(cJSON* systems, DtScene* scene) {
-    if (!systems) {
-        scene->update_handler = dt_update_handler_new(scene->manager, 0);
-        return;
+static char* reader_read_string(SceneReader* reader) {
+    if (!reader_expect(reader, '"'))
+        return NULL;
+
+    const size_t start = reader->pos;
+    bool escaped = false;
+    while (reader->pos < reader->size && reader->src[reader->pos] != '"') {
+        if (reader->src[reader->pos] == '\\') {
+            escaped = true;
+            reader->pos++;
+        }
+        reader->pos++;
     }
 
-    u16 count = cJSON_GetArraySize(systems);
+    if (reader->pos >= reader->size) {
+        reader_fail(reader);
+        return NULL;
+    }
 
-    scene->update_handler = dt_update_handler_new(scene->manager, count);
-    cJSON* system = NULL;
-    cJSON_ArrayForEach(system, systems) {
-        const DtUpdateData* data = NULL;
-        const char* name = cJSON_GetStringValue(system);
-        if ((data = dt_update_get_data_by_name(name))) {
-            dt_update_handler_add(scene->update_handler, data->new(), data->name);
+    const size_t end = reader->pos++;
+    if (!escaped)
+        return dt_arena_strndup(reader->arena, reader->src + start, end - start);
+
+    /* escaped string is never longer than its source */
+    char* str = dt_arena_alloc(reader->arena, end - start + 1);
+    size_t len = 0;
+    const size_t resume = reader->pos;
+
+    reader->pos = start;
+    while (reader->pos < end) {
+        const char c = reader->src[reader->pos++];
+        if (c != '\\') {
+            str[len++] = c;
+            continue;
+        }
+
+        const char e = reader->src[reader->pos++];
+        switch (e) {
+            case 'b':
+                str[len++] = '\b';
+                break;
+            case 'f':
+                str[len++] = '\f';
+                break;
+            case 'n':
+                str[len++] = '\n';
+                break;
+            case 'r':
+                str[len++] = '\r';
+                break;
+            case 't':
+                str[len++] = '\t';
+                break;
+            case 'u': {
+                u32 code = reader_read_hex(reader);
+                if (code >= 0xD800 && code <= 0xDBFF && reader->pos + 6 <= end &&
+                    reader->src[reader->pos] == '\\' && reader->src[reader->pos + 1] == 'u') {
+                    reader->pos += 2;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (reader_read_hex(reader) - 0xDC00);
+                }
+
+                if (code < 0x80) {
+                    str[len++] = (char) code;
+                } else if (code < 0x800) {
+                    str[len++] = (char) (0xC0 | code >> 6);
+                    str[len++] = (char) (0x80 | (code & 0x3F));
+                } else if (code < 0x10000) {
+                    str[len++] = (char) (0xE0 | code >> 12);
+                    str[len++] = (char) (0x80 | (code >> 6 & 0x3F));
+                    str[len++] = (char) (0x80 | (code & 0x3F));
+                } else {
+                    str[len++] = (char) (0xF0 | code >> 18);
+                    str[len++] = (char) (0x80 | (code >> 12 & 0x3F));
+                    str[len++] = (char) (0x80 | (code >> 6 & 0x3F));
+                    str[len++] = (char) (0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                str[len++] = e;
+                break;
         }
     }
+
+    str[len] = '\0';
+    reader->pos = resume;
+
+    return str;
 }
 
-static void dt_scene_parse_draw_systems(cJSON* systems, DtScene* scene) {
-    if (!systems) {
-        scene->draw_handler = dt_draw_handler_new(scene->manager, 0);
-        return;
+static double reader_read_number(SceneReader* reader) {
+    reader_skip_ws(reader);
+
+    char buffer[SCENE_NUMBER_MAX_LENGTH];
+    size_t len = 0;
+    while (reader->pos < reader->size && len < sizeof(buffer) - 1) {
+        const char c = reader->src[reader->pos];
+        if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E')
+            break;
+        buffer[len++] = c;
+        reader->pos++;
     }
-    u16 count = cJSON_GetArraySize(systems);
+    buffer[len] = '\0';
 
-    scene->draw_handler = dt_draw_handler_new(scene->manager, count);
-    cJSON* system = NULL;
-    cJSON_ArrayForEach(system, systems) {
-        const DtDrawData* data = NULL;
-        const char* name = cJSON_GetStringValue(system);
-        if ((data = dt_draw_get_data_by_name(name))) {
-            dt_draw_handler_add(scene->draw_handler, data->new(), data->name);
+    char* end;
+    const double number = strtod(buffer, &end);
+    if (len == 0 || end != buffer + len)
+        reader_fail(reader);
+
+    return number;
+}
+
+static bool reader_read_literal(SceneReader* reader, const char* literal) {
+    const size_t len = strlen(literal);
+    if (reader->pos + len > reader->size || strncmp(reader->src + reader->pos, literal, len) != 0) {
+        reader_fail(reader);
+        return false;
+    }
+
+    reader->pos += len;
+    return true;
+}
+
+static void reader_skip_value(SceneReader* reader) {
+    const DtArenaMark mark = dt_arena_mark(reader->arena);
+
+    switch (reader_peek(reader)) {
+        case '{': {
+            reader->pos++;
+            bool first = true;
+            while (reader_object_next(reader, &first))
+                reader_skip_value(reader);
+            break;
+        }
+        case '[': {
+            reader->pos++;
+            bool first = true;
+            while (reader_array_next(reader, &first))
+                reader_skip_value(reader);
+            break;
         }
+        case '"':
+            reader_read_string(reader);
+            break;
+        case 't':
+            reader_read_literal(reader, "true");
+            break;
+        case 'f':
+            reader_read_literal(reader, "false");
+            break;
+        case 'n':
+            reader_read_literal(reader, "null");
+            break;
+        default:
+            reader_read_number(reader);
+            break;
     }
+
+    dt_arena_reset_to(reader->arena, mark);
 }
 
-static void dt_scene_parse_entities(cJSON* entities, DtScene* scene) {
-    if (!entities)
-        return;
-    const cJSON* json_entity = NULL;
-    cJSON_ArrayForEach(json_entity, entities) {
-        const cJSON* components = cJSON_GetObjectItem(json_entity, "components");
+static void reader_link_node(cJSON* parent, cJSON* child) {
+    if (!parent->child) {
+        parent->child = child;
+    } else {
+        cJSON* last = parent->child->prev;
+        last->next = child;
+        child->prev = last;
+    }
 
-        const DtEntity entity = dt_ecs_manager_new_entity(scene->manager);
-        const cJSON* component = NULL;
-        cJSON_ArrayForEach(component, components) {
-            if (cJSON_IsString(component)) {
-                dt_ecs_manager_entity_add_component(scene->manager, entity,
-                                                    cJSON_GetStringValue(component), NULL);
-            } else {
-                const char* name = cJSON_GetStringValue(cJSON_GetObjectItem(component, "name"));
-                const cJSON* values = cJSON_GetObjectItem(component, "values");
-                const DtComponentData* data = dt_component_get_data_by_name(name);
-                if (data == NULL) continue;
-                void* instance = DT_STACK_ALLOC(data->component_size);
-
-                cJSON* value = NULL;
-                cJSON_ArrayForEach(value, values) {
-                    const char* field_name = value->string;
-                    const i32 i = dt_component_get_field_index(data, field_name);
-                    if (i == -1)
-                        continue;
-
-                    u16 offset = data->field_offsets[i];
-                    const char* type = data->field_types[i];
-
-                    dt_parse_json_to_type(type, value, (u8*) instance + offset);
-                }
-                dt_ecs_manager_entity_add_component(scene->manager, entity, name, instance);
+    parent->child->prev = child;
+}
+
+static cJSON* reader_read_node(SceneReader* reader) {
+    cJSON* node = dt_arena_alloc(reader->arena, sizeof(cJSON));
+    memset(node, 0, sizeof(cJSON));
+
+    switch (reader_peek(reader)) {
+        case '{': {
+            reader->pos++;
+            node->type = cJSON_Object;
+
+            bool first = true;
+            char* key;
+            while ((key = (char*) reader_object_next(reader, &first))) {
+                cJSON* child = reader_read_node(reader);
+                if (!child)
+                    return NULL;
+                child->string = key;
+                reader_link_node(node, child);
+            }
+            break;
+        }
+        case '[': {
+            reader->pos++;
+            node->type = cJSON_Array;
+
+            bool first = true;
+            while (reader_array_next(reader, &first)) {
+                cJSON* child = reader_read_node(reader);
+                if (!child)
+                    return NULL;
+                reader_link_node(node, child);
             }
+            break;
         }
+        case '"':
+            node->type = cJSON_String;
+            node->valuestring = reader_read_string(reader);
+            break;
+        case 't':
+            node->type = cJSON_True;
+            node->valueint = 1;
+            reader_read_literal(reader, "true");
+            break;
+        case 'f':
+            node->type = cJSON_False;
+            reader_read_literal(reader, "false");
+            break;
+        case 'n':
+            node->type = cJSON_NULL;
+            reader_read_literal(reader, "null");
+            break;
+        default:
+            node->type = cJSON_Number;
+            node->valuedouble = reader_read_number(reader);
+            if (node->valuedouble >= INT_MAX)
+                node->valueint = INT_MAX;
+            else if (node->valuedouble <= (double) INT_MIN)
+                node->valueint = INT_MIN;
+            else
+                node->valueint = (int) node->valuedouble;
+            break;
     }
 
-    json_entity = NULL;
-    cJSON_ArrayForEach(json_entity, entities) {
-        const cJSON* parent = cJSON_GetObjectItem(json_entity, "parent");
-        if (!parent)
-            continue;
-        dt_ecs_manager_set_parent(scene->manager, (u16) atoi(json_entity->string),
-                                  (DtEntity) cJSON_GetNumberValue(parent));
-    }
+    return reader->failed ? NULL : node;
+}
+
+bool dt_scenes_scene_is_loaded(const char* name) {
+    DtEnvironment* env = dt_environment_instance();
+
+    pthread_mutex_lock(&env->scenes_lock);
+    const bool loaded = dt_rb_tree_get(&env->scenes, get_scene_hash(name)) != NULL;
+    pthread_mutex_unlock(&env->scenes_lock);
+
+    return loaded;
+}
+
+void dt_scene_unload(const char* name) {
+    DtEnvironment* env = dt_environment_instance();
+
+    pthread_mutex_lock(&env->scenes_lock);
+    const DtScene* scene = dt_rb_tree_get(&env->scenes, get_scene_hash(name));
+    pthread_mutex_unlock(&env->scenes_lock);
+
+    dt_scene_unload_by(scene);
 }
 
 void dt_scene_unload_by(const DtScene* scene) {
     if (!scene)
         return;
 
-    dt_rb_tree_remove(&dt_environment_instance()->scenes, get_scene_hash(scene->name));
+    DtEnvironment* env = dt_environment_instance();
+    pthread_mutex_lock(&env->scenes_lock);
+    dt_rb_tree_remove(&env->scenes, get_scene_hash(scene->name));
+    if (env->active_scene == scene)
+        env->active_scene = NULL;
+    pthread_mutex_unlock(&env->scenes_lock);
 
     DT_FREE(scene->name);
     dt_ecs_manager_free(scene->manager);
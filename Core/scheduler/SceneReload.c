@@ -0,0 +1,94 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DtAllocators.h"
+#include "scheduler/RuntimeScheduler.h"
+
+/**
+ * @brief names are copied, system names of handlers point into module which is unloaded
+ */
+struct DtSceneReload {
+    DtComponentLayout* layouts;
+    u16 layouts_count;
+
+    char** update_names;
+    u16 update_count;
+
+    char** draw_names;
+    u16 draw_count;
+};
+
+static char** copy_names(char** names, u16 count);
+static void free_names(char** names, u16 count);
+
+DtSceneReload* dt_scene_reload_begin(const DtScene* scene) {
+    DtSceneReload* reload = DT_MALLOC(sizeof(DtSceneReload));
+    if (!reload) {
+        printf("[DEBUG] Failed to allocate scene reload\n");
+        exit(1);
+    }
+
+    *reload = (DtSceneReload) {
+        .update_count = dt_vec_count(scene->update_handler->names),
+        .draw_count = dt_vec_count(scene->draw_handler->names),
+    };
+
+    reload->layouts = dt_ecs_manager_capture_layouts(scene->manager, &reload->layouts_count);
+    reload->update_names = copy_names(scene->update_handler->names, reload->update_count);
+    reload->draw_names = copy_names(scene->draw_handler->names, reload->draw_count);
+
+    return reload;
+}
+
+bool dt_scene_reload_end(const DtScene* scene, DtSceneReload* reload) {
+    const bool migrated =
+        dt_ecs_manager_migrate(scene->manager, reload->layouts, reload->layouts_count);
+
+    if (migrated) {
+        UpdateHandler* update_handler = scene->update_handler;
+        dt_update_handler_clear(update_handler);
+
+        for (u16 i = 0; i < reload->update_count; i++) {
+            const DtUpdateData* data = dt_update_get_data_by_name(reload->update_names[i]);
+            if (data)
+                dt_update_handler_add(update_handler, data->new(), data->name);
+            else
+                fprintf(stderr, "[WARNING] update system %s was removed\n",
+                        reload->update_names[i]);
+        }
+
+        DrawHandler* draw_handler = scene->draw_handler;
+        dt_draw_handler_clear(draw_handler);
+
+        for (u16 i = 0; i < reload->draw_count; i++) {
+            const DtDrawData* data = dt_draw_get_data_by_name(reload->draw_names[i]);
+            if (data)
+                dt_draw_handler_add(draw_handler, data->new(), data->name);
+            else
+                fprintf(stderr, "[WARNING] draw system %s was removed\n", reload->draw_names[i]);
+        }
+    }
+
+    dt_component_layouts_free(reload->layouts, reload->layouts_count);
+    free_names(reload->update_names, reload->update_count);
+    free_names(reload->draw_names, reload->draw_count);
+    DT_FREE(reload);
+
+    return migrated;
+}
+
+static char** copy_names(char** names, const u16 count) {
+    char** copy = DT_MALLOC((count + 1) * sizeof(char*));
+    for (u16 i = 0; i < count; i++)
+        copy[i] = strdup(names[i]);
+
+    return copy;
+}
+
+static void free_names(char** names, const u16 count) {
+    for (u16 i = 0; i < count; i++)
+        DT_FREE(names[i]);
+    DT_FREE(names);
+}
@@ -0,0 +1,472 @@
+#define DT_ALLOC_TAG DT_ALLOC_SCENES
+
+#include <cjson/cJSON.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Collections/Collections.h"
+#include "DtAllocators.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif /*_WIN32*/
+
+#define SCENE_SAVER_TMP_SUFFIX ".tmp"
+#define SCENE_SAVER_ITEM_ALIGN _Alignof(max_align_t)
+
+/**
+ * @brief component of staged entity, items of data component are deep copy at offset
+ */
+typedef struct {
+    const char* name;
+    const DtComponentData* data;
+    const DtFieldPlan* plans;
+    u64 offset;
+} StagedComponent;
+
+typedef struct {
+    DtEntity entity;
+    DtEntity parent;
+    u32 first;
+    u16 count;
+} StagedEntity;
+
+/**
+ * @brief dirty entities are copied by caller, writer thread serializes copies, so
+ * scene may change during save, everything except dirty flags is touched only after
+ * previous save is waited
+ */
+struct DtSceneSaver {
+    char** fragments;
+    bool* dirty;
+    DtEntity count;
+    DtEntity capacity;
+
+    DT_VEC(StagedEntity) staged;
+    DT_VEC(StagedComponent) components;
+    u8* items;
+    u64 items_size;
+    u64 items_capacity;
+
+    DtEcsManagerConfig config;
+    DT_VEC(char*) update_names;
+    DT_VEC(char*) draw_names;
+    char* path;
+
+    pthread_t thread;
+    bool running;
+    bool result;
+};
+
+static cJSON* dt_scene_serialize_ecs_manager(DtEcsManagerConfig cfg);
+static cJSON* dt_scene_serialize_entities(const DtScene* scene);
+static cJSON* dt_scene_serialize_header(DtEcsManagerConfig cfg, DT_VEC(char*) update_names,
+                                        DT_VEC(char*) draw_names);
+static cJSON* dt_scene_serialize_component(const char* name, const DtComponentData* data,
+                                           const DtFieldPlan* plans, const u8* instance);
+
+static void scene_saver_reserve(DtSceneSaver* saver, DtEntity count);
+
+/**
+ * @brief deep copy of entity components into saver, it runs on caller thread
+ */
+static void scene_saver_stage(DtSceneSaver* saver, const DtEcsManager* manager, DtEntity entity);
+static u8* scene_saver_stage_item(DtSceneSaver* saver, u64 size, u64* offset);
+
+/**
+ * @brief print staged entities and write file, staged copies are released
+ */
+static bool scene_saver_run(DtSceneSaver* saver);
+static void* scene_saver_thread(void* data);
+static bool scene_saver_write_file(const DtSceneSaver* saver, const char* header);
+
+cJSON* dt_scene_to_json(const DtScene* scene) {
+    cJSON* root =
+        dt_scene_serialize_header(dt_ecs_manager_get_config(scene->manager),
+                                  scene->update_handler->names, scene->draw_handler->names);
+    cJSON_AddItemToObject(root, "entities", dt_scene_serialize_entities(scene));
+
+    return root;
+}
+
+cJSON* dt_scene_entity_to_json(const DtEcsManager* manager, const DtEntity entity) {
+    cJSON* entity_json = cJSON_CreateObject();
+    DtEntityInfo info = dt_ecs_manager_get_entity(manager, entity);
+
+    cJSON* components_arr = cJSON_AddArrayToObject(entity_json, "components");
+
+    for (int c = 0; c < info.component_count; c++) {
+        DtEcsPool* pool = manager->pools[info.components[c]];
+        const DtComponentData* data = dt_component_get_data_by_name(pool->name);
+        const DtFieldPlan* plans = data->field_count ? dt_component_get_plans(data) : NULL;
+        const u8* instance = data->field_count ? dt_ecs_pool_get(pool, entity) : NULL;
+
+        cJSON_AddItemToArray(components_arr,
+                             dt_scene_serialize_component(pool->name, data, plans, instance));
+    }
+
+    if (info.parent != DT_ENTITY_NULL) {
+        cJSON_AddNumberToObject(entity_json, "parent", info.parent);
+    }
+
+    return entity_json;
+}
+
+bool dt_scene_save_json(const DtScene* scene, const char* path) {
+    cJSON* root = dt_scene_to_json(scene);
+    char* text = cJSON_Print(root);
+    cJSON_Delete(root);
+
+    if (!text)
+        return false;
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+        cJSON_free(text);
+        return false;
+    }
+
+    fputs(text, file);
+    fclose(file);
+    cJSON_free(text);
+
+    return true;
+}
+
+DtSceneSaver* dt_scene_saver_new(void) {
+    DtSceneSaver* saver = DT_MALLOC(sizeof(DtSceneSaver));
+
+    if (!saver) {
+        printf("[DEBUG] scene saver allocation exception\n");
+        exit(1);
+    }
+
+    *saver = (DtSceneSaver) {
+        .staged = DT_VEC_NEW(StagedEntity, 16),
+        .components = DT_VEC_NEW(StagedComponent, 16),
+        .update_names = DT_VEC_NEW(char*, 4),
+        .draw_names = DT_VEC_NEW(char*, 4),
+        .result = true,
+    };
+
+    return saver;
+}
+
+void dt_scene_saver_mark_dirty(DtSceneSaver* saver, const DtEntity entity) {
+    if (entity < saver->capacity)
+        saver->dirty[entity] = true;
+}
+
+void dt_scene_saver_mark_all(DtSceneSaver* saver) {
+    for (DtEntity e = 0; e < saver->capacity; e++)
+        saver->dirty[e] = true;
+}
+
+bool dt_scene_saver_save_async(DtSceneSaver* saver, const DtScene* scene, const char* path) {
+    dt_scene_saver_wait(saver);
+
+    const DtEcsManager* manager = scene->manager;
+    scene_saver_reserve(saver, manager->entities_ptr);
+
+    for (DtEntity e = manager->entities_ptr; e < saver->count; e++) {
+        cJSON_free(saver->fragments[e]);
+        saver->fragments[e] = NULL;
+    }
+    saver->count = manager->entities_ptr;
+
+    dt_vec_header(saver->staged)->count = 0;
+    dt_vec_header(saver->components)->count = 0;
+    saver->items_size = 0;
+    for (DtEntity e = 0; e < saver->count; e++) {
+        if (!saver->dirty[e] && saver->fragments[e])
+            continue;
+
+        scene_saver_stage(saver, manager, e);
+        saver->dirty[e] = false;
+    }
+
+    saver->config = dt_ecs_manager_get_config(manager);
+    dt_vec_header(saver->update_names)->count = 0;
+    dt_vec_header(saver->draw_names)->count = 0;
+    FOREACH(char*, name, DT_VEC_ITERATOR(scene->update_handler->names),
+            { DT_VEC_ADD(saver->update_names, name); });
+    FOREACH(char*, name, DT_VEC_ITERATOR(scene->draw_handler->names),
+            { DT_VEC_ADD(saver->draw_names, name); });
+
+    DT_FREE(saver->path);
+    saver->path = strdup(path);
+
+    printf("[DEBUG]\t scene saving started, %lu of %d entities were copied\n",
+           (unsigned long) dt_vec_count(saver->staged), saver->count);
+
+    saver->running = pthread_create(&saver->thread, NULL, scene_saver_thread, saver) == 0;
+    if (!saver->running)
+        saver->result = scene_saver_run(saver);
+
+    return saver->running || saver->result;
+}
+
+bool dt_scene_saver_wait(DtSceneSaver* saver) {
+    if (saver->running) {
+        pthread_join(saver->thread, NULL);
+        saver->running = false;
+    }
+
+    return saver->result;
+}
+
+void dt_scene_saver_free(DtSceneSaver* saver) {
+    dt_scene_saver_wait(saver);
+
+    for (DtEntity e = 0; e < saver->count; e++)
+        cJSON_free(saver->fragments[e]);
+
+    DT_FREE(saver->fragments);
+    DT_FREE(saver->dirty);
+    dt_vec_free(saver->staged);
+    dt_vec_free(saver->components);
+    DT_FREE(saver->items);
+    dt_vec_free(saver->update_names);
+    dt_vec_free(saver->draw_names);
+    DT_FREE(saver->path);
+    DT_FREE(saver);
+}
+
+static void scene_saver_reserve(DtSceneSaver* saver, const DtEntity count) {
+    if (count <= saver->capacity)
+        return;
+
+    void* tmp = DT_REALLOC(saver->fragments, count * sizeof(char*));
+    if (!tmp) {
+        printf("[DEBUG] scene saver realloc exception\n");
+        exit(1);
+    }
+    saver->fragments = tmp;
+
+    tmp = DT_REALLOC(saver->dirty, count * sizeof(bool));
+    if (!tmp) {
+        printf("[DEBUG] scene saver realloc exception\n");
+        exit(1);
+    }
+    saver->dirty = tmp;
+
+    for (DtEntity e = saver->capacity; e < count; e++) {
+        saver->fragments[e] = NULL;
+        saver->dirty[e] = true;
+    }
+
+    saver->capacity = count;
+}
+
+static void scene_saver_stage(DtSceneSaver* saver, const DtEcsManager* manager,
+                              const DtEntity entity) {
+    const DtEntityInfo info = dt_ecs_manager_get_entity(manager, entity);
+
+    StagedEntity staged = {
+        .entity = entity,
+        .parent = info.parent,
+        .first = dt_vec_count(saver->components),
+        .count = info.component_count,
+    };
+
+    for (int c = 0; c < info.component_count; c++) {
+        const DtEcsPool* pool = manager->pools[info.components[c]];
+        const DtComponentData* data = dt_component_get_data_by_name(pool->name);
+
+        StagedComponent component = {
+            .name = pool->name,
+            .data = data,
+            .plans = data->field_count ? dt_component_get_plans(data) : NULL,
+        };
+
+        if (data->field_count) {
+            u8* item = scene_saver_stage_item(saver, data->component_size, &component.offset);
+            const void* src = dt_ecs_pool_get(pool, entity);
+            if (data->copy)
+                data->copy(item, src);
+            else
+                memcpy(item, src, data->component_size);
+        }
+
+        DT_VEC_ADD(saver->components, component);
+    }
+
+    DT_VEC_ADD(saver->staged, staged);
+}
+
+static u8* scene_saver_stage_item(DtSceneSaver* saver, const u64 size, u64* offset) {
+    // items are read through typed fields, so each starts aligned
+    *offset = (saver->items_size + SCENE_SAVER_ITEM_ALIGN - 1) &
+              ~(u64) (SCENE_SAVER_ITEM_ALIGN - 1);
+    const u64 end = *offset + size;
+
+    if (end > saver->items_capacity) {
+        const u64 capacity = end > saver->items_capacity * 2 ? end : saver->items_capacity * 2;
+        void* tmp = DT_REALLOC(saver->items, capacity);
+        if (!tmp) {
+            printf("[DEBUG] scene saver realloc exception\n");
+            exit(1);
+        }
+
+        saver->items = tmp;
+        saver->items_capacity = capacity;
+    }
+
+    saver->items_size = end;
+
+    return saver->items + *offset;
+}
+
+static bool scene_saver_run(DtSceneSaver* saver) {
+    for (size_t i = 0; i < dt_vec_count(saver->staged); i++) {
+        const StagedEntity* staged = &saver->staged[i];
+
+        cJSON* entity_json = cJSON_CreateObject();
+        cJSON* components_arr = cJSON_AddArrayToObject(entity_json, "components");
+        for (u16 c = 0; c < staged->count; c++) {
+            const StagedComponent* component = &saver->components[staged->first + c];
+            u8* item = component->data->field_count ? saver->items + component->offset : NULL;
+
+            cJSON_AddItemToArray(components_arr,
+                                 dt_scene_serialize_component(component->name, component->data,
+                                                              component->plans, item));
+            if (item && component->data->reset)
+                component->data->reset(item);
+        }
+
+        if (staged->parent != DT_ENTITY_NULL)
+            cJSON_AddNumberToObject(entity_json, "parent", staged->parent);
+
+        cJSON_free(saver->fragments[staged->entity]);
+        saver->fragments[staged->entity] = cJSON_PrintUnformatted(entity_json);
+        cJSON_Delete(entity_json);
+    }
+
+    cJSON* header_json =
+        dt_scene_serialize_header(saver->config, saver->update_names, saver->draw_names);
+    char* header = cJSON_PrintUnformatted(header_json);
+    cJSON_Delete(header_json);
+
+    const bool ok = scene_saver_write_file(saver, header);
+    cJSON_free(header);
+
+    return ok;
+}
+
+static void* scene_saver_thread(void* data) {
+    DtSceneSaver* saver = data;
+    saver->result = scene_saver_run(saver);
+
+    return NULL;
+}
+
+static bool scene_saver_write_file(const DtSceneSaver* saver, const char* header) {
+    const size_t path_len = strlen(saver->path);
+    char* tmp_path = DT_MALLOC(path_len + sizeof(SCENE_SAVER_TMP_SUFFIX));
+    memcpy(tmp_path, saver->path, path_len);
+    memcpy(tmp_path + path_len, SCENE_SAVER_TMP_SUFFIX, sizeof(SCENE_SAVER_TMP_SUFFIX));
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) {
+        fprintf(stderr, "[ERROR] Could not open file %s\n", tmp_path);
+        DT_FREE(tmp_path);
+        return false;
+    }
+
+    // header is printed object, its closing brace is replaced by entities
+    fwrite(header, 1, strlen(header) - 1, file);
+    fputs(",\"entities\":{\n", file);
+
+    for (DtEntity e = 0; e < saver->count; e++) {
+        fprintf(file, "%s\"%u\":", e ? ",\n" : "", e);
+        fputs(saver->fragments[e], file);
+    }
+
+    fputs("\n}}\n", file);
+
+    bool ok = fflush(file) == 0 && !ferror(file);
+#ifndef _WIN32
+    ok = ok && fsync(fileno(file)) == 0;
+#endif /*_WIN32*/
+    ok = fclose(file) == 0 && ok;
+
+    ok = ok && dt_file_replace(tmp_path, saver->path);
+    if (!ok) {
+        fprintf(stderr, "[ERROR] Could not save scene %s\n", saver->path);
+        remove(tmp_path);
+    }
+
+    DT_FREE(tmp_path);
+
+    return ok;
+}
+
+static cJSON* dt_scene_serialize_header(const DtEcsManagerConfig cfg, DT_VEC(char*) update_names,
+                                        DT_VEC(char*) draw_names) {
+    cJSON* root = cJSON_CreateObject();
+
+    cJSON_AddItemToObject(root, "manager_config", dt_scene_serialize_ecs_manager(cfg));
+
+    cJSON* update_sys = cJSON_AddArrayToObject(root, "update_systems");
+    FOREACH(char*, name, DT_VEC_ITERATOR(update_names),
+            { cJSON_AddItemToArray(update_sys, cJSON_CreateString(name)); });
+
+    cJSON* draw_sys = cJSON_AddArrayToObject(root, "draw_systems");
+    FOREACH(char*, name, DT_VEC_ITERATOR(draw_names),
+            { cJSON_AddItemToArray(draw_sys, cJSON_CreateString(name)); });
+
+    return root;
+}
+
+static cJSON* dt_scene_serialize_component(const char* name, const DtComponentData* data,
+                                           const DtFieldPlan* plans, const u8* instance) {
+    if (data->field_count == 0)
+        return cJSON_CreateString(name);
+
+    cJSON* comp_obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(comp_obj, "name", name);
+    cJSON* values_obj = cJSON_AddObjectToObject(comp_obj, "values");
+
+    for (int f = 0; f < data->field_count; f++) {
+        const void* field = instance + plans[f].offset;
+        cJSON* value = plans[f].serialize ? plans[f].serialize(field)
+                                          : dt_serialize_type_to_json(data->field_types[f], field);
+        cJSON_AddItemToObject(values_obj, data->field_names[f], value);
+    }
+
+    return comp_obj;
+}
+
+static cJSON* dt_scene_serialize_ecs_manager(const DtEcsManagerConfig cfg) {
+    cJSON* json_cfg = cJSON_CreateObject();
+
+    cJSON_AddNumberToObject(json_cfg, "dense_size", cfg.dense_size);
+    cJSON_AddNumberToObject(json_cfg, "sparse_size", cfg.sparse_size);
+    cJSON_AddNumberToObject(json_cfg, "recycle_size", cfg.recycle_size);
+    cJSON_AddNumberToObject(json_cfg, "children_size", cfg.children_size);
+    cJSON_AddNumberToObject(json_cfg, "components_count", cfg.components_count);
+    cJSON_AddNumberToObject(json_cfg, "pools_size", cfg.pools_size);
+    cJSON_AddNumberToObject(json_cfg, "include_mask_count", cfg.include_mask_count);
+    cJSON_AddNumberToObject(json_cfg, "exclude_mask_count", cfg.exclude_mask_count);
+    cJSON_AddNumberToObject(json_cfg, "filters_size", cfg.filters_size);
+    cJSON_AddNumberToObject(json_cfg, "masks_size", cfg.masks_size);
+
+    return json_cfg;
+}
+
+static cJSON* dt_scene_serialize_entities(const DtScene* scene) {
+    cJSON* entities_obj = cJSON_CreateObject();
+    const DtEcsManager* manager = scene->manager;
+
+    for (u16 i = 0; i < manager->entities_ptr; i++) {
+        char idx_str[16];
+        snprintf(idx_str, sizeof(idx_str), "%u", i);
+        cJSON_AddItemToObject(entities_obj, idx_str, dt_scene_entity_to_json(manager, i));
+    }
+
+    return entities_obj;
+}
@@ -37,6 +37,11 @@ static cJSON* serialize_rectangle_to_json(const void* src);
 static cJSON* serialize_bool_to_json(const void* src);
 static cJSON* serialize_color_to_json(const void* src);
 
+/**
+ * @brief refuse to change type handlers while registries are frozen
+ */
+static bool handlers_frozen(const char* type);
+
 static u64 get_hash(const char* name) {
     int hash = 2147483647;
     while (*name) {
@@ -46,7 +51,7 @@ static u64 get_hash(const char* name) {
     return hash;
 }
 
-__attribute__((constructor)) static void dt_parser_initialize(void) {
+__attribute__((constructor(DT_ORDER_INIT_TYPES))) static void dt_parser_initialize(void) {
     parsers_json_to_type = dt_rb_tree_new();
     dt_add_parser_json_to_type("int", parse_json_to_int);
     dt_add_parser_json_to_type("unsigned int", parse_json_to_unsigned_int);
@@ -84,17 +89,29 @@ __attribute__((constructor)) static void dt_parser_initialize(void) {
 }
 
 void dt_add_parser_json_to_type(const char* type, const TypeParser parser) {
+    if (handlers_frozen(type))
+        return;
+
     const u64 hash = get_hash(type);
     dt_rb_tree_add(&parsers_json_to_type, parser, hash);
+    dt_component_invalidate_plans();
 }
 
 void dt_link_parser_json_to_type(const char* type, const char* base_type) {
+    if (handlers_frozen(type))
+        return;
+
     TypeParser parser;
     if ((parser = dt_rb_tree_get(&parsers_json_to_type, get_hash(base_type)))) {
         dt_rb_tree_add(&parsers_json_to_type, parser, get_hash(type));
+        dt_component_invalidate_plans();
     }
 }
 
+TypeParser dt_get_parser_json_to_type(const char* type) {
+    return dt_rb_tree_get(&parsers_json_to_type, get_hash(type));
+}
+
 void dt_parse_json_to_type(const char* type, cJSON* src, void* dst) {
     const TypeParser parser = dt_rb_tree_get(&parsers_json_to_type, get_hash(type));
     if (parser) {
@@ -102,12 +119,27 @@ void dt_parse_json_to_type(const char* type, cJSON* src, void* dst) {
         return;
     }
 
-    FOREACH(ModuleInfo, module, &dt_environment_instance()->modules.iterator, {
-        TypeParser parser = *(TypeParser*) DT_LIB_GET(module.handle, "dt_parse_json_to_type");
-        if (parser) {
-            parser(src, dst);
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
+        void (*parse_json_to_type)(const char*, cJSON*, void*) =
+            (void (*)(const char*, cJSON*, void*)) DT_LIB_GET(env->modules_list[i]->handle,
+                                                             "dt_parse_json_to_type");
+        if (parse_json_to_type) {
+            parse_json_to_type(type, src, dst);
+            return;
         }
-    });
+    }
+}
+
+static bool handlers_frozen(const char* type) {
+    if (!dt_registries_frozen())
+        return false;
+
+    fprintf(stderr, "[WARNING] registries are frozen, handler of %s type isn't added\n", type);
+    return true;
 }
 
 static void parse_json_to_int(cJSON* src, void* dst) {
@@ -264,7 +296,15 @@ static void parse_json_to_color(cJSON* src, void* dst) {
 }
 
 void dt_add_serializer_type_to_json(const char* type, const TypeSerializer serializer) {
+    if (handlers_frozen(type))
+        return;
+
     dt_rb_tree_add(&serializers_type_to_json, serializer, get_hash(type));
+    dt_component_invalidate_plans();
+}
+
+TypeSerializer dt_get_serializer_type_to_json(const char* type) {
+    return dt_rb_tree_get(&serializers_type_to_json, get_hash(type));
 }
 
 cJSON* dt_serialize_type_to_json(const char* type, const void* src) {
@@ -273,16 +313,20 @@ cJSON* dt_serialize_type_to_json(const char* type, const void* src) {
         return serializer(src);
     }
 
-    FOREACH(ModuleInfo, module, &dt_environment_instance()->modules.iterator, {
+    const DtEnvironment* env = dt_environment_instance();
+    if (!env->modules_list)
+        return NULL;
+
+    for (size_t i = 0; i < dt_vec_count(env->modules_list); i++) {
         cJSON* (*serializer_type_to_json)(const char*, const void* src) =
             (cJSON * (*) (const char*, const void* src))
-                DT_LIB_GET(module.handle, "dt_serialize_type_to_json");
+                DT_LIB_GET(env->modules_list[i]->handle, "dt_serialize_type_to_json");
 
         cJSON* res = serializer_type_to_json(type, src);
 
         if (res)
             return res;
-    });
+    }
 
     return NULL;
 }
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include "DtBench.h"
+
+static const char* counter_names[DT_BENCH_COUNTERS_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+};
+
+const char* dt_bench_counter_name(const DtBenchCounter counter) {
+    return counter_names[counter];
+}
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+typedef struct {
+    u64 value;
+    u64 time_enabled;
+    u64 time_running;
+} CounterRead;
+
+static int counter_fds[DT_BENCH_COUNTERS_COUNT] = {-1, -1, -1, -1, -1};
+
+static int counter_open(u32 type, u64 config);
+
+bool dt_bench_counters_open(void) {
+    const u64 l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                              PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+
+    counter_fds[DT_BENCH_CYCLES] = counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    counter_fds[DT_BENCH_INSTRUCTIONS] =
+        counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    counter_fds[DT_BENCH_L1D_MISSES] = counter_open(PERF_TYPE_HW_CACHE, l1d_read_miss);
+    counter_fds[DT_BENCH_LLC_MISSES] = counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    counter_fds[DT_BENCH_BRANCH_MISSES] =
+        counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+    bool any = false;
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++) {
+        if (counter_fds[i] < 0)
+            fprintf(stderr, "[WARNING] counter %s is unavailable: %s\n", counter_names[i],
+                    strerror(-counter_fds[i]));
+        any |= counter_fds[i] >= 0;
+    }
+
+    return any;
+}
+
+void dt_bench_counters_start(void) {
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++) {
+        if (counter_fds[i] < 0)
+            continue;
+
+        ioctl(counter_fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void dt_bench_counters_stop(double values[DT_BENCH_COUNTERS_COUNT]) {
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++) {
+        if (counter_fds[i] >= 0)
+            ioctl(counter_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++) {
+        CounterRead read_value;
+        if (counter_fds[i] < 0 ||
+            read(counter_fds[i], &read_value, sizeof(read_value)) != sizeof(read_value)) {
+            values[i] = -1;
+            continue;
+        }
+
+        // counters are multiplexed when PMU is busy, value is scaled to whole run
+        values[i] = read_value.time_running
+                        ? (double) read_value.value * (double) read_value.time_enabled /
+                              (double) read_value.time_running
+                        : -1;
+    }
+}
+
+void dt_bench_counters_close(void) {
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++) {
+        if (counter_fds[i] >= 0)
+            close(counter_fds[i]);
+        counter_fds[i] = -1;
+    }
+}
+
+/**
+ * @brief count only this thread in user space, so it works with perf_event_paranoid 2
+ *
+ * @return fd or negative errno
+ */
+static int counter_open(const u32 type, const u64 config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd >= 0 ? (int) fd : -errno;
+}
+#else
+bool dt_bench_counters_open(void) {
+    fprintf(stderr, "[WARNING] hardware counters are supported only on linux\n");
+    return false;
+}
+
+void dt_bench_counters_start(void) {}
+
+void dt_bench_counters_stop(double values[DT_BENCH_COUNTERS_COUNT]) {
+    for (int i = 0; i < DT_BENCH_COUNTERS_COUNT; i++)
+        values[i] = -1;
+}
+
+void dt_bench_counters_close(void) {}
+#endif /*__linux__*/
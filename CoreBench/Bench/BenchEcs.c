@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include "DtBench.h"
+
+#define FILTER_PASSES 50
+
+typedef struct {
+    DtEcsManager* manager;
+    DtEntity* entities;
+    u16 count;
+
+    DtEcsPool* position_pool;
+    DtEcsPool* velocity_pool;
+    DtEcsPool* health_pool;
+    DtEcsPool* armor_pool;
+    DtEcsPool* enemy_pool;
+
+    DtEcsFilter* filter1;
+    DtEcsFilter* filter2;
+    DtEcsFilter* filter4;
+    DtEcsFilter* enemy_filter;
+
+    DtEntity* stack;
+    u64 sink;
+} EcsBench;
+
+/**
+ * @brief world where every entity has all components, every second one is enemy,
+ * entity i is child of (i - 1) / 4
+ */
+static void world_new(EcsBench* bench, bool hierarchy);
+static void world_free(EcsBench* bench);
+static void world_get_pools(EcsBench* bench);
+
+static void setup_empty(void* data);
+static void setup_entities(void* data);
+static void setup_positions(void* data);
+static void teardown_world(void* data);
+
+static void run_entity_create(void* data);
+static void run_entity_destroy(void* data);
+static void run_component_add(void* data);
+static void run_component_remove(void* data);
+static void run_filter_iterate1(void* data);
+static void run_filter_iterate2(void* data);
+static void run_filter_iterate4(void* data);
+static void run_tag_has(void* data);
+static void run_tag_iterate(void* data);
+static void run_tag_filter_iterate(void* data);
+static void run_hierarchy_walk(void* data);
+static void run_hierarchy_reparent(void* data);
+
+void bench_ecs(void) {
+    EcsBench bench = {.count = DT_BENCH_ENTITIES};
+    const u64 n = bench.count;
+
+    dt_bench_run("entity_create", n, setup_empty, run_entity_create, teardown_world, &bench);
+    dt_bench_run("entity_destroy", n, setup_entities, run_entity_destroy, teardown_world, &bench);
+    dt_bench_run("component_add", n, setup_entities, run_component_add, teardown_world, &bench);
+    dt_bench_run("component_remove", n, setup_positions, run_component_remove, teardown_world,
+                 &bench);
+
+    world_new(&bench, false);
+    dt_bench_run("filter_iterate_1", n * FILTER_PASSES, NULL, run_filter_iterate1, NULL, &bench);
+    dt_bench_run("filter_iterate_2", n * FILTER_PASSES, NULL, run_filter_iterate2, NULL, &bench);
+    dt_bench_run("filter_iterate_4", n * FILTER_PASSES, NULL, run_filter_iterate4, NULL, &bench);
+    dt_bench_run("tag_has", n * FILTER_PASSES, NULL, run_tag_has, NULL, &bench);
+    dt_bench_run("tag_iterate", n / 2 * FILTER_PASSES, NULL, run_tag_iterate, NULL, &bench);
+    dt_bench_run("tag_filter_iterate", n / 2 * FILTER_PASSES, NULL, run_tag_filter_iterate, NULL,
+                 &bench);
+    world_free(&bench);
+
+    world_new(&bench, true);
+    dt_bench_run("hierarchy_walk", n, NULL, run_hierarchy_walk, NULL, &bench);
+    dt_bench_run("hierarchy_reparent", 2 * (n - 1), NULL, run_hierarchy_reparent, NULL, &bench);
+    world_free(&bench);
+
+    fprintf(stderr, "[DEBUG] ecs bench checksum %llu\n", (unsigned long long) bench.sink);
+}
+
+static void world_new(EcsBench* bench, const bool hierarchy) {
+    DtEcsManager* manager = dt_bench_manager_new(bench->count);
+    bench->manager = manager;
+    bench->entities = DT_MALLOC(bench->count * sizeof(DtEntity));
+    bench->stack = DT_MALLOC(bench->count * sizeof(DtEntity));
+    world_get_pools(bench);
+
+    for (u16 i = 0; i < bench->count; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        bench->entities[i] = e;
+
+        dt_ecs_pool_add(bench->position_pool, e, &(BenchPosition) {.x = i, .y = 0});
+        dt_ecs_pool_add(bench->velocity_pool, e, &(BenchVelocity) {.x = 1, .y = 2});
+        dt_ecs_pool_add(bench->health_pool, e, &(BenchHealth) {.value = 100});
+        dt_ecs_pool_add(bench->armor_pool, e, &(BenchArmor) {.value = i % 3});
+        if (i % 2 == 0)
+            dt_ecs_pool_add(bench->enemy_pool, e, NULL);
+
+        if (hierarchy && i > 0)
+            dt_ecs_manager_set_parent(manager, e, bench->entities[(i - 1) / 4]);
+    }
+
+    DtEcsMask mask1 = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask1, BenchPosition);
+    bench->filter1 = dt_mask_end(mask1);
+
+    DtEcsMask mask2 = dt_mask_new(manager, 2, 0);
+    DT_MASK_INC(mask2, BenchPosition);
+    DT_MASK_INC(mask2, BenchVelocity);
+    bench->filter2 = dt_mask_end(mask2);
+
+    DtEcsMask mask4 = dt_mask_new(manager, 4, 0);
+    DT_MASK_INC(mask4, BenchPosition);
+    DT_MASK_INC(mask4, BenchVelocity);
+    DT_MASK_INC(mask4, BenchHealth);
+    DT_MASK_INC(mask4, BenchArmor);
+    bench->filter4 = dt_mask_end(mask4);
+
+    DtEcsMask enemy_mask = dt_mask_new(manager, 2, 0);
+    DT_MASK_INC(enemy_mask, BenchPosition);
+    DT_MASK_INC(enemy_mask, BenchEnemy);
+    bench->enemy_filter = dt_mask_end(enemy_mask);
+}
+
+static void world_free(EcsBench* bench) {
+    dt_ecs_manager_free(bench->manager);
+    DT_FREE(bench->entities);
+    DT_FREE(bench->stack);
+
+    bench->manager = NULL;
+    bench->entities = NULL;
+    bench->stack = NULL;
+}
+
+static void world_get_pools(EcsBench* bench) {
+    DtEcsManager* manager = bench->manager;
+
+    bench->position_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchPosition);
+    bench->velocity_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchVelocity);
+    bench->health_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchHealth);
+    bench->armor_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchArmor);
+    bench->enemy_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchEnemy);
+}
+
+static void setup_empty(void* data) {
+    EcsBench* bench = data;
+
+    bench->manager = dt_bench_manager_new(bench->count);
+    bench->entities = DT_MALLOC(bench->count * sizeof(DtEntity));
+    world_get_pools(bench);
+}
+
+static void setup_entities(void* data) {
+    EcsBench* bench = data;
+
+    setup_empty(bench);
+    for (u16 i = 0; i < bench->count; i++)
+        bench->entities[i] = dt_ecs_manager_new_entity(bench->manager);
+}
+
+static void setup_positions(void* data) {
+    EcsBench* bench = data;
+
+    setup_entities(bench);
+    for (u16 i = 0; i < bench->count; i++) {
+        dt_ecs_pool_add(bench->position_pool, bench->entities[i], NULL);
+        // second component keeps entity alive when position is removed
+        dt_ecs_pool_add(bench->health_pool, bench->entities[i], NULL);
+    }
+}
+
+static void teardown_world(void* data) { world_free(data); }
+
+static void run_entity_create(void* data) {
+    EcsBench* bench = data;
+
+    for (u16 i = 0; i < bench->count; i++)
+        bench->entities[i] = dt_ecs_manager_new_entity(bench->manager);
+}
+
+static void run_entity_destroy(void* data) {
+    EcsBench* bench = data;
+
+    for (u16 i = 0; i < bench->count; i++)
+        dt_ecs_manager_kill_entity(bench->manager, bench->entities[i]);
+}
+
+static void run_component_add(void* data) {
+    EcsBench* bench = data;
+
+    for (u16 i = 0; i < bench->count; i++) {
+        dt_ecs_pool_add(bench->position_pool, bench->entities[i],
+                        &(BenchPosition) {.x = i, .y = i});
+    }
+}
+
+static void run_component_remove(void* data) {
+    EcsBench* bench = data;
+
+    for (u16 i = 0; i < bench->count; i++)
+        dt_ecs_pool_remove(bench->position_pool, bench->entities[i]);
+}
+
+static void run_filter_iterate1(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++) {
+        FOREACH(DtEntity, e, &bench->filter1->entities.entities_iterator, {
+            BenchPosition* position = dt_ecs_pool_get(bench->position_pool, e);
+            position->x += 1.0f;
+        });
+    }
+}
+
+static void run_filter_iterate2(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++) {
+        FOREACH(DtEntity, e, &bench->filter2->entities.entities_iterator, {
+            BenchPosition* position = dt_ecs_pool_get(bench->position_pool, e);
+            const BenchVelocity* velocity = dt_ecs_pool_get(bench->velocity_pool, e);
+            position->x += velocity->x;
+            position->y += velocity->y;
+        });
+    }
+}
+
+static void run_filter_iterate4(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++) {
+        FOREACH(DtEntity, e, &bench->filter4->entities.entities_iterator, {
+            BenchPosition* position = dt_ecs_pool_get(bench->position_pool, e);
+            const BenchVelocity* velocity = dt_ecs_pool_get(bench->velocity_pool, e);
+            BenchHealth* health = dt_ecs_pool_get(bench->health_pool, e);
+            const BenchArmor* armor = dt_ecs_pool_get(bench->armor_pool, e);
+            position->x += velocity->x;
+            position->y += velocity->y;
+            health->value -= armor->value;
+        });
+    }
+}
+
+static void run_tag_has(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++) {
+        for (u16 i = 0; i < bench->count; i++)
+            bench->sink += dt_ecs_pool_has(bench->enemy_pool, bench->entities[i]);
+    }
+}
+
+static void run_tag_iterate(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++)
+        FOREACH(DtEntity, e, &bench->enemy_pool->iterator, { bench->sink += e; });
+}
+
+static void run_tag_filter_iterate(void* data) {
+    EcsBench* bench = data;
+
+    for (int pass = 0; pass < FILTER_PASSES; pass++) {
+        FOREACH(DtEntity, e, &bench->enemy_filter->entities.entities_iterator, {
+            BenchPosition* position = dt_ecs_pool_get(bench->position_pool, e);
+            position->y -= 1.0f;
+        });
+    }
+}
+
+static void run_hierarchy_walk(void* data) {
+    EcsBench* bench = data;
+
+    u16 stack_count = 0;
+    bench->stack[stack_count++] = bench->entities[0];
+
+    while (stack_count > 0) {
+        const DtEntity parent = bench->stack[--stack_count];
+        const BenchPosition* parent_position = dt_ecs_pool_get(bench->position_pool, parent);
+
+        u16 children_count;
+        const DtEntity* children =
+            dt_ecs_manager_get_children(bench->manager, parent, &children_count);
+
+        for (u16 i = 0; i < children_count; i++) {
+            BenchPosition* position = dt_ecs_pool_get(bench->position_pool, children[i]);
+            const BenchVelocity* local = dt_ecs_pool_get(bench->velocity_pool, children[i]);
+            position->x = parent_position->x + local->x;
+            position->y = parent_position->y + local->y;
+
+            bench->stack[stack_count++] = children[i];
+        }
+    }
+}
+
+static void run_hierarchy_reparent(void* data) {
+    EcsBench* bench = data;
+
+    for (u16 i = 1; i < bench->count; i++) {
+        const DtEntity e = bench->entities[i];
+        dt_ecs_manager_set_parent(bench->manager, e, DT_ENTITY_NULL);
+        dt_ecs_manager_set_parent(bench->manager, e, bench->entities[(i - 1) / 4]);
+    }
+}
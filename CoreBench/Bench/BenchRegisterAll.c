@@ -0,0 +1,115 @@
+#include <stddef.h>
+#include "DtBench.h"
+#include "Ecs/RegisterHandler.h"
+
+DT_REGISTER_TAG(BenchEnemy);
+DT_REGISTER_COMPONENT(BenchPosition, BENCH_POSITION);
+DT_REGISTER_COMPONENT(BenchVelocity, BENCH_VELOCITY);
+DT_REGISTER_COMPONENT(BenchHealth, BENCH_HEALTH);
+DT_REGISTER_COMPONENT(BenchArmor, BENCH_ARMOR);
+
+static void bench_move_init(DtEcsManager* manager, void* data);
+static void bench_move_update(void* data, DtUpdateContext* ctx);
+static void bench_move_chunk(const DtEntity* entities, u16 count, DtFilterChunkContext* ctx,
+                             void* data);
+static void bench_toggle_init(DtEcsManager* manager, void* data);
+static void bench_toggle_update(void* data, DtUpdateContext* ctx);
+
+UpdateSystem* bench_move_new() {
+    BenchMove* move = DT_MALLOC(sizeof(BenchMove));
+
+    *move = (BenchMove) {
+        .system =
+            (UpdateSystem) {
+                .init = bench_move_init,
+                .update = bench_move_update,
+                .priority = 0,
+            },
+    };
+
+    move->system.data = move;
+
+    return &move->system;
+}
+
+static void bench_move_init(DtEcsManager* manager, void* data) {
+    BenchMove* move = data;
+
+    move->position_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchPosition);
+    move->velocity_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchVelocity);
+
+    DtEcsMask mask = dt_mask_new(manager, 2, 0);
+    DT_MASK_INC(mask, BenchPosition);
+    DT_MASK_INC(mask, BenchVelocity);
+
+    move->filter = dt_mask_end(mask);
+}
+
+static void bench_move_update(void* data, DtUpdateContext* ctx) {
+    BenchMove* move = data;
+
+    move->delta_time = ctx->delta_time;
+    dt_filter_parallel_for(move->filter, 0, bench_move_chunk, move);
+}
+
+static void bench_move_chunk(const DtEntity* entities, const u16 count, DtFilterChunkContext* ctx,
+                             void* data) {
+    const BenchMove* move = data;
+
+    for (u16 i = 0; i < count; i++) {
+        BenchPosition* position = dt_ecs_pool_get(move->position_pool, entities[i]);
+        const BenchVelocity* velocity = dt_ecs_pool_get(move->velocity_pool, entities[i]);
+        position->x += velocity->x * move->delta_time;
+        position->y += velocity->y * move->delta_time;
+    }
+}
+
+DT_REGISTER_UPDATE(BenchMove, bench_move_new, DT_READS_ATTR(BenchVelocity),
+                   DT_WRITES_ATTR(BenchPosition));
+
+UpdateSystem* bench_toggle_new() {
+    BenchToggle* toggle = DT_MALLOC(sizeof(BenchToggle));
+
+    *toggle = (BenchToggle) {
+        .system =
+            (UpdateSystem) {
+                .init = bench_toggle_init,
+                .update = bench_toggle_update,
+                .priority = 1,
+            },
+    };
+
+    toggle->system.data = toggle;
+
+    return &toggle->system;
+}
+
+static void bench_toggle_init(DtEcsManager* manager, void* data) {
+    BenchToggle* toggle = data;
+
+    toggle->enemy_pool = DT_ECS_MANAGER_GET_POOL(manager, BenchEnemy);
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, BenchHealth);
+
+    toggle->filter = dt_mask_end(mask);
+}
+
+static void bench_toggle_update(void* data, DtUpdateContext* ctx) {
+    BenchToggle* toggle = data;
+
+    // FOREACH body can't use continue, next is called after it
+    FOREACH(DtEntity, e, &toggle->filter->entities.entities_iterator, {
+        if ((e + toggle->frame) % 8 == 0) {
+            if (dt_ecs_pool_has(toggle->enemy_pool, e))
+                dt_ecs_pool_remove(toggle->enemy_pool, e);
+            else
+                dt_ecs_pool_add(toggle->enemy_pool, e, NULL);
+        }
+    });
+
+    toggle->frame++;
+}
+
+DT_REGISTER_UPDATE(BenchToggle, bench_toggle_new, DT_READS_ATTR(BenchHealth),
+                   DT_WRITES_ATTR(BenchEnemy), DT_STRUCTURAL_ATTR);
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <string.h>
+#include "DtBench.h"
+#include "Profiling/DtAllocTracker.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define BENCH_SCENE_JSON_PATH "./bench_scene.dt.scene"
+#define BENCH_SCENE_BINARY_PATH "./bench_scene.dt.bscene"
+#define BENCH_SCENE_FRAMES 10
+#define BENCH_SCENE_WARMUP_FRAMES 2
+#define BENCH_SCENE_WORKERS 3
+
+/**
+ * @brief 1M entities from request don't fit into u16 entity id, biggest scene is near the limit
+ */
+static const u16 scene_sizes[] = {10000, 60000};
+
+typedef struct {
+    const char* path;
+    const DtScene* scene;
+    DtUpdateContext ctx;
+} SceneBench;
+
+/**
+ * @brief generated entity has position, velocity and health, every second one is enemy,
+ * entity i is child of (i - 1) / 4
+ */
+static bool write_scene(const char* path, u16 entities);
+
+/**
+ * @brief update generated scene, frames after warm up must not allocate
+ *
+ * @param workers job workers started for the run, 0 runs systems sequentially
+ */
+static void bench_scene_frames(u16 size, u16 workers);
+
+static void run_scene_load(void* data);
+static void run_scene_frames(void* data);
+static void teardown_scene(void* data);
+
+void bench_scene(void) {
+    // names are kept by results until exit
+    char name[64];
+
+    for (size_t i = 0; i < sizeof(scene_sizes) / sizeof(scene_sizes[0]); i++) {
+        const u16 size = scene_sizes[i];
+        if (!write_scene(BENCH_SCENE_JSON_PATH, size))
+            return;
+
+        SceneBench bench = {.path = BENCH_SCENE_JSON_PATH};
+        snprintf(name, sizeof(name), "scene_load_json_%u", size);
+        dt_bench_run(strdup(name), size, NULL, run_scene_load, teardown_scene, &bench);
+
+        const DtScene* scene = dt_add_scene(BENCH_SCENE_JSON_PATH);
+        const bool saved = scene && dt_scene_save_binary(scene, BENCH_SCENE_BINARY_PATH);
+        if (scene)
+            dt_scene_unload_by(scene);
+
+        if (saved) {
+            bench.path = BENCH_SCENE_BINARY_PATH;
+            snprintf(name, sizeof(name), "scene_load_binary_%u", size);
+            dt_bench_run(strdup(name), size, NULL, run_scene_load, teardown_scene, &bench);
+        }
+
+        bench_scene_frames(size, 0);
+        bench_scene_frames(size, BENCH_SCENE_WORKERS);
+
+        remove(BENCH_SCENE_JSON_PATH);
+        remove(BENCH_SCENE_BINARY_PATH);
+    }
+}
+
+static void bench_scene_frames(const u16 size, const u16 workers) {
+    SceneBench bench = {
+        .scene = dt_add_scene(BENCH_SCENE_JSON_PATH),
+        .ctx = {.delta_time = 1.0f / 60.0f},
+    };
+    if (!bench.scene)
+        return;
+
+    if (workers)
+        dt_jobs_init(workers);
+    dt_update_handler_set_parallel(bench.scene->update_handler, workers > 0);
+    dt_update_handler_init(bench.scene->update_handler);
+
+#ifdef DT_TRACK_ALLOCATIONS
+    dt_alloc_guard_arm(DT_ALLOC_GUARD_RECORD, BENCH_SCENE_WARMUP_FRAMES);
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+    char name[64];
+    if (workers)
+        snprintf(name, sizeof(name), "scene_frame_parallel_%u", size);
+    else
+        snprintf(name, sizeof(name), "scene_frame_%u", size);
+    dt_bench_run(strdup(name), (u64) size * BENCH_SCENE_FRAMES, NULL, run_scene_frames, NULL,
+                 &bench);
+
+#ifdef DT_TRACK_ALLOCATIONS
+    if (dt_alloc_guard_violations() > 0) {
+        dt_alloc_guard_report(stderr);
+        dt_bench_fail("steady state scene frames allocate");
+    }
+    dt_alloc_guard_arm(DT_ALLOC_GUARD_OFF, 0);
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+    dt_update_handler_destroy(bench.scene->update_handler);
+    teardown_scene(&bench);
+    dt_jobs_shutdown();
+}
+
+static bool write_scene(const char* path, const u16 entities) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[WARNING] can't write bench scene: %s\n", path);
+        return false;
+    }
+
+    fprintf(file,
+            "{\n\"manager_config\": {\"dense_size\": %u, \"sparse_size\": %u, "
+            "\"recycle_size\": 16, \"children_size\": 4, \"component_count\": 8, "
+            "\"pools_size\": 8, \"include_mask_count\": 8, \"exclude_mask_count\": 8, "
+            "\"filters_size\": 8},\n"
+            "\"update_systems\": [\"BenchMove\", \"BenchToggle\"],\n\"draw_systems\": [],\n\"entities\": {",
+            entities, entities);
+
+    for (u16 i = 0; i < entities; i++) {
+        fprintf(file,
+                "%s\n\"%u\": {\"components\": ["
+                "{\"name\": \"BenchPosition\", \"values\": {\"x\": %u, \"y\": 0}}, "
+                "{\"name\": \"BenchVelocity\", \"values\": {\"x\": 1, \"y\": 2}}, "
+                "{\"name\": \"BenchHealth\", \"values\": {\"value\": 100}}%s]",
+                i ? "," : "", i, i, i % 2 == 0 ? ", \"BenchEnemy\"" : "");
+
+        if (i > 0)
+            fprintf(file, ", \"parent\": %u", (i - 1) / 4);
+        fputc('}', file);
+    }
+
+    fprintf(file, "\n}\n}\n");
+    const bool ok = !ferror(file);
+    fclose(file);
+
+    return ok;
+}
+
+static void run_scene_load(void* data) {
+    SceneBench* bench = data;
+    bench->scene = dt_add_scene(bench->path);
+}
+
+static void run_scene_frames(void* data) {
+    SceneBench* bench = data;
+
+    for (int i = 0; i < BENCH_SCENE_FRAMES; i++) {
+        dt_update_handler_update(bench->scene->update_handler, &bench->ctx);
+        dt_alloc_frame_mark();
+    }
+}
+
+static void teardown_scene(void* data) {
+    SceneBench* bench = data;
+
+    if (bench->scene)
+        dt_scene_unload_by(bench->scene);
+    bench->scene = NULL;
+}
@@ -0,0 +1,292 @@
+#include <cjson/cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DtBench.h"
+#include "DtTime.h"
+#include "Profiling/DtMeasure.h"
+#include "scheduler/FileHandle.h"
+
+static DT_VEC(DtBenchResult) results = NULL;
+static const char* name_filter = NULL;
+static bool counters_enabled = false;
+static bool failed = false;
+
+static void print_counters(const DtBenchResult* result);
+static const cJSON* find_baseline(const cJSON* benchmarks, const char* name);
+
+/**
+ * @brief notes about machine and build of results, timings are comparable only between equal ones
+ */
+static cJSON* machine_to_json(void);
+static void machine_cpu_name(char* name, size_t size);
+
+void dt_bench_run(const char* name, const u64 ops, const DtBenchAction setup,
+                  const DtBenchAction run, const DtBenchAction teardown, void* data) {
+    if (name_filter && !strstr(name, name_filter))
+        return;
+
+    u64 samples[DT_BENCH_REPEATS];
+    double counters[DT_BENCH_COUNTERS_COUNT] = {0};
+    double sample_counters[DT_BENCH_COUNTERS_COUNT];
+
+    // first run is warm up, caches and pools are grown by it
+    for (int i = -1; i < DT_BENCH_REPEATS; i++) {
+        if (setup)
+            setup(data);
+
+        if (counters_enabled)
+            dt_bench_counters_start();
+
+        const u64 start = dt_time_now_ns();
+        run(data);
+        const u64 duration = dt_time_now_ns() - start;
+
+        if (counters_enabled) {
+            dt_bench_counters_stop(sample_counters);
+            for (int c = 0; c < DT_BENCH_COUNTERS_COUNT && i >= 0; c++)
+                counters[c] = counters[c] < 0 || sample_counters[c] < 0
+                                  ? -1
+                                  : counters[c] + sample_counters[c];
+        }
+
+        if (teardown)
+            teardown(data);
+
+        if (i >= 0)
+            samples[i] = duration;
+    }
+
+    qsort(samples, DT_BENCH_REPEATS, sizeof(u64), dt_measure_compare_u64);
+
+    const u64 divider = ops ? ops : 1;
+    DtBenchResult result = {
+        .name = name,
+        .ops = ops,
+        .ns_per_op = (double) samples[DT_BENCH_REPEATS / 2] / (double) divider,
+        .min_ns_per_op = (double) samples[0] / (double) divider,
+    };
+
+    for (int c = 0; c < DT_BENCH_COUNTERS_COUNT; c++) {
+        result.counters_per_op[c] = counters_enabled && counters[c] >= 0
+                                        ? counters[c] / (double) (divider * DT_BENCH_REPEATS)
+                                        : -1;
+    }
+
+    if (!results)
+        results = DT_VEC_NEW(DtBenchResult, 16);
+    DT_VEC_ADD(results, result);
+
+    fprintf(stderr, "%-32s %12.2f ns/op (min %.2f, %llu ops)\n", name, result.ns_per_op,
+            result.min_ns_per_op, (unsigned long long) ops);
+    if (counters_enabled)
+        print_counters(&result);
+}
+
+const DtBenchResult* dt_bench_results(u16* count) {
+    *count = results ? (u16) dt_vec_count(results) : 0;
+    return results;
+}
+
+void dt_bench_set_filter(const char* filter) { name_filter = filter; }
+
+void dt_bench_fail(const char* reason) {
+    fprintf(stderr, "[WARNING] bench failed: %s\n", reason);
+    failed = true;
+}
+
+bool dt_bench_failed(void) { return failed; }
+
+bool dt_bench_enable_counters(void) {
+    counters_enabled = dt_bench_counters_open();
+    if (!counters_enabled)
+        fprintf(stderr, "[WARNING] hardware counters are unavailable, only time is measured\n");
+
+    return counters_enabled;
+}
+
+bool dt_bench_save(const char* path) {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddItemToObject(root, "machine", machine_to_json());
+    cJSON* benchmarks = cJSON_AddArrayToObject(root, "benchmarks");
+
+    u16 count;
+    const DtBenchResult* list = dt_bench_results(&count);
+    for (u16 i = 0; i < count; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", list[i].name);
+        cJSON_AddNumberToObject(item, "ops", (double) list[i].ops);
+        cJSON_AddNumberToObject(item, "ns_per_op", list[i].ns_per_op);
+        cJSON_AddNumberToObject(item, "min_ns_per_op", list[i].min_ns_per_op);
+
+        cJSON* counters = NULL;
+        for (int c = 0; c < DT_BENCH_COUNTERS_COUNT; c++) {
+            if (list[i].counters_per_op[c] < 0)
+                continue;
+            if (!counters)
+                counters = cJSON_AddObjectToObject(item, "counters_per_op");
+            cJSON_AddNumberToObject(counters, dt_bench_counter_name(c),
+                                    list[i].counters_per_op[c]);
+        }
+
+        cJSON_AddItemToArray(benchmarks, item);
+    }
+
+    char* text = cJSON_Print(root);
+    cJSON_Delete(root);
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[WARNING] can't write bench results: %s\n", path);
+        cJSON_free(text);
+        return false;
+    }
+
+    fputs(text, file);
+    fputc('\n', file);
+    const bool ok = !ferror(file);
+    fclose(file);
+    cJSON_free(text);
+
+    return ok;
+}
+
+bool dt_bench_compare(const char* baseline_path, const double max_regression) {
+    DtMappedFile file;
+    if (!dt_file_map(baseline_path, &file)) {
+        fprintf(stderr, "[WARNING] can't read bench baseline: %s\n", baseline_path);
+        return false;
+    }
+
+    cJSON* root = cJSON_ParseWithLength(file.data, file.size);
+    dt_file_unmap(&file);
+
+    const cJSON* benchmarks = cJSON_GetObjectItem(root, "benchmarks");
+    if (!cJSON_IsArray(benchmarks)) {
+        fprintf(stderr, "[WARNING] bench baseline has no benchmarks: %s\n", baseline_path);
+        cJSON_Delete(root);
+        return false;
+    }
+
+    const cJSON* machine = cJSON_GetObjectItem(root, "machine");
+    const char* cpu = cJSON_GetStringValue(cJSON_GetObjectItem(machine, "cpu"));
+    const char* compiler = cJSON_GetStringValue(cJSON_GetObjectItem(machine, "compiler"));
+    fprintf(stderr, "\nbaseline machine: %s, %s\n", cpu ? cpu : "unknown",
+            compiler ? compiler : "unknown");
+
+    bool ok = true;
+    u16 count;
+    const DtBenchResult* list = dt_bench_results(&count);
+
+    fprintf(stderr, "\n%-32s %12s %12s %9s\n", "benchmark", "baseline", "current", "delta");
+    for (u16 i = 0; i < count; i++) {
+        const cJSON* base = find_baseline(benchmarks, list[i].name);
+        const double base_ns = cJSON_GetNumberValue(cJSON_GetObjectItem(base, "ns_per_op"));
+
+        if (!base || base_ns <= 0) {
+            fprintf(stderr, "%-32s %12s %12.2f %9s\n", list[i].name, "-", list[i].ns_per_op,
+                    "new");
+            continue;
+        }
+
+        const double delta = (list[i].ns_per_op - base_ns) / base_ns * 100.0;
+        const bool regressed = max_regression >= 0 && delta > max_regression;
+        ok &= !regressed;
+
+        fprintf(stderr, "%-32s %12.2f %12.2f %+8.1f%%%s\n", list[i].name, base_ns,
+                list[i].ns_per_op, delta, regressed ? " REGRESSION" : "");
+    }
+
+    cJSON_Delete(root);
+    return ok;
+}
+
+DtEcsManager* dt_bench_manager_new(const u16 entities) {
+    return dt_ecs_manager_new((DtEcsManagerConfig) {
+        .dense_size = entities,
+        .sparse_size = entities,
+        .recycle_size = entities,
+        .children_size = 4,
+        .components_count = 8,
+        .pools_size = 8,
+        .masks_size = 8,
+        .include_mask_count = 8,
+        .exclude_mask_count = 8,
+        .filters_size = 8,
+    });
+}
+
+static const cJSON* find_baseline(const cJSON* benchmarks, const char* name) {
+    const cJSON* item;
+    cJSON_ArrayForEach(item, benchmarks) {
+        const char* item_name = cJSON_GetStringValue(cJSON_GetObjectItem(item, "name"));
+        if (item_name && strcmp(item_name, name) == 0)
+            return item;
+    }
+
+    return NULL;
+}
+
+static void print_counters(const DtBenchResult* result) {
+    fprintf(stderr, "%-32s", "");
+    for (int c = 0; c < DT_BENCH_COUNTERS_COUNT; c++) {
+        if (result->counters_per_op[c] >= 0)
+            fprintf(stderr, " %s %.2f", dt_bench_counter_name(c), result->counters_per_op[c]);
+    }
+
+    const double cycles = result->counters_per_op[DT_BENCH_CYCLES];
+    const double instructions = result->counters_per_op[DT_BENCH_INSTRUCTIONS];
+    if (cycles > 0 && instructions >= 0)
+        fprintf(stderr, " ipc %.2f", instructions / cycles);
+    fputc('\n', stderr);
+}
+
+static cJSON* machine_to_json(void) {
+    char cpu[128];
+    machine_cpu_name(cpu, sizeof(cpu));
+
+    cJSON* machine = cJSON_CreateObject();
+    cJSON_AddStringToObject(machine, "cpu", cpu);
+#if defined(__clang__)
+    cJSON_AddStringToObject(machine, "compiler", __VERSION__);
+#elif defined(__GNUC__)
+    cJSON_AddStringToObject(machine, "compiler", "gcc " __VERSION__);
+#else
+    cJSON_AddStringToObject(machine, "compiler", "unknown");
+#endif /*__clang__*/
+#ifdef __OPTIMIZE__
+    cJSON_AddBoolToObject(machine, "optimized", true);
+#else
+    cJSON_AddBoolToObject(machine, "optimized", false);
+#endif /*__OPTIMIZE__*/
+#ifdef DT_TRACK_ALLOCATIONS
+    cJSON_AddBoolToObject(machine, "track_allocations", true);
+#else
+    cJSON_AddBoolToObject(machine, "track_allocations", false);
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+    return machine;
+}
+
+static void machine_cpu_name(char* name, const size_t size) {
+    snprintf(name, size, "unknown");
+
+#ifdef __linux__
+    FILE* file = fopen("/proc/cpuinfo", "r");
+    if (!file)
+        return;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        const char* value = strchr(line, ':');
+        if (strncmp(line, "model name", 10) != 0 || !value)
+            continue;
+
+        snprintf(name, size, "%s", value + 2);
+        name[strcspn(name, "\n")] = '\0';
+        break;
+    }
+
+    fclose(file);
+#endif /*__linux__*/
+}
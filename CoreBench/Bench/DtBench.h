@@ -0,0 +1,150 @@
+#ifndef DT_BENCH_H
+#define DT_BENCH_H
+
+#include <stdbool.h>
+#include "../Core/DtAllocators.h"
+#include "Ecs/DtEcs.h"
+#include "Ecs/RegisterHandler.h"
+
+/*=============================================================================
+ *                          Компоненты бенчмарков
+ *============================================================================*/
+
+#define BENCH_POSITION(X, name)                                                                    \
+    X(float, x, name)                                                                              \
+    X(float, y, name)
+DT_DEFINE_COMPONENT(BenchPosition, BENCH_POSITION);
+
+#define BENCH_VELOCITY(X, name)                                                                    \
+    X(float, x, name)                                                                              \
+    X(float, y, name)
+DT_DEFINE_COMPONENT(BenchVelocity, BENCH_VELOCITY);
+
+#define BENCH_HEALTH(X, name) X(int, value, name)
+DT_DEFINE_COMPONENT(BenchHealth, BENCH_HEALTH);
+
+#define BENCH_ARMOR(X, name) X(int, value, name)
+DT_DEFINE_COMPONENT(BenchArmor, BENCH_ARMOR);
+
+/**
+ * @brief moves every entity by its velocity, filter is split into chunks for job workers
+ */
+typedef struct {
+    UpdateSystem system;
+    DtEcsFilter* filter;
+
+    DtEcsPool* position_pool;
+    DtEcsPool* velocity_pool;
+    float delta_time;
+} BenchMove;
+
+/**
+ * @brief flips enemy tag of every eighth entity each frame, steady state structural changes
+ */
+typedef struct {
+    UpdateSystem system;
+    DtEcsFilter* filter;
+
+    DtEcsPool* enemy_pool;
+    u32 frame;
+} BenchToggle;
+
+/*=============================================================================
+ *                          Замеры (DtBench)
+ *============================================================================*/
+
+/**
+ * @brief DtEntity is u16, so benchmarks can't use more than 65534 entities per manager
+ */
+#define DT_BENCH_ENTITIES 10000
+#define DT_BENCH_REPEATS 7
+
+typedef void (*DtBenchAction)(void* data);
+
+typedef enum {
+    DT_BENCH_CYCLES,
+    DT_BENCH_INSTRUCTIONS,
+    DT_BENCH_L1D_MISSES,
+    DT_BENCH_LLC_MISSES,
+    DT_BENCH_BRANCH_MISSES,
+    DT_BENCH_COUNTERS_COUNT,
+} DtBenchCounter;
+
+typedef struct {
+    const char* name;
+    u64 ops;
+    double ns_per_op;
+    double min_ns_per_op;
+
+    /**
+     * @brief average of timed repeats per operation, negative if counter wasn't read
+     */
+    double counters_per_op[DT_BENCH_COUNTERS_COUNT];
+} DtBenchResult;
+
+/**
+ * @brief run benchmark DT_BENCH_REPEATS times after one warm up run, only run is timed,
+ * setup and teardown are called around every repeat and may be NULL
+ *
+ * @param ops count of operations done by one run, result is reported per operation
+ */
+void dt_bench_run(const char* name, u64 ops, DtBenchAction setup, DtBenchAction run,
+                  DtBenchAction teardown, void* data);
+
+const DtBenchResult* dt_bench_results(u16* count);
+
+/**
+ * @brief substring filter passed from command line, benchmarks not matching it are skipped
+ */
+void dt_bench_set_filter(const char* filter);
+
+/**
+ * @brief read hardware counters around every timed repeat, timing only is used
+ * when none of counters can be opened
+ *
+ * @return false if counters are unavailable
+ */
+bool dt_bench_enable_counters(void);
+
+bool dt_bench_save(const char* path);
+
+/**
+ * @brief print delta of every result against baseline file
+ *
+ * @param max_regression allowed slowdown in percent, negative value disables the check
+ * @return false if baseline can't be read or some result is slower than allowed
+ */
+bool dt_bench_compare(const char* baseline_path, double max_regression);
+
+DtEcsManager* dt_bench_manager_new(u16 entities);
+
+/*=============================================================================
+ *                     Аппаратные счетчики (perf_event_open)
+ *============================================================================*/
+
+const char* dt_bench_counter_name(DtBenchCounter counter);
+
+/**
+ * @brief open counters of calling thread, unavailable ones are skipped with warning
+ *
+ * @return false if no counter can be opened
+ */
+bool dt_bench_counters_open(void);
+void dt_bench_counters_start(void);
+
+/**
+ * @brief stop counters and read values, unavailable counters are set to -1
+ */
+void dt_bench_counters_stop(double values[DT_BENCH_COUNTERS_COUNT]);
+void dt_bench_counters_close(void);
+
+/**
+ * @brief mark run as failed, results are still saved but exit code is not zero
+ */
+void dt_bench_fail(const char* reason);
+bool dt_bench_failed(void);
+
+void bench_ecs(void);
+void bench_scene(void);
+
+#endif /*DT_BENCH_H*/
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench/DtBench.h"
+#include "Profiling/DtMeasure.h"
+
+#define DEFAULT_RESULTS_PATH "./bench_results.json"
+
+static void print_usage(const char* program);
+
+int main(const int argc, char** argv) {
+    const char* out_path = DEFAULT_RESULTS_PATH;
+    const char* baseline_path = NULL;
+    double max_regression = -1;
+    bool verbose = false;
+    bool counters = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--max-regression") == 0 && i + 1 < argc) {
+            max_regression = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            dt_bench_set_filter(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            counters = true;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!verbose)
+        dt_measure_mute_stdout();
+
+    if (counters)
+        dt_bench_enable_counters();
+
+    bench_ecs();
+    bench_scene();
+    dt_bench_counters_close();
+
+    if (!dt_bench_save(out_path))
+        return 1;
+    fprintf(stderr, "results saved to %s\n", out_path);
+
+    if (baseline_path && !dt_bench_compare(baseline_path, max_regression))
+        return 1;
+
+    return dt_bench_failed() ? 1 : 0;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "usage:\n"
+            "\t%s [--out <results.json>] [--baseline <baseline.json>] "
+            "[--max-regression <percent>] [--filter <name part>] [--counters] [--verbose]\n"
+            "\n"
+            "\tsave baseline: %s --out <baseline.json>\n"
+            "\tcompare with reference machine: %s --baseline CoreBench/baseline.json\n",
+            program, program, program);
+}
@@ -0,0 +1,203 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Profiling/DtAllocTracker.h"
+#include "TestEcs.h"
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static void test_alloc_tracker1(void);
+static void test_alloc_tracker2(void);
+static void test_alloc_tracker3(void);
+static void test_alloc_tracker4(void);
+
+void test_alloc_tracker(void) {
+    printf("\n\t===test_alloc_tracker===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_alloc_tracker1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_alloc_tracker2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_alloc_tracker3();
+    printf("\t\t===test 3 success===\n");
+
+    printf("\n\t\t===test 4 start===\n");
+    test_alloc_tracker4();
+    printf("\t\t===test 4 success===\n");
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static u64 live_bytes(const DtAllocTag tag) {
+    DtAllocStats stats;
+    dt_alloc_get_stats(tag, &stats);
+    return stats.live_bytes;
+}
+
+static void test_alloc_tracker1(void) {
+#ifdef DT_TRACK_ALLOCATIONS
+    const u64 pools_before = live_bytes(DT_ALLOC_POOLS);
+    const u64 filters_before = live_bytes(DT_ALLOC_FILTERS);
+    const u64 info_before = live_bytes(DT_ALLOC_ENTITY_INFO);
+    const u64 containers_before = live_bytes(DT_ALLOC_CONTAINERS);
+
+    DtEcsManager* manager = dt_ecs_manager_new(cfg);
+    for (int i = 0; i < 16; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, NULL);
+    }
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    dt_mask_end(mask);
+
+    assert(live_bytes(DT_ALLOC_POOLS) > pools_before);
+    assert(live_bytes(DT_ALLOC_FILTERS) > filters_before);
+    assert(live_bytes(DT_ALLOC_ENTITY_INFO) > info_before);
+    assert(live_bytes(DT_ALLOC_CONTAINERS) > containers_before);
+
+    DtAllocStats stats;
+    dt_alloc_get_stats(DT_ALLOC_CONTAINERS, &stats);
+    assert(stats.peak_bytes >= stats.live_bytes);
+
+    dt_ecs_manager_free(manager);
+
+    // pools, filters and containers are released with manager
+    assert(live_bytes(DT_ALLOC_POOLS) == pools_before);
+    assert(live_bytes(DT_ALLOC_FILTERS) == filters_before);
+    assert(live_bytes(DT_ALLOC_CONTAINERS) == containers_before);
+#else
+    DtAllocStats stats;
+    assert(!dt_alloc_get_stats(DT_ALLOC_POOLS, &stats));
+    assert(stats.live_bytes == 0);
+#endif /*DT_TRACK_ALLOCATIONS*/
+}
+
+static void test_alloc_tracker2(void) {
+    DtAllocStats stats;
+
+    dt_alloc_frame_mark();
+    void* first = dt_tracked_malloc(100, DT_ALLOC_OTHER);
+    void* second = dt_tracked_calloc(10, 10, DT_ALLOC_OTHER);
+    second = dt_tracked_realloc(second, 300, DT_ALLOC_OTHER);
+    dt_alloc_frame_mark();
+
+    dt_alloc_get_stats(DT_ALLOC_OTHER, &stats);
+#ifdef DT_TRACK_ALLOCATIONS
+    assert(stats.frame_allocs == 3);
+    assert(stats.frame_bytes == 100 + 100 + 300);
+    assert(stats.live_count >= 2);
+#else
+    assert(stats.frame_allocs == 0);
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+    const u64 live = stats.live_bytes;
+    dt_tracked_free(first);
+    dt_tracked_free(second);
+
+    dt_alloc_frame_mark();
+    dt_alloc_get_stats(DT_ALLOC_OTHER, &stats);
+    assert(stats.frame_allocs == 0);
+#ifdef DT_TRACK_ALLOCATIONS
+    assert(stats.live_bytes == live - 400);
+#endif /*DT_TRACK_ALLOCATIONS*/
+}
+
+static void test_alloc_tracker3(void) {
+    DtAllocStats before;
+    DtAllocStats after;
+
+    // untracked memory is released without touching stats
+    dt_alloc_get_stats(DT_ALLOC_OTHER, &before);
+    dt_tracked_free(strdup("untracked"));
+
+    // many blocks force table growth and backward shift on removal
+    void* blocks[10000];
+    for (int i = 0; i < 10000; i++)
+        blocks[i] = dt_tracked_malloc(8, DT_ALLOC_OTHER);
+    for (int i = 0; i < 10000; i += 2)
+        dt_tracked_free(blocks[i]);
+    for (int i = 1; i < 10000; i += 2)
+        dt_tracked_free(blocks[i]);
+
+    dt_alloc_get_stats(DT_ALLOC_OTHER, &after);
+    assert(after.live_bytes == before.live_bytes);
+    assert(after.live_count == before.live_count);
+
+    FILE* null_file = fopen("/dev/null", "w");
+    if (null_file) {
+        dt_alloc_report(null_file);
+        fclose(null_file);
+    }
+}
+
+static void allocating_update(void* data, DtUpdateContext* ctx) {
+    dt_tracked_free(dt_tracked_malloc(16, DT_ALLOC_SYSTEMS));
+}
+
+static void test_alloc_tracker4(void) {
+    DtEcsManager* manager = dt_ecs_manager_new(cfg);
+    UpdateHandler* handler = dt_update_handler_new(manager, 0);
+    UpdateSystem allocating = {.update = allocating_update};
+    dt_update_handler_add(handler, &allocating, "AllocatingUpdate");
+    dt_update_handler_init(handler);
+
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_alloc_guard_arm(DT_ALLOC_GUARD_RECORD, 2);
+
+    // warm up frames may allocate
+    for (int i = 0; i < 2; i++) {
+        assert(!dt_alloc_guard_is_active());
+        dt_update_handler_update(handler, &ctx);
+        dt_alloc_frame_mark();
+    }
+    assert(dt_alloc_guard_violations() == 0);
+
+    // allocations outside of systems aren't checked
+    dt_tracked_free(dt_tracked_malloc(16, DT_ALLOC_OTHER));
+    assert(dt_alloc_guard_violations() == 0);
+
+    dt_update_handler_update(handler, &ctx);
+    dt_alloc_frame_mark();
+
+#ifdef DT_TRACK_ALLOCATIONS
+    assert(dt_alloc_guard_is_active());
+    assert(dt_alloc_guard_violations() == 1);
+
+    FILE* null_file = fopen("/dev/null", "w");
+    if (null_file) {
+        dt_alloc_guard_report(null_file);
+        fclose(null_file);
+    }
+#else
+    assert(!dt_alloc_guard_is_active());
+    assert(dt_alloc_guard_violations() == 0);
+#endif /*DT_TRACK_ALLOCATIONS*/
+
+    dt_alloc_guard_arm(DT_ALLOC_GUARD_OFF, 0);
+    assert(!dt_alloc_guard_is_active());
+    assert(dt_alloc_guard_violations() == 0);
+
+    dt_update_handler_free(handler);
+    dt_ecs_manager_free(manager);
+}
@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <string.h>
 #include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
 
 const DtComponentData** components;
 DtComponentData func_components[5];
@@ -14,6 +15,7 @@ DtComponentData TestDataComponent2_data();
 void test_component_register_1(void);
 void test_component_register_2(void);
 void test_component_register_3(void);
+void test_component_register_4(void);
 
 void test_component_register(void) {
     printf("\n\t===test_component_register===\n");
@@ -32,6 +34,10 @@ void test_component_register(void) {
     test_component_register_3();
     printf("\t\t===test 3 success===\n");
 
+    printf("\n\t\t===test 4 start===\n");
+    test_component_register_4();
+    printf("\t\t===test 4 success===\n");
+
     printf("\n\t\t===SUCCESS===\n\n");
 }
 
@@ -68,3 +74,22 @@ void test_component_register_3(void) {
            100);
     assert(TestDataComponent1_data().filed_attributes_count[0] == 1);
 }
+
+void test_component_register_4(void) {
+    const DtComponentData* data = dt_component_get_data_by_name("TestDataComponent2");
+    DtFieldPlan* plans = dt_component_get_plans(data);
+
+    assert(plans != NULL);
+    assert(plans[0].offset == offsetof(TestDataComponent2, data));
+    assert(plans[0].size == sizeof(char*));
+    assert(plans[0].parse == dt_get_parser_json_to_type("char*"));
+    assert(plans[0].serialize == dt_get_serializer_type_to_json("char*"));
+    assert(dt_component_get_field_index(data, "data") == 0);
+    assert(dt_component_get_field_index(data, "missing") == -1);
+
+    plans[0].parse = NULL;
+    dt_component_invalidate_plans();
+
+    plans = dt_component_get_plans(data);
+    assert(plans[0].parse == dt_get_parser_json_to_type("char*"));
+}
@@ -20,6 +20,11 @@ DT_DEFINE_COMPONENT(TestDataComponent1, TEST_DATA_COMPONENT_1);
 #define TEST_DATA_COMPONENT_2(X, name) X(char*, data, name)
 DT_DEFINE_COMPONENT(TestDataComponent2, TEST_DATA_COMPONENT_2)
 
+typedef struct {
+    DtEntity target;
+    int damage;
+} TestHitEvent;
+
 typedef struct {
     UpdateSystem system;
     DtEcsFilter* filter;
@@ -43,6 +48,23 @@ void test_filter(void);
 void test_component_register(void);
 void test_systems_register(void);
 void test_scene_parse(void);
+void test_scene_binary(void);
+void test_prefab(void);
+void test_snapshot(void);
+void test_scene_saver(void);
+void test_migration(void);
+void test_system_stats(void);
+void test_system_schedule(void);
+void test_jobs(void);
+void test_render_snapshot(void);
+void test_worlds(void);
+void test_events(void);
+void test_observers(void);
+void test_slices(void);
+void test_run_conditions(void);
+void test_fixed_step(void);
+void test_trace(void);
+void test_alloc_tracker(void);
 void test_module_load(void);
 
 #endif /*ECS_MANAGER_TESTS_H*/
@@ -0,0 +1,177 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "Jobs/DtJobs.h"
+#include "TestEcs.h"
+
+#define EVENTS_WORKERS 3
+#define EVENTS_JOBS 16
+#define EVENTS_PER_JOB 200
+#define EVENTS_FRAMES 5
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    DtEventChannel* hits;
+    int frame;
+} HitSender;
+
+typedef struct {
+    UpdateSystem system;
+    DtEventChannel* hits;
+    int received;
+    int last_damage;
+} HitReceiver;
+
+static DtEcsManager* manager;
+
+static void test_events1(void);
+static void test_events2(void);
+static void test_events3(void);
+
+void test_events(void) {
+    printf("\n\t===test_events===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_events1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_events2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_events3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static int damage_sum(DtEventChannel* hits) {
+    int sum = 0;
+    DtEventReader reader;
+    dt_events_begin(&reader, hits);
+    FOREACH(TestHitEvent, hit, &reader.iterator, { sum += hit.damage; });
+
+    return sum;
+}
+
+static void send_hits(void* data) {
+    DtEventChannel* hits = data;
+    for (int i = 0; i < EVENTS_PER_JOB; i++)
+        dt_event_send(hits, &(TestHitEvent) {.target = i, .damage = 1});
+}
+
+static void sender_update(void* data, DtUpdateContext* ctx) {
+    HitSender* sender = data;
+    sender->frame++;
+    dt_event_send(sender->hits, &(TestHitEvent) {.damage = sender->frame});
+}
+
+static void receiver_update(void* data, DtUpdateContext* ctx) {
+    HitReceiver* receiver = data;
+    DtEventReader reader;
+    dt_events_begin(&reader, receiver->hits);
+    FOREACH(TestHitEvent, hit, &reader.iterator, {
+        receiver->received++;
+        receiver->last_damage = hit.damage;
+    });
+}
+
+static void test_events1(void) {
+    DtEventChannel* hits = DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent);
+    assert(hits != NULL);
+    assert(hits == DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent));
+    assert(dt_ecs_manager_get_events(manager, "MissingEvent") == NULL);
+
+    // events are read only after swap
+    dt_event_send(hits, &(TestHitEvent) {.target = 1, .damage = 10});
+    dt_event_send(hits, &(TestHitEvent) {.target = 2, .damage = 20});
+    assert(dt_events_count(hits) == 0);
+
+    dt_ecs_manager_swap_events(manager);
+    assert(dt_events_count(hits) == 2);
+    assert(damage_sum(hits) == 30);
+
+    // readers keep own position, so inner reading doesn't end outer one
+    int pairs = 0;
+    DtEventReader outer;
+    dt_events_begin(&outer, hits);
+    FOREACH(TestHitEvent, hit, &outer.iterator, { pairs += damage_sum(hits) + hit.damage; });
+    assert(pairs == 90);
+
+    // events of previous frame are cleared by next swap
+    dt_event_send(hits, &(TestHitEvent) {.damage = 5});
+    dt_ecs_manager_swap_events(manager);
+    assert(dt_events_count(hits) == 1);
+    assert(damage_sum(hits) == 5);
+
+    dt_ecs_manager_swap_events(manager);
+    assert(dt_events_count(hits) == 0);
+}
+
+static void test_events2(void) {
+    DtEventChannel* hits = DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent);
+
+    // writers of many threads fill more than one block
+    dt_jobs_init(EVENTS_WORKERS);
+    for (int frame = 0; frame < 2; frame++) {
+        DtJobCounter counter = {0};
+        for (int i = 0; i < EVENTS_JOBS; i++)
+            dt_job_submit(send_hits, hits, &counter);
+        dt_job_wait(&counter);
+
+        dt_ecs_manager_swap_events(manager);
+        assert(dt_events_count(hits) == EVENTS_JOBS * EVENTS_PER_JOB);
+        assert(damage_sum(hits) == EVENTS_JOBS * EVENTS_PER_JOB);
+    }
+    dt_jobs_shutdown();
+
+    dt_ecs_manager_swap_events(manager);
+    assert(dt_events_count(hits) == 0);
+}
+
+static void test_events3(void) {
+    HitSender sender = {
+        .system = {.update = sender_update, .priority = 0, .data = &sender},
+        .hits = DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent),
+    };
+    HitReceiver receiver = {
+        .system = {.update = receiver_update, .priority = 1, .data = &receiver},
+        .hits = DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent),
+    };
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 2);
+    dt_update_handler_add(handler, &sender.system, "HitSender");
+    dt_update_handler_add(handler, &receiver.system, "HitReceiver");
+    dt_update_handler_init(handler);
+
+    // receiver gets hit sent during previous frame
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    for (int frame = 0; frame < EVENTS_FRAMES; frame++) {
+        dt_update_handler_update(handler, &ctx);
+        assert(receiver.received == frame);
+        if (frame > 0)
+            assert(receiver.last_damage == frame);
+    }
+
+    dt_update_handler_free(handler);
+}
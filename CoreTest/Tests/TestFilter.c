@@ -1,6 +1,14 @@
 #include <assert.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include "Jobs/DtJobs.h"
 #include "TestEcs.h"
 
+#define PARALLEL_ENTITIES 1000
+#define PARALLEL_CHUNK 16
+#define PARALLEL_WORKERS 3
+
 static DtEcsManager* manager;
 
 static const DtEcsManagerConfig cfg = {
@@ -25,6 +33,24 @@ static DtEntity e3;
 static void test_filter_1(void);
 static void test_filter_2(void);
 static void test_filter_3(void);
+static void test_filter_4(void);
+static void test_filter_5(void);
+static void test_filter_6(void);
+
+typedef struct {
+    DtEcsPool* data_pool;
+    DtEcsPool* tag_pool;
+    atomic_int sum;
+    atomic_int chunks;
+} ParallelData;
+
+typedef struct {
+    DtEcsFilter* filter;
+    DtJobCounter done;
+    atomic_int sum;
+    atomic_int overlaps;
+    atomic_int in_use[PARALLEL_WORKERS + 1];
+} SharedData;
 
 static DtEcsFilter* filter_test_1;
 
@@ -49,6 +75,17 @@ void test_filter(void) {
     test_filter_3();
     printf("\t\t===test 3 success===\n");
 
+    printf("\n\t\t===test 4 start===\n");
+    test_filter_4();
+    printf("\t\t===test 4 success===\n");
+
+    printf("\n\t\t===test 5 start===\n");
+    test_filter_5();
+    printf("\t\t===test 5 success===\n");
+
+    printf("\n\t\t===test 6 start===\n");
+    test_filter_6();
+    printf("\t\t===test 6 success===\n");
 
     dt_ecs_manager_free(manager);
     printf("\n\t\t===SUCCESS===\n\n");
@@ -122,3 +159,140 @@ static void test_filter_3(void) {
         assert(e == e3);
     });
 }
+
+static void parallel_chunk(const DtEntity* entities, const u16 count, DtFilterChunkContext* ctx,
+                           void* user) {
+    ParallelData* data = user;
+
+    // scratch copy keeps values of chunk, commands are applied after pass
+    int* values = dt_arena_alloc(ctx->scratch, sizeof(int) * count);
+    for (u16 i = 0; i < count; i++) {
+        const TestDataComponent1* component = dt_ecs_pool_get(data->data_pool, entities[i]);
+        values[i] = component->data;
+        if (values[i] % 2 == 0)
+            dt_ecs_commands_add(ctx->commands, data->tag_pool, entities[i], NULL);
+    }
+
+    int sum = 0;
+    for (u16 i = 0; i < count; i++)
+        sum += values[i];
+
+    atomic_fetch_add(&data->sum, sum);
+    atomic_fetch_add(&data->chunks, 1);
+}
+
+static void test_filter_4(void) {
+    // entities of previous tests don't fit, manager is replaced
+    dt_ecs_manager_free(manager);
+    manager = dt_ecs_manager_new((DtEcsManagerConfig) {
+        .dense_size = 16,
+        .sparse_size = 16,
+        .recycle_size = 4,
+        .components_count = 4,
+        .pools_size = 4,
+        .masks_size = 1,
+        .children_size = 1,
+        .include_mask_count = 1,
+        .exclude_mask_count = 1,
+        .filters_size = 2,
+    });
+
+    int expected = 0;
+    for (int i = 0; i < PARALLEL_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e,
+                                   &(TestDataComponent1) {i});
+        expected += i;
+    }
+
+    ParallelData data = {
+        .data_pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1),
+        .tag_pool = DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent1),
+    };
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 1);
+    DT_MASK_INC(mask, TestDataComponent1);
+    DT_MASK_EXC(mask, TestEmptyComponent1);
+    DtEcsFilter* filter = dt_mask_end(mask);
+
+    dt_jobs_init(PARALLEL_WORKERS);
+    dt_filter_parallel_for(filter, PARALLEL_CHUNK, parallel_chunk, &data);
+
+    assert(atomic_load(&data.sum) == expected);
+    assert(atomic_load(&data.chunks) == (PARALLEL_ENTITIES + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+    assert(filter->entities.count == PARALLEL_ENTITIES / 2);
+    FOREACH(DtEntity, e, &filter->entities.entities_iterator, {
+        const TestDataComponent1* component = dt_ecs_pool_get(data.data_pool, e);
+        assert(component->data % 2 == 1);
+    });
+
+    // without workers the pass runs on calling thread
+    dt_jobs_shutdown();
+    atomic_store(&data.sum, 0);
+    dt_filter_parallel_for(filter, 0, parallel_chunk, &data);
+    assert(atomic_load(&data.sum) == PARALLEL_ENTITIES * PARALLEL_ENTITIES / 4);
+    assert(filter->entities.count == PARALLEL_ENTITIES / 2);
+}
+
+static void shared_chunk(const DtEntity* entities, const u16 count, DtFilterChunkContext* ctx,
+                         void* user) {
+    SharedData* data = user;
+
+    if (atomic_fetch_add(&data->in_use[ctx->thread], 1) != 0)
+        atomic_fetch_add(&data->overlaps, 1);
+    dt_arena_alloc(ctx->scratch, sizeof(int) * count);
+    usleep(100);
+    atomic_fetch_add(&data->sum, count);
+    atomic_fetch_sub(&data->in_use[ctx->thread], 1);
+}
+
+static void* shared_pass_thread(void* user) {
+    SharedData* data = user;
+    dt_filter_parallel_for(data->filter, PARALLEL_CHUNK, shared_chunk, data);
+    atomic_fetch_sub(&data->done.pending, 1);
+
+    return NULL;
+}
+
+static void test_filter_5(void) {
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    SharedData data = {.filter = dt_mask_end(mask)};
+
+    // pass of thread outside of pool is helped by main thread, they share last index
+    dt_jobs_init(1);
+    atomic_store(&data.done.pending, 1);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, shared_pass_thread, &data) == 0);
+    dt_job_wait(&data.done);
+    pthread_join(thread, NULL);
+    dt_jobs_shutdown();
+
+    assert(atomic_load(&data.sum) == PARALLEL_ENTITIES);
+    assert(atomic_load(&data.overlaps) == 0);
+}
+
+static void test_filter_6(void) {
+    DtEcsPool* data_pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent2);
+    DtEcsPool* tag_pool = DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent2);
+    DtEcsMask mask = dt_mask_new(manager, 2, 0);
+    DT_MASK_INC(mask, TestDataComponent2);
+    DT_MASK_INC(mask, TestEmptyComponent2);
+    DtEcsFilter* filter = dt_mask_end(mask);
+
+    const DtEntity first[] = {0, 1};
+    dt_ecs_pool_add_range(data_pool, first, 2, (TestDataComponent2[]) {{"a"}, {"b"}});
+    dt_ecs_pool_add_range(tag_pool, first, 2, NULL);
+
+    // entities already in pool keep their items and aren't counted twice
+    const DtEntity second[] = {1, 2};
+    dt_ecs_pool_add_range(data_pool, second, 2, (TestDataComponent2[]) {{"c"}, {"d"}});
+    dt_ecs_pool_add_range(tag_pool, second, 2, NULL);
+    assert(data_pool->count == 3 && tag_pool->count == 3);
+    assert(((TestDataComponent2*) dt_ecs_pool_get(data_pool, 1))->data[0] == 'b');
+    assert(((TestDataComponent2*) dt_ecs_pool_get(data_pool, 2))->data[0] == 'd');
+    assert(filter->entities.count == 3);
+
+    const DtEcsManagerConfig config = dt_ecs_manager_get_config(manager);
+    assert(config.masks_size == config.include_mask_count + config.exclude_mask_count);
+}
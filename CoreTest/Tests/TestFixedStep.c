@@ -0,0 +1,173 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+
+#define FIXED_MAX_STEPS 2
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    int fixed_calls;
+    int updates;
+    int fixed_before_update;
+    float fixed_time;
+} FixedSystem;
+
+typedef struct {
+    DrawSystem system;
+    float alpha;
+} AlphaDraw;
+
+static DtEcsManager* manager;
+
+static void test_fixed_step1(void);
+static void test_fixed_step2(void);
+static void test_fixed_step3(void);
+
+void test_fixed_step(void) {
+    printf("\n\t===test_fixed_step===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_fixed_step1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_fixed_step2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_fixed_step3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void fixed_system_fixed_update(void* data, DtUpdateContext* ctx) {
+    FixedSystem* sys = data;
+    sys->fixed_calls++;
+    sys->fixed_time += ctx->fixed_delta_time;
+}
+
+static void fixed_system_update(void* data, DtUpdateContext* ctx) {
+    FixedSystem* sys = data;
+    sys->updates++;
+    sys->fixed_before_update = sys->fixed_calls;
+}
+
+static void alpha_extract(void* data, DtRenderStream* stream) {}
+
+static void alpha_draw_extracted(void* data, const DtRenderStream* stream) {
+    AlphaDraw* sys = data;
+    sys->alpha = dt_current_draw_alpha;
+}
+
+static void alpha_draw(void* data) {
+    AlphaDraw* sys = data;
+    sys->alpha = dt_current_draw_alpha;
+}
+
+static UpdateHandler* fixed_handler_new(FixedSystem* sys) {
+    *sys = (FixedSystem) {
+        .system = {.fixed_update = fixed_system_fixed_update, .update = fixed_system_update,
+                   .data = sys},
+    };
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 1);
+    dt_update_handler_add(handler, &sys->system, "FixedSystem");
+    dt_update_handler_init(handler);
+
+    return handler;
+}
+
+static void test_fixed_step1(void) {
+    FixedSystem sys;
+    UpdateHandler* handler = fixed_handler_new(&sys);
+
+    // short frames take step from time of several frames
+    DtUpdateContext ctx = {.delta_time = 0.25f, .fixed_delta_time = 0.5f};
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == 0 && ctx.alpha == 0.5f);
+    assert(sys.fixed_calls == 0 && sys.updates == 1);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == 1 && ctx.alpha == 0.0f);
+    assert(sys.fixed_before_update == 1);
+
+    // long frame runs several steps before update
+    ctx.delta_time = 1.25f;
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == 2 && ctx.alpha == 0.5f);
+    assert(sys.fixed_before_update == 3 && sys.fixed_time == 1.5f);
+
+    // without fixed_delta_time there is no fixed update
+    ctx.fixed_delta_time = 0.0f;
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == 0 && sys.fixed_calls == 3 && sys.updates == 4);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_fixed_step2(void) {
+    FixedSystem sys;
+    UpdateHandler* handler = fixed_handler_new(&sys);
+    dt_update_handler_set_fixed_max_steps(handler, FIXED_MAX_STEPS);
+
+    // time over max steps is dropped
+    DtUpdateContext ctx = {.delta_time = 5.0f, .fixed_delta_time = 0.5f};
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == FIXED_MAX_STEPS && ctx.alpha == 0.0f);
+    assert(sys.fixed_calls == FIXED_MAX_STEPS);
+
+    ctx.delta_time = 0.25f;
+    dt_update_handler_update(handler, &ctx);
+    assert(ctx.fixed_steps == 0 && sys.fixed_calls == FIXED_MAX_STEPS);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_fixed_step3(void) {
+    AlphaDraw extracted = {
+        .system = {.extract = alpha_extract, .draw_extracted = alpha_draw_extracted,
+                   .data = &extracted},
+    };
+    AlphaDraw live = {
+        .system = {.draw = alpha_draw, .data = &live},
+    };
+
+    DrawHandler* handler = dt_draw_handler_new(manager, 2);
+    dt_draw_handler_add(handler, &extracted.system, "ExtractedAlpha");
+    dt_draw_handler_add(handler, &live.system, "LiveAlpha");
+    dt_draw_handler_init(handler);
+
+    // extracted frame keeps alpha of its update, live pools are at newer one
+    dt_draw_handler_set_alpha(handler, 0.25f);
+    dt_draw_handler_extract(handler);
+    dt_draw_handler_swap(handler);
+    dt_draw_handler_set_alpha(handler, 0.75f);
+    dt_draw_handler_draw(handler);
+
+    assert(extracted.alpha == 0.25f);
+    assert(live.alpha == 0.75f);
+    assert(dt_current_draw_alpha == 0.0f);
+
+    dt_draw_handler_free(handler);
+}
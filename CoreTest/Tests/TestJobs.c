@@ -0,0 +1,166 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#include "Jobs/DtJobs.h"
+#include "TestEcs.h"
+
+#define JOBS_WORKERS 3
+#define JOBS_COUNT 1000
+#define JOBS_NESTED 16
+#define JOBS_OVERFLOW 5000
+
+typedef struct {
+    atomic_uint sum;
+    atomic_uint not_main;
+    DtJobCounter nested;
+} JobsData;
+
+static void test_jobs1(void);
+static void test_jobs2(void);
+static void test_jobs3(void);
+static void test_jobs4(void);
+static void test_jobs5(void);
+
+static atomic_uint marks[JOBS_OVERFLOW];
+
+void test_jobs(void) {
+    printf("\n\t===test_jobs===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_jobs1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_jobs2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_jobs3();
+    printf("\t\t===test 3 success===\n");
+
+    printf("\n\t\t===test 4 start===\n");
+    test_jobs4();
+    printf("\t\t===test 4 success===\n");
+
+    printf("\n\t\t===test 5 start===\n");
+    test_jobs5();
+    printf("\t\t===test 5 success===\n");
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void add_job(void* data) {
+    JobsData* jobs = data;
+    atomic_fetch_add(&jobs->sum, 1);
+}
+
+static void nested_job(void* data) {
+    JobsData* jobs = data;
+    for (int i = 0; i < JOBS_NESTED; i++)
+        dt_job_submit(add_job, jobs, &jobs->nested);
+}
+
+static void main_job(void* data) {
+    JobsData* jobs = data;
+    if (!dt_jobs_is_main_thread())
+        atomic_fetch_add(&jobs->not_main, 1);
+    atomic_fetch_add(&jobs->sum, 1);
+}
+
+static void mark_job(void* data) { atomic_fetch_add((atomic_uint*) data, 1); }
+
+static void* external_thread(void* data) {
+    JobsData* jobs = data;
+    DtJobCounter counter = {0};
+
+    for (int i = 0; i < JOBS_NESTED; i++)
+        dt_job_submit(add_job, jobs, &counter);
+    dt_job_wait(&counter);
+
+    return NULL;
+}
+
+static void test_jobs1(void) {
+    // without workers job runs before submit returns
+    JobsData jobs = {0};
+    DtJobCounter counter = {0};
+
+    dt_job_submit(add_job, &jobs, &counter);
+    dt_job_submit_main(main_job, &jobs, NULL);
+    assert(atomic_load(&jobs.sum) == 2);
+    assert(atomic_load(&counter.pending) == 0);
+    assert(dt_jobs_workers_count() == 0);
+    assert(dt_jobs_is_main_thread());
+}
+
+static void test_jobs2(void) {
+    dt_jobs_init(JOBS_WORKERS);
+    assert(dt_jobs_workers_count() == JOBS_WORKERS);
+    assert(dt_jobs_is_main_thread());
+
+    JobsData jobs = {0};
+    DtJobCounter counter = {0};
+    for (int i = 0; i < JOBS_COUNT; i++)
+        dt_job_submit(add_job, &jobs, &counter);
+
+    dt_job_wait(&counter);
+    assert(atomic_load(&jobs.sum) == JOBS_COUNT);
+    assert(atomic_load(&counter.pending) == 0);
+}
+
+static void test_jobs3(void) {
+    JobsData jobs = {0};
+    DtJobCounter counter = {0};
+
+    // jobs submitted by workers and by threads outside of pool are run too
+    for (int i = 0; i < JOBS_NESTED; i++)
+        dt_job_submit(nested_job, &jobs, &counter);
+    dt_job_wait(&counter);
+    dt_job_wait(&jobs.nested);
+    assert(atomic_load(&jobs.sum) == JOBS_NESTED * JOBS_NESTED);
+
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, external_thread, &jobs) == 0);
+    pthread_join(thread, NULL);
+    assert(atomic_load(&jobs.sum) == JOBS_NESTED * JOBS_NESTED + JOBS_NESTED);
+}
+
+static void test_jobs4(void) {
+    JobsData jobs = {0};
+    DtJobCounter counter = {0};
+
+    for (int i = 0; i < JOBS_NESTED; i++)
+        dt_job_submit_main(main_job, &jobs, &counter);
+
+    // main jobs wait for main thread
+    assert(atomic_load(&jobs.sum) == 0);
+    dt_jobs_run_main();
+    assert(atomic_load(&jobs.sum) == JOBS_NESTED);
+
+    for (int i = 0; i < JOBS_NESTED; i++)
+        dt_job_submit_main(main_job, &jobs, &counter);
+    dt_job_wait(&counter);
+    assert(atomic_load(&jobs.sum) == 2 * JOBS_NESTED);
+    assert(atomic_load(&jobs.not_main) == 0);
+
+    for (int i = 0; i < JOBS_COUNT; i++)
+        dt_job_submit(add_job, &jobs, NULL);
+    dt_jobs_shutdown();
+    assert(atomic_load(&jobs.sum) == 2 * JOBS_NESTED + JOBS_COUNT);
+    assert(dt_jobs_workers_count() == 0);
+}
+
+static void test_jobs5(void) {
+    DtJobCounter counter = {0};
+    dt_jobs_init(JOBS_WORKERS);
+
+    // main jobs stay queued, more of them than ring slots of thread mustn't overwrite others
+    for (int i = 0; i < JOBS_OVERFLOW; i++)
+        dt_job_submit_main(mark_job, &marks[i], &counter);
+    dt_job_wait(&counter);
+
+    for (int i = 0; i < JOBS_OVERFLOW; i++)
+        assert(atomic_load(&marks[i]) == 1);
+    dt_jobs_shutdown();
+}
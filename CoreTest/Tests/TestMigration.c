@@ -0,0 +1,195 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define MIGRATION_ENTITIES 4
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+/**
+ * @brief layout of TestDataComponent1 before reload
+ */
+typedef struct {
+    char* removed;
+    int data;
+} OldTestDataComponent1;
+
+static DtScene scene;
+static DtEcsFilter* data_filter;
+
+static void test_migration1(void);
+static void test_migration2(void);
+static void test_migration3(void);
+
+void test_migration(void) {
+    printf("\n\t===test_migration===\n");
+
+    scene = (DtScene) {
+        .environment = dt_environment_instance(),
+        .manager = dt_ecs_manager_new(cfg),
+    };
+    scene.update_handler = dt_update_handler_new(scene.manager, 0);
+    scene.draw_handler = dt_draw_handler_new(scene.manager, 0);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_migration1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_migration2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_migration3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_update_handler_free(scene.update_handler);
+    dt_draw_handler_free(scene.draw_handler);
+    dt_ecs_manager_free(scene.manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void test_migration1(void) {
+    DtEcsManager* manager = scene.manager;
+
+    for (int i = 0; i < MIGRATION_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(scene.manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(scene.manager, TestDataComponent1, e,
+                                   &(TestDataComponent1) {.data = i * 10});
+        if (i % 2 == 0)
+            DT_ECS_MANAGER_ADD_TO_POOL(scene.manager, TestEmptyComponent1, e, NULL);
+    }
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestEmptyComponent1);
+    data_filter = dt_mask_end(mask);
+
+    const DtComponentPool* pool =
+        DT_ECS_MANAGER_GET_POOL(scene.manager, TestDataComponent1)->data;
+    const void* items = pool->entities.dense_items;
+
+    u16 count;
+    DtComponentLayout* layouts = dt_ecs_manager_capture_layouts(scene.manager, &count);
+    assert(count == dt_vec_count(scene.manager->pools));
+    assert(dt_ecs_manager_migrate(scene.manager, layouts, count));
+    dt_component_layouts_free(layouts, count);
+
+    assert(pool->entities.dense_items == items);
+    for (DtEntity e = 0; e < MIGRATION_ENTITIES; e++)
+        assert(((TestDataComponent1*) dt_entity_container_get(&pool->entities, e))->data ==
+               e * 10);
+    assert(data_filter->entities.count == MIGRATION_ENTITIES / 2);
+}
+
+static void test_migration2(void) {
+    DtEcsPool* data_pool = DT_ECS_MANAGER_GET_POOL(scene.manager, TestDataComponent1);
+    DtComponentPool* pool = data_pool->data;
+
+    u16 count;
+    DtComponentLayout* layouts = dt_ecs_manager_capture_layouts(scene.manager, &count);
+    DtComponentLayout* layout = &layouts[data_pool->ecs_manager_id];
+    assert(strcmp(layout->name, "TestDataComponent1") == 0);
+
+    // pretend that rows were written by library with old layout, its string field is dropped
+    for (u16 f = 0; f < layout->field_count; f++) {
+        DT_FREE(layout->field_names[f]);
+        DT_FREE(layout->field_types[f]);
+    }
+    DT_FREE(layout->field_names);
+    DT_FREE(layout->field_types);
+    DT_FREE(layout->field_offsets);
+    DT_FREE(layout->field_sizes);
+
+    layout->layout_hash = 0;
+    layout->component_size = sizeof(OldTestDataComponent1);
+    layout->field_count = 2;
+    layout->field_names = DT_MALLOC(2 * sizeof(char*));
+    layout->field_names[0] = strdup("removed");
+    layout->field_names[1] = strdup("data");
+    layout->field_types = DT_MALLOC(2 * sizeof(char*));
+    layout->field_types[0] = strdup("char*");
+    layout->field_types[1] = strdup("int");
+    layout->field_offsets = DT_MALLOC(2 * sizeof(u16));
+    layout->field_offsets[0] = offsetof(OldTestDataComponent1, removed);
+    layout->field_offsets[1] = offsetof(OldTestDataComponent1, data);
+    layout->field_sizes = DT_MALLOC(2 * sizeof(u16));
+    layout->field_sizes[0] = sizeof(char*);
+    layout->field_sizes[1] = sizeof(int);
+
+    OldTestDataComponent1* old_items =
+        DT_CALLOC(pool->entities.dense_size, sizeof(OldTestDataComponent1));
+    for (DtEntity row = 0; row < pool->entities.count; row++) {
+        const TestDataComponent1* item =
+            (TestDataComponent1*) pool->entities.dense_items + row;
+        old_items[row] = (OldTestDataComponent1) {.removed = strdup("dropped"),
+                                                  .data = item->data + 1};
+    }
+    DT_FREE(pool->entities.dense_items);
+    pool->entities.dense_items = old_items;
+    pool->entities.item_size = sizeof(OldTestDataComponent1);
+
+    assert(dt_ecs_manager_migrate(scene.manager, layouts, count));
+    dt_component_layouts_free(layouts, count);
+
+    assert(pool->entities.item_size == sizeof(TestDataComponent1));
+    assert(data_pool->count == MIGRATION_ENTITIES);
+    for (DtEntity e = 0; e < MIGRATION_ENTITIES; e++)
+        assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool, e))->data == e * 10 + 1);
+
+    const DtEntity e = dt_ecs_manager_new_entity(scene.manager);
+    DT_ECS_MANAGER_ADD_TO_POOL(scene.manager, TestDataComponent1, e,
+                               &(TestDataComponent1) {.data = 7});
+    assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool, e))->data == 7);
+}
+
+static void test_migration3(void) {
+    dt_update_handler_add(scene.update_handler, dt_update_get_data_by_name("TestUpdate1")->new(),
+                          "TestUpdate1");
+    dt_draw_handler_add(scene.draw_handler, dt_draw_get_data_by_name("TestDraw1")->new(),
+                        "TestDraw1");
+    UpdateSystem* old_update = scene.update_handler->systems[0];
+    DrawSystem* old_draw = scene.draw_handler->systems[0];
+
+    DtSceneReload* reload = dt_scene_reload_begin(&scene);
+    assert(dt_scene_reload_end(&scene, reload));
+
+    assert(dt_vec_count(scene.update_handler->systems) == 1);
+    assert(dt_vec_count(scene.draw_handler->systems) == 1);
+    assert(strcmp(scene.update_handler->names[0], "TestUpdate1") == 0);
+    assert(strcmp(scene.draw_handler->names[0], "TestDraw1") == 0);
+    assert(scene.update_handler->systems[0] != old_update);
+    assert(scene.draw_handler->systems[0] != old_draw);
+
+    DT_FREE(old_update);
+    DT_FREE(old_draw);
+    DT_FREE(scene.update_handler->systems[0]);
+    DT_FREE(scene.draw_handler->systems[0]);
+
+    u16 count;
+    DtComponentLayout* layouts = dt_ecs_manager_capture_layouts(scene.manager, &count);
+    DT_FREE(layouts[0].name);
+    layouts[0].name = strdup("RemovedTestComponent");
+
+    DtEcsPool* pool = scene.manager->pools[0];
+    const char* name = pool->name;
+    assert(!dt_ecs_manager_migrate(scene.manager, layouts, count));
+    assert(pool->name == name);
+    dt_component_layouts_free(layouts, count);
+}
@@ -0,0 +1,174 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+
+#define OBSERVERS_ENTITIES 4
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 2,
+};
+
+typedef struct {
+    UpdateSystem system;
+    DtEcsPool* pool;
+    DtEcsObserver* added;
+    DtEcsObserver* set;
+
+    int added_count;
+    int set_sum;
+} ObserverSystem;
+
+static DtEcsManager* manager;
+static DtEcsPool* data1_pool;
+static DtEcsPool* data2_pool;
+
+static void test_observers1(void);
+static void test_observers2(void);
+static void test_observers3(void);
+
+void test_observers(void) {
+    printf("\n\t===test_observers===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+    data1_pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    data2_pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent2);
+    for (int i = 0; i < OBSERVERS_ENTITIES; i++)
+        dt_ecs_manager_new_entity(manager);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_observers1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_observers2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_observers3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void observer_system_init(DtEcsManager* ecs_manager, void* data) {
+    ObserverSystem* sys = data;
+
+    sys->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestDataComponent1);
+    sys->added = dt_ecs_manager_observe(ecs_manager, DT_OBSERVE_ADD, sys->pool, NULL);
+    sys->set = dt_ecs_manager_observe(ecs_manager, DT_OBSERVE_SET, sys->pool, NULL);
+}
+
+static void observer_system_update(void* data, DtUpdateContext* ctx) {
+    ObserverSystem* sys = data;
+
+    u16 count;
+    dt_ecs_observer_entities(sys->added, &count);
+    sys->added_count += count;
+
+    const DtEntity* entities = dt_ecs_observer_entities(sys->set, &count);
+    for (u16 i = 0; i < count; i++)
+        sys->set_sum += ((TestDataComponent1*) dt_ecs_pool_get(sys->pool, entities[i]))->data;
+}
+
+static void test_observers1(void) {
+    DtEcsObserver* added = dt_ecs_manager_observe(manager, DT_OBSERVE_ADD, data1_pool, NULL);
+
+    dt_ecs_pool_add(data1_pool, 0, &(TestDataComponent1) {1});
+    dt_ecs_pool_add(data1_pool, 1, &(TestDataComponent1) {2});
+    dt_ecs_pool_add(data1_pool, 1, &(TestDataComponent1) {3});
+
+    // added and removed in one frame isn't delivered
+    dt_ecs_pool_add(data1_pool, 2, &(TestDataComponent1) {4});
+    dt_ecs_pool_remove(data1_pool, 2);
+
+    u16 count;
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 0);
+
+    dt_ecs_manager_swap_observers(manager);
+    const DtEntity* entities = dt_ecs_observer_entities(added, &count);
+    assert(count == 2);
+    assert(entities[0] == 0 && entities[1] == 1);
+
+    dt_ecs_manager_swap_observers(manager);
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 0);
+
+    // entity dropped in previous frame may be added again
+    dt_ecs_pool_add(data1_pool, 2, &(TestDataComponent1) {4});
+    dt_ecs_manager_swap_observers(manager);
+    entities = dt_ecs_observer_entities(added, &count);
+    assert(count == 1 && entities[0] == 2);
+}
+
+static void test_observers2(void) {
+    DtEcsMask mask = dt_mask_new(manager, 2, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    DT_MASK_INC(mask, TestDataComponent2);
+    DtEcsFilter* filter = dt_mask_end(mask);
+
+    DtEcsObserver* removed =
+        dt_ecs_manager_observe(manager, DT_OBSERVE_REMOVE, data1_pool, filter);
+
+    dt_ecs_pool_add(data2_pool, 0, &(TestDataComponent2) {"first"});
+    dt_ecs_manager_swap_observers(manager);
+
+    // only entity matching filter before removal is delivered
+    dt_ecs_pool_remove(data1_pool, 0);
+    dt_ecs_pool_remove(data1_pool, 1);
+    dt_ecs_manager_swap_observers(manager);
+
+    u16 count;
+    const DtEntity* entities = dt_ecs_observer_entities(removed, &count);
+    assert(count == 1 && entities[0] == 0);
+
+    dt_ecs_pool_add(data1_pool, 0, &(TestDataComponent1) {5});
+    dt_ecs_manager_kill_entity(manager, 0);
+    dt_ecs_manager_swap_observers(manager);
+    entities = dt_ecs_observer_entities(removed, &count);
+    assert(count == 1 && entities[0] == 0);
+}
+
+static void test_observers3(void) {
+    ObserverSystem sys = {
+        .system = {.init = observer_system_init, .update = observer_system_update,
+                   .data = &sys},
+    };
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 1);
+    dt_update_handler_add(handler, &sys.system, "ObserverSystem");
+    dt_update_handler_init(handler);
+
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_ecs_pool_add(data1_pool, 3, &(TestDataComponent1) {0});
+    dt_update_handler_update(handler, &ctx);
+    assert(sys.added_count == 1);
+
+    // entity set several times in frame is delivered once with last data
+    dt_ecs_pool_set(data1_pool, 3, &(TestDataComponent1) {7});
+    dt_ecs_pool_set(data1_pool, 3, &(TestDataComponent1) {9});
+    ((TestDataComponent1*) dt_ecs_pool_get(data1_pool, 2))->data = 10;
+    dt_ecs_pool_set(data1_pool, 2, NULL);
+    dt_update_handler_update(handler, &ctx);
+    assert(sys.set_sum == 19);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(sys.added_count == 1);
+    assert(sys.set_sum == 19);
+
+    dt_update_handler_free(handler);
+}
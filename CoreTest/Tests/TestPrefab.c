@@ -0,0 +1,140 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define PREFAB_SCENE_PATH "./test_prefab.dt.scene"
+#define PREFAB_COPIES 3
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static DtScene source;
+static DtEcsManager* manager;
+static DtPrefab* prefab;
+static DtEcsFilter* children_filter;
+static DtEntity spawned[PREFAB_COPIES * 2];
+
+static void test_prefab1(void);
+static void test_prefab2(void);
+static void test_prefab3(void);
+
+void test_prefab(void) {
+    printf("\n\t===test_prefab===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_prefab1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_prefab2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_prefab3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_prefab_free(prefab);
+    dt_update_handler_free(source.update_handler);
+    dt_draw_handler_free(source.draw_handler);
+    dt_ecs_manager_free(source.manager);
+    dt_ecs_manager_free(manager);
+    remove(PREFAB_SCENE_PATH);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void test_prefab1(void) {
+    source = (DtScene) {
+        .environment = dt_environment_instance(),
+        .manager = dt_ecs_manager_new(cfg),
+    };
+    source.update_handler = dt_update_handler_new(source.manager, 0);
+    source.draw_handler = dt_draw_handler_new(source.manager, 0);
+
+    const DtEntity unrelated = dt_ecs_manager_new_entity(source.manager);
+    const DtEntity root = dt_ecs_manager_new_entity(source.manager);
+    const DtEntity child = dt_ecs_manager_new_entity(source.manager);
+
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, unrelated,
+                               &(TestDataComponent1) {.data = -1});
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, root,
+                               &(TestDataComponent1) {.data = 7});
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestEmptyComponent1, root, NULL);
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, child,
+                               &(TestDataComponent1) {.data = 8});
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent2, child,
+                               &(TestDataComponent2) {.data = "child"});
+    dt_ecs_manager_set_parent(source.manager, child, root);
+
+    prefab = dt_prefab_new(source.manager, root);
+    assert(prefab != NULL);
+    assert(prefab->entity_count == 2);
+    assert(prefab->parents[0] == DT_ENTITY_NULL);
+    assert(prefab->parents[1] == 0);
+    assert(prefab->column_count == 3);
+}
+
+static void test_prefab2(void) {
+    manager = dt_ecs_manager_new(cfg);
+    dt_ecs_manager_new_entity(manager);
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 1);
+    DT_MASK_INC(mask, TestDataComponent1);
+    DT_MASK_EXC(mask, TestEmptyComponent1);
+    children_filter = dt_mask_end(mask);
+
+    dt_prefab_instantiate(manager, prefab, PREFAB_COPIES, spawned);
+
+    DtEcsPool* data_pool1 = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    DtEcsPool* data_pool2 = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent2);
+    DtEcsPool* tag_pool1 = DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent1);
+
+    assert(children_filter->entities.count == PREFAB_COPIES);
+
+    for (int i = 0; i < PREFAB_COPIES; i++) {
+        const DtEntity root = spawned[i * 2];
+        const DtEntity child = spawned[i * 2 + 1];
+
+        assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool1, root))->data == 7);
+        assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool1, child))->data == 8);
+        assert(strcmp(((TestDataComponent2*) dt_ecs_pool_get(data_pool2, child))->data,
+                      "child") == 0);
+        assert(dt_ecs_pool_has(tag_pool1, root));
+        assert(!dt_ecs_pool_has(tag_pool1, child));
+
+        assert(dt_ecs_manager_get_entity(manager, child).parent == root);
+        assert(dt_ecs_manager_get_entity(manager, root).parent == DT_ENTITY_NULL);
+        assert(dt_ecs_manager_get_entity_components_count(manager, child) >= 2);
+        assert(dt_entity_container_has(&children_filter->entities, child));
+    }
+}
+
+static void test_prefab3(void) {
+    assert(dt_scene_save_json(&source, PREFAB_SCENE_PATH));
+
+    DtPrefab* loaded = dt_prefab_load(PREFAB_SCENE_PATH);
+    assert(loaded != NULL);
+    assert(loaded->entity_count == 3);
+
+    const DtEntity before = manager->entities_ptr;
+    dt_prefab_instantiate(manager, loaded, 2, NULL);
+    assert(manager->entities_ptr == before + 6);
+    assert(children_filter->entities.count == PREFAB_COPIES + 4);
+
+    dt_prefab_free(loaded);
+}
@@ -9,6 +9,7 @@ DT_REGISTER_TAG(TestEmptyComponent1, {
 DT_REGISTER_TAG(TestEmptyComponent2);
 DT_REGISTER_COMPONENT(TestDataComponent1, TEST_DATA_COMPONENT_1);
 DT_REGISTER_COMPONENT(TestDataComponent2, TEST_DATA_COMPONENT_2);
+DT_REGISTER_EVENT(TestHitEvent);
 
 static void module_update_init(DtEcsManager* manager, void* data);
 static void module_update_update(void* data, DtUpdateContext* ctx);
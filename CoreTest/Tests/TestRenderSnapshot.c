@@ -0,0 +1,221 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "Jobs/DtJobs.h"
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define SNAPSHOT_ENTITIES 4
+#define SNAPSHOT_FRAMES 20
+#define SNAPSHOT_WORKERS 2
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    DrawSystem system;
+    DtEcsFilter* filter;
+    DtEcsPool* pool;
+
+    int drawn_sum;
+    u32 drawn_count;
+    int live_draws;
+} SnapshotDraw;
+
+typedef struct {
+    UpdateSystem system;
+    DtEcsFilter* filter;
+    DtEcsPool* pool;
+} SnapshotUpdate;
+
+static DtEcsManager* manager;
+
+static void test_render_snapshot1(void);
+static void test_render_snapshot2(void);
+static int data_sum(void);
+
+void test_render_snapshot(void) {
+    printf("\n\t===test_render_snapshot===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+    for (int i = 0; i < SNAPSHOT_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, &(TestDataComponent1) {i});
+    }
+
+    printf("\n\t\t===test 1 start===\n");
+    test_render_snapshot1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_render_snapshot2();
+    printf("\t\t===test 2 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void snapshot_init(DtEcsManager* ecs_manager, void* data) {
+    SnapshotDraw* draw = data;
+
+    DtEcsMask mask = dt_mask_new(ecs_manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    draw->filter = dt_mask_end(mask);
+    draw->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestDataComponent1);
+}
+
+static void snapshot_extract(void* data, DtRenderStream* stream) {
+    SnapshotDraw* draw = data;
+
+    const u16 count = draw->filter->entities.count;
+    int* items = dt_render_stream_reserve(stream, sizeof(int), count);
+    for (u16 i = 0; i < count; i++) {
+        const TestDataComponent1* component =
+            dt_ecs_pool_get(draw->pool, draw->filter->entities.entities[i]);
+        items[i] = component->data;
+    }
+}
+
+static void snapshot_draw(void* data, const DtRenderStream* stream) {
+    SnapshotDraw* draw = data;
+    const int* items = stream->items;
+
+    draw->drawn_sum = 0;
+    draw->drawn_count = stream->count;
+    for (u32 i = 0; i < stream->count; i++)
+        draw->drawn_sum += items[i];
+}
+
+static void live_draw(void* data) {
+    SnapshotDraw* draw = data;
+    draw->live_draws++;
+    draw->drawn_sum = data_sum();
+}
+
+static void snapshot_update_init(DtEcsManager* ecs_manager, void* data) {
+    SnapshotUpdate* update = data;
+
+    DtEcsMask mask = dt_mask_new(ecs_manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    update->filter = dt_mask_end(mask);
+    update->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestDataComponent1);
+}
+
+static void snapshot_update(void* data, DtUpdateContext* ctx) {
+    SnapshotUpdate* update = data;
+
+    FOREACH(DtEntity, e, &update->filter->entities.entities_iterator, {
+        TestDataComponent1* component = dt_ecs_pool_get(update->pool, e);
+        component->data++;
+    });
+}
+
+static int data_sum(void) {
+    int sum = 0;
+    const DtEcsPool* pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    for (DtEntity e = 0; e < SNAPSHOT_ENTITIES; e++)
+        sum += ((TestDataComponent1*) dt_ecs_pool_get(pool, e))->data;
+
+    return sum;
+}
+
+static void test_render_snapshot1(void) {
+    SnapshotDraw extracted = {
+        .system = {.init = snapshot_init, .extract = snapshot_extract,
+                   .draw_extracted = snapshot_draw, .priority = 1, .data = &extracted},
+    };
+    SnapshotDraw live = {
+        .system = {.init = snapshot_init, .draw = live_draw, .data = &live},
+    };
+
+    // sort by priority keeps streams of systems in place
+    DrawHandler* handler = dt_draw_handler_new(manager, 2);
+    dt_draw_handler_add(handler, &extracted.system, "Extracted");
+    dt_draw_handler_add(handler, &live.system, "Live");
+    dt_draw_handler_init(handler);
+    assert(handler->systems[0] == &live.system);
+
+    dt_draw_handler_draw(handler);
+    assert(extracted.drawn_count == 0);
+    assert(live.live_draws == 1);
+
+    // extracted frame is hidden until swap
+    dt_draw_handler_extract(handler);
+    dt_draw_handler_draw(handler);
+    assert(extracted.drawn_count == 0);
+
+    dt_draw_handler_swap(handler);
+    dt_draw_handler_draw(handler);
+    assert(extracted.drawn_count == SNAPSHOT_ENTITIES);
+    assert(extracted.drawn_sum == data_sum());
+    assert(live.live_draws == 3);
+
+    dt_draw_handler_free(handler);
+}
+
+static void test_render_snapshot2(void) {
+    SnapshotDraw draw = {
+        .system = {.init = snapshot_init, .extract = snapshot_extract,
+                   .draw_extracted = snapshot_draw, .data = &draw},
+    };
+    SnapshotDraw live = {
+        .system = {.init = snapshot_init, .draw = live_draw, .priority = 1, .data = &live},
+    };
+    SnapshotUpdate update = {
+        .system = {.init = snapshot_update_init, .update = snapshot_update, .data = &update},
+    };
+
+    DtScene scene = {
+        .name = "snapshot",
+        .manager = manager,
+        .update_handler = dt_update_handler_new(manager, 1),
+        .draw_handler = dt_draw_handler_new(manager, 2),
+    };
+    dt_update_handler_add(scene.update_handler, &update.system, "SnapshotUpdate");
+    dt_draw_handler_add(scene.draw_handler, &draw.system, "SnapshotDraw");
+    dt_draw_handler_add(scene.draw_handler, &live.system, "SnapshotLive");
+    dt_update_handler_init(scene.update_handler);
+    dt_draw_handler_init(scene.draw_handler);
+
+    DtFramePipeline pipeline = {
+        .scene = &scene,
+        .ctx = {.delta_time = 0.1f},
+    };
+
+    // frame is drawn while next one is updated, so drawing lags one frame behind
+    dt_jobs_init(SNAPSHOT_WORKERS);
+    int previous_sum = data_sum();
+    for (int frame = 0; frame < SNAPSHOT_FRAMES; frame++) {
+        dt_frame_pipeline_begin(&pipeline);
+        dt_draw_handler_draw(scene.draw_handler);
+        dt_frame_pipeline_end(&pipeline);
+
+        if (frame > 0)
+            assert(draw.drawn_sum == previous_sum);
+        previous_sum = data_sum();
+
+        // systems without extract wait for update instead of racing with it
+        assert(live.live_draws == frame + 1);
+        assert(live.drawn_sum == previous_sum);
+    }
+    dt_jobs_shutdown();
+
+    dt_draw_handler_draw(scene.draw_handler);
+    assert(draw.drawn_sum == data_sum());
+
+    dt_update_handler_free(scene.update_handler);
+    dt_draw_handler_free(scene.draw_handler);
+}
@@ -0,0 +1,197 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+
+#define RUN_FRAMES 6
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 2,
+};
+
+typedef struct {
+    UpdateSystem system;
+    int calls;
+    float delta_sum;
+} CountedUpdate;
+
+typedef struct {
+    DrawSystem system;
+    int extracts;
+    int draws;
+} CountedDraw;
+
+static DtEcsManager* manager;
+static DtEcsPool* data1_pool;
+
+static void test_run_conditions1(void);
+static void test_run_conditions2(void);
+static void test_run_conditions3(void);
+
+void test_run_conditions(void) {
+    printf("\n\t===test_run_conditions===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+    data1_pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    dt_ecs_manager_new_entity(manager);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_run_conditions1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_run_conditions2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_run_conditions3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void counted_update(void* data, DtUpdateContext* ctx) {
+    CountedUpdate* sys = data;
+    sys->calls++;
+    sys->delta_sum += ctx->delta_time;
+}
+
+static void counted_extract(void* data, DtRenderStream* stream) {
+    CountedDraw* sys = data;
+    sys->extracts++;
+}
+
+static void counted_draw_extracted(void* data, const DtRenderStream* stream) {
+    CountedDraw* sys = data;
+    sys->draws++;
+}
+
+static void counted_draw(void* data) {
+    CountedDraw* sys = data;
+    sys->draws++;
+}
+
+static DtEcsFilter* data1_filter(void) {
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    return dt_mask_end(mask);
+}
+
+static void test_run_conditions1(void) {
+    CountedUpdate every = {
+        .system = {.update = counted_update, .data = &every, .run_if = {.every_frames = 3}},
+    };
+    CountedUpdate rate = {
+        .system = {.update = counted_update, .data = &rate, .run_if = {.rate_hz = 2.0f}},
+    };
+    CountedUpdate always = {
+        .system = {.update = counted_update, .data = &always},
+    };
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 3);
+    dt_update_handler_add(handler, &every.system, "EverySystem");
+    dt_update_handler_add(handler, &rate.system, "RateSystem");
+    dt_update_handler_add(handler, &always.system, "AlwaysSystem");
+    dt_update_handler_init(handler);
+
+    // timed systems get time since their previous run
+    DtUpdateContext ctx = {.delta_time = 0.25f};
+    for (int frame = 0; frame < RUN_FRAMES; frame++)
+        dt_update_handler_update(handler, &ctx);
+
+    assert(every.calls == RUN_FRAMES / 3 && every.delta_sum == 1.5f);
+    assert(rate.calls == RUN_FRAMES / 2 && rate.delta_sum == 1.5f);
+    assert(always.calls == RUN_FRAMES && always.delta_sum == 1.5f);
+    assert(ctx.delta_time == 0.25f);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_run_conditions2(void) {
+    CountedUpdate filtered = {
+        .system = {.update = counted_update, .data = &filtered,
+                   .run_if = {.filter = data1_filter()}},
+    };
+    CountedUpdate watching = {
+        .system = {.update = counted_update, .data = &watching,
+                   .run_if = {.watch = {
+                                  dt_ecs_manager_observe(manager, DT_OBSERVE_ADD, data1_pool,
+                                                         NULL),
+                                  dt_ecs_manager_observe(manager, DT_OBSERVE_SET, data1_pool,
+                                                         NULL),
+                              }}},
+    };
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 2);
+    dt_update_handler_add(handler, &filtered.system, "FilteredSystem");
+    dt_update_handler_add(handler, &watching.system, "WatchingSystem");
+    dt_update_handler_init(handler);
+
+    // nothing to do while filter is empty and nothing changed
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_update_handler_update(handler, &ctx);
+    dt_update_handler_update(handler, &ctx);
+    assert(filtered.calls == 0 && watching.calls == 0);
+
+    // change is seen by systems of next frame only
+    dt_ecs_pool_add(data1_pool, 0, &(TestDataComponent1) {1});
+    dt_update_handler_update(handler, &ctx);
+    assert(filtered.calls == 1 && watching.calls == 1);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(filtered.calls == 2 && watching.calls == 1);
+
+    dt_ecs_pool_set(data1_pool, 0, &(TestDataComponent1) {2});
+    dt_update_handler_update(handler, &ctx);
+    assert(filtered.calls == 3 && watching.calls == 2);
+
+    dt_ecs_pool_remove(data1_pool, 0);
+    dt_update_handler_update(handler, &ctx);
+    assert(filtered.calls == 3 && watching.calls == 2);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_run_conditions3(void) {
+    CountedDraw extracted = {
+        .system = {.extract = counted_extract, .draw_extracted = counted_draw_extracted,
+                   .data = &extracted, .run_if = {.filter = data1_filter()}},
+    };
+    CountedDraw live = {
+        .system = {.draw = counted_draw, .data = &live, .run_if = {.every_frames = 2}},
+    };
+
+    DrawHandler* handler = dt_draw_handler_new(manager, 2);
+    dt_draw_handler_add(handler, &extracted.system, "ExtractedDraw");
+    dt_draw_handler_add(handler, &live.system, "LiveDraw");
+    dt_draw_handler_init(handler);
+
+    // skipped extract skips draw of its frame
+    for (int frame = 0; frame < RUN_FRAMES; frame++) {
+        if (frame == 2)
+            dt_ecs_pool_add(data1_pool, 0, &(TestDataComponent1) {3});
+
+        dt_draw_handler_extract(handler);
+        dt_draw_handler_swap(handler);
+        dt_draw_handler_draw(handler);
+    }
+
+    assert(extracted.extracts == RUN_FRAMES - 2);
+    assert(extracted.draws == RUN_FRAMES - 2);
+    assert(live.draws == RUN_FRAMES / 2);
+
+    dt_draw_handler_free(handler);
+}
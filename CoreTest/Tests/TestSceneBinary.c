@@ -0,0 +1,105 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define BINARY_SCENE_PATH "./test_scene_binary.dt.bscene"
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static DtScene source;
+static DtScene* loaded;
+
+static void test_scene_binary1(void);
+static void test_scene_binary2(void);
+static void test_scene_binary3(void);
+
+void test_scene_binary(void) {
+    printf("\n\t===test_scene_binary===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_scene_binary1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_scene_binary2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_scene_binary3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(loaded->manager);
+    dt_ecs_manager_free(source.manager);
+    remove(BINARY_SCENE_PATH);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void test_scene_binary1(void) {
+    source = (DtScene) {
+        .environment = dt_environment_instance(),
+        .manager = dt_ecs_manager_new(cfg),
+    };
+    source.update_handler = dt_update_handler_new(source.manager, 0);
+    source.draw_handler = dt_draw_handler_new(source.manager, 0);
+
+    for (int i = 0; i < 5; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(source.manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, e,
+                                   &(TestDataComponent1) {.data = i * 10});
+        if (i % 2 == 0)
+            DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestEmptyComponent1, e, NULL);
+    }
+
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent2, 1,
+                               &(TestDataComponent2) {.data = strdup("text data")});
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent2, 3,
+                               &(TestDataComponent2) {.data = NULL});
+
+    dt_ecs_manager_set_parent(source.manager, 2, 0);
+    dt_ecs_manager_kill_entity(source.manager, 4);
+
+    assert(dt_scene_save_binary(&source, BINARY_SCENE_PATH));
+
+    loaded = dt_scene_parse_binary(BINARY_SCENE_PATH, dt_environment_instance());
+    assert(loaded != NULL);
+    assert(loaded->manager->entities_ptr == source.manager->entities_ptr);
+}
+
+static void test_scene_binary2(void) {
+    DtEcsPool* data_pool1 = DT_ECS_MANAGER_GET_POOL(loaded->manager, TestDataComponent1);
+    DtEcsPool* data_pool2 = DT_ECS_MANAGER_GET_POOL(loaded->manager, TestDataComponent2);
+    DtEcsPool* tag_pool1 = DT_ECS_MANAGER_GET_POOL(loaded->manager, TestEmptyComponent1);
+
+    for (DtEntity e = 0; e < 4; e++) {
+        assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool1, e))->data == e * 10);
+        assert(dt_ecs_pool_has(tag_pool1, e) == (e % 2 == 0));
+    }
+
+    assert(strcmp(((TestDataComponent2*) dt_ecs_pool_get(data_pool2, 1))->data, "text data") == 0);
+    assert(((TestDataComponent2*) dt_ecs_pool_get(data_pool2, 3))->data == NULL);
+    assert(!dt_ecs_pool_has(data_pool2, 0));
+}
+
+static void test_scene_binary3(void) {
+    assert(dt_ecs_manager_get_entity(loaded->manager, 2).parent == 0);
+    assert(dt_ecs_manager_get_entity(loaded->manager, 0).parent == DT_ENTITY_NULL);
+    assert(!dt_ecs_manager_get_entity(loaded->manager, 4).alive);
+    assert(dt_ecs_manager_get_entity_components_count(loaded->manager, 2) == 2);
+}
@@ -11,6 +11,8 @@
 static void test_scene_parse1(void);
 static void test_scene_parse2(void);
 static void test_scene_parse3(void);
+static void test_scene_parse4(void);
+static void test_scene_parse5(void);
 
 static const DtScene* scene;
 
@@ -29,6 +31,14 @@ void test_scene_parse(void) {
     test_scene_parse3();
     printf("\t\t===test 3 success===\n");
 
+    printf("\n\t\t===test 4 start===\n");
+    test_scene_parse4();
+    printf("\t\t===test 4 success===\n");
+
+    printf("\n\t\t===test 5 start===\n");
+    test_scene_parse5();
+    printf("\t\t===test 5 success===\n");
+
     printf("\n\t\t===SUCCESS===\n\n");
 }
 
@@ -63,3 +73,43 @@ static void test_scene_parse3(void) {
     assert(dt_ecs_manager_get_entity(scene->manager, 2).parent == 0);
     assert(dt_ecs_manager_get_entity(scene->manager, 3).parent == 0);
 }
+
+static void test_scene_parse4(void) {
+    const DtScene* stream_scene = dt_add_scene_from_json(
+        "{\"unknown\": {\"nested\": [1, {\"a\": null}, true]},"
+        " \"entities\": {\"0\": {\"components\": [{\"values\": {\"data\": \"a\\\"b\\n\\u00e9\"},"
+        " \"name\": \"TestDataComponent2\"}, \"TestEmptyComponent2\"]},"
+        " \"1\": {\"parent\": 0, \"components\": [{\"name\": \"TestDataComponent1\","
+        " \"values\": {\"missing\": [1, 2], \"data\": -7}}]}}}",
+        "test_scene_stream");
+    assert(stream_scene != NULL);
+
+    DtEcsPool* data_pool1 = DT_ECS_MANAGER_GET_POOL(stream_scene->manager, TestDataComponent1);
+    DtEcsPool* data_pool2 = DT_ECS_MANAGER_GET_POOL(stream_scene->manager, TestDataComponent2);
+    DtEcsPool* tag_pool2 = DT_ECS_MANAGER_GET_POOL(stream_scene->manager, TestEmptyComponent2);
+
+    const TestDataComponent2* text = dt_ecs_pool_get(data_pool2, 0);
+    assert(strcmp(text->data, "a\"b\n\xc3\xa9") == 0);
+    assert(dt_ecs_pool_has(tag_pool2, 0));
+    assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool1, 1))->data == -7);
+    assert(dt_ecs_manager_get_entity(stream_scene->manager, 1).parent == 0);
+
+    assert(dt_add_scene_from_json("{\"entities\": {\"0\": {\"components\": [}}", "broken") == NULL);
+}
+
+static void test_scene_parse5(void) {
+    dt_scene_unload(SCENE_NAME);
+    assert(!dt_scenes_scene_is_loaded(SCENE_NAME));
+    assert(dt_scenes_get_active() == NULL);
+
+    // scenes of directory are found by extension
+    dt_add_scenes(".");
+    assert(dt_scenes_scene_is_loaded(SCENE_NAME));
+
+    dt_scenes_set_active(SCENE_NAME);
+    scene = dt_scenes_get_active();
+    assert(scene != NULL && strcmp(scene->name, SCENE_NAME) == 0);
+    assert(((TestDataComponent1*) dt_ecs_pool_get(
+                DT_ECS_MANAGER_GET_POOL(scene->manager, TestDataComponent1), 0))
+               ->data == 10);
+}
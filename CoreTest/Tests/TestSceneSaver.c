@@ -0,0 +1,149 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define SAVER_SCENE_PATH "./test_scene_saver.dt.scene"
+#define SAVER_SCENE_TMP_PATH SAVER_SCENE_PATH ".tmp"
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static DtScene source;
+static DtSceneSaver* saver;
+
+static void test_scene_saver1(void);
+static void test_scene_saver2(void);
+static void test_scene_saver3(void);
+static void test_scene_saver4(void);
+
+void test_scene_saver(void) {
+    printf("\n\t===test_scene_saver===\n");
+
+    source = (DtScene) {
+        .environment = dt_environment_instance(),
+        .manager = dt_ecs_manager_new(cfg),
+    };
+    source.update_handler = dt_update_handler_new(source.manager, 0);
+    source.draw_handler = dt_draw_handler_new(source.manager, 0);
+    saver = dt_scene_saver_new();
+
+    printf("\n\t\t===test 1 start===\n");
+    test_scene_saver1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_scene_saver2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_scene_saver3();
+    printf("\t\t===test 3 success===\n");
+
+    printf("\n\t\t===test 4 start===\n");
+    test_scene_saver4();
+    printf("\t\t===test 4 success===\n");
+
+    dt_scene_saver_free(saver);
+    dt_update_handler_free(source.update_handler);
+    dt_draw_handler_free(source.draw_handler);
+    dt_ecs_manager_free(source.manager);
+    remove(SAVER_SCENE_PATH);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static int saved_data(DtEntity entity) {
+    const DtScene* loaded = dt_add_scene(SAVER_SCENE_PATH);
+    assert(loaded != NULL);
+
+    DtEcsPool* pool = DT_ECS_MANAGER_GET_POOL(loaded->manager, TestDataComponent1);
+    const TestDataComponent1* component = dt_ecs_pool_get(pool, entity);
+    const int data = component ? component->data : -1;
+
+    dt_scene_unload_by(loaded);
+
+    return data;
+}
+
+static void test_scene_saver1(void) {
+    for (int i = 0; i < 3; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(source.manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, e,
+                                   &(TestDataComponent1) {.data = i});
+    }
+    dt_ecs_manager_set_parent(source.manager, 2, 0);
+
+    assert(dt_scene_saver_save_async(saver, &source, SAVER_SCENE_PATH));
+    assert(dt_scene_saver_wait(saver));
+
+    FILE* tmp = fopen(SAVER_SCENE_TMP_PATH, "r");
+    assert(tmp == NULL);
+
+    for (DtEntity e = 0; e < 3; e++)
+        assert(saved_data(e) == e);
+}
+
+static void test_scene_saver2(void) {
+    DtEcsPool* pool = DT_ECS_MANAGER_GET_POOL(source.manager, TestDataComponent1);
+
+    ((TestDataComponent1*) dt_ecs_pool_get(pool, 1))->data = 10;
+    dt_scene_saver_mark_dirty(saver, 1);
+
+    // not marked, so cached text of entity is kept
+    ((TestDataComponent1*) dt_ecs_pool_get(pool, 0))->data = 20;
+
+    const DtEntity e = dt_ecs_manager_new_entity(source.manager);
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, e,
+                               &(TestDataComponent1) {.data = 30});
+
+    assert(dt_scene_saver_save_async(saver, &source, SAVER_SCENE_PATH));
+    assert(dt_scene_saver_wait(saver));
+
+    assert(saved_data(0) == 0);
+    assert(saved_data(1) == 10);
+    assert(saved_data(2) == 2);
+    assert(saved_data(3) == 30);
+}
+
+static void test_scene_saver3(void) {
+    dt_scene_saver_mark_all(saver);
+    assert(dt_scene_saver_save_async(saver, &source, SAVER_SCENE_PATH));
+
+    // entities are copied before return, so scene can change while file is written
+    DtEcsPool* pool = DT_ECS_MANAGER_GET_POOL(source.manager, TestDataComponent1);
+    ((TestDataComponent1*) dt_ecs_pool_get(pool, 0))->data = 40;
+    assert(dt_scene_saver_wait(saver));
+
+    assert(saved_data(0) == 20);
+
+    const DtScene* loaded = dt_add_scene(SAVER_SCENE_PATH);
+    assert(dt_ecs_manager_get_entity(loaded->manager, 2).parent == 0);
+    dt_scene_unload_by(loaded);
+}
+
+static void test_scene_saver4(void) {
+    // replaced manager may get address of freed one, cache is dropped by caller
+    dt_ecs_manager_free(source.manager);
+    source.manager = dt_ecs_manager_new(cfg);
+    const DtEntity e = dt_ecs_manager_new_entity(source.manager);
+    DT_ECS_MANAGER_ADD_TO_POOL(source.manager, TestDataComponent1, e, &(TestDataComponent1) {7});
+
+    dt_scene_saver_mark_all(saver);
+    assert(dt_scene_saver_save_async(saver, &source, SAVER_SCENE_PATH));
+    assert(dt_scene_saver_wait(saver));
+    assert(saved_data(e) == 7);
+}
@@ -0,0 +1,160 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+
+#define SLICES_STEPS 3
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    int step;
+    int calls;
+    int done;
+    int updates;
+} SlicedSystem;
+
+static DtEcsManager* manager;
+
+static void test_slices1(void);
+static void test_slices2(void);
+static void test_slices3(void);
+
+void test_slices(void) {
+    printf("\n\t===test_slices===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_slices1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_slices2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_slices3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void sliced_update(void* data, DtUpdateContext* ctx) {
+    SlicedSystem* sys = data;
+    sys->updates++;
+}
+
+static DtSliceResult sliced_slice(void* data, DtSliceContext* ctx) {
+    SlicedSystem* sys = data;
+    sys->calls++;
+
+    DT_SLICE_BEGIN(ctx);
+    for (sys->step = 0; sys->step < SLICES_STEPS; sys->step++)
+        DT_SLICE_YIELD(ctx);
+    sys->done++;
+    DT_SLICE_END(ctx);
+}
+
+static SlicedSystem sliced_system_new(SlicedSystem* sys, const i16 priority) {
+    return (SlicedSystem) {
+        .system = {.update = sliced_update, .slice = sliced_slice, .priority = priority,
+                   .data = sys},
+    };
+}
+
+static void test_slices1(void) {
+    SlicedSystem sys;
+    sys = sliced_system_new(&sys, 0);
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 1);
+    dt_update_handler_add(handler, &sys.system, "SlicedSystem");
+    dt_update_handler_init(handler);
+    dt_update_handler_set_slice_budget(handler, 0);
+
+    // without budget slice is called once per frame and resumes after yield
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    for (int frame = 0; frame < SLICES_STEPS; frame++) {
+        dt_update_handler_update(handler, &ctx);
+        assert(sys.calls == frame + 1);
+        assert(sys.step == frame);
+        assert(sys.done == 0);
+    }
+
+    dt_update_handler_update(handler, &ctx);
+    assert(sys.done == 1);
+    assert(sys.updates == SLICES_STEPS + 1);
+
+    // work starts again after done
+    dt_update_handler_update(handler, &ctx);
+    assert(sys.step == 0 && sys.done == 1);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_slices2(void) {
+    SlicedSystem first;
+    SlicedSystem second;
+    first = sliced_system_new(&first, 0);
+    second = sliced_system_new(&second, 1);
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 2);
+    dt_update_handler_add(handler, &first.system, "FirstSliced");
+    dt_update_handler_add(handler, &second.system, "SecondSliced");
+    dt_update_handler_init(handler);
+    dt_update_handler_set_slice_budget(handler, 0);
+
+    // spent budget gives turn to next system in next frame
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_update_handler_update(handler, &ctx);
+    assert(first.calls == 1 && second.calls == 0);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(first.calls == 1 && second.calls == 1);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(first.calls == 2 && second.calls == 1);
+    assert(first.updates == 3 && second.updates == 3);
+
+    dt_update_handler_free(handler);
+}
+
+static void test_slices3(void) {
+    SlicedSystem first;
+    SlicedSystem second;
+    first = sliced_system_new(&first, 0);
+    second = sliced_system_new(&second, 1);
+
+    UpdateHandler* handler = dt_update_handler_new(manager, 2);
+    dt_update_handler_add(handler, &first.system, "FirstSliced");
+    dt_update_handler_add(handler, &second.system, "SecondSliced");
+    dt_update_handler_init(handler);
+    dt_update_handler_set_slice_budget(handler, 1000000000ULL);
+
+    // large budget finishes both in one frame, each once
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_update_handler_update(handler, &ctx);
+    assert(first.done == 1 && second.done == 1);
+    assert(first.calls == SLICES_STEPS + 1 && second.calls == SLICES_STEPS + 1);
+
+    dt_update_handler_update(handler, &ctx);
+    assert(first.done == 2 && second.done == 2);
+
+    dt_update_handler_free(handler);
+}
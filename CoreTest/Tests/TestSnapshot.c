@@ -0,0 +1,171 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static DtEcsManager* manager;
+static DtEcsSnapshot snapshot;
+static DtEcsFilter* data_filter;
+
+static void test_snapshot1(void);
+static void test_snapshot2(void);
+static void test_snapshot3(void);
+static void test_snapshot4(void);
+
+void test_snapshot(void) {
+    printf("\n\t===test_snapshot===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_snapshot1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_snapshot2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_snapshot3();
+    printf("\t\t===test 3 success===\n");
+
+    printf("\n\t\t===test 4 start===\n");
+    test_snapshot4();
+    printf("\t\t===test 4 success===\n");
+
+    dt_ecs_snapshot_free(&snapshot);
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void check_initial_state(void) {
+    DtEcsPool* data_pool1 = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    DtEcsPool* tag_pool1 = DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent1);
+
+    assert(manager->entities_ptr == 4);
+    for (DtEntity e = 0; e < 4; e++) {
+        assert(dt_ecs_manager_get_entity(manager, e).alive);
+        assert(((TestDataComponent1*) dt_ecs_pool_get(data_pool1, e))->data == e + 1);
+        assert(dt_ecs_pool_has(tag_pool1, e) == (e % 2 == 1));
+    }
+
+    assert(dt_ecs_manager_get_entity(manager, 2).parent == 0);
+    assert(dt_ecs_manager_get_entity(manager, 0).children_count == 1);
+    assert(data_pool1->count == 4);
+    assert(data_filter->entities.count == 2);
+    assert(dt_entity_container_has(&data_filter->entities, 0));
+    assert(dt_entity_container_has(&data_filter->entities, 2));
+}
+
+static void test_snapshot1(void) {
+    manager = dt_ecs_manager_new(cfg);
+
+    for (int i = 0; i < 4; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e,
+                                   &(TestDataComponent1) {.data = i + 1});
+        if (i % 2 == 1)
+            DT_ECS_MANAGER_ADD_TO_POOL(manager, TestEmptyComponent1, e, NULL);
+    }
+    dt_ecs_manager_set_parent(manager, 2, 0);
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 1);
+    DT_MASK_INC(mask, TestDataComponent1);
+    DT_MASK_EXC(mask, TestEmptyComponent1);
+    data_filter = dt_mask_end(mask);
+
+    check_initial_state();
+    dt_ecs_manager_snapshot(manager, &snapshot);
+    assert(snapshot.manager == manager);
+    assert(snapshot.size > 0);
+}
+
+static void test_snapshot2(void) {
+    DtEcsPool* data_pool1 = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+
+    ((TestDataComponent1*) dt_ecs_pool_get(data_pool1, 0))->data = 100;
+    DT_ECS_MANAGER_REMOVE_FROM_POOL(manager, TestDataComponent1, 2);
+    DT_ECS_MANAGER_ADD_TO_POOL(manager, TestEmptyComponent1, 0, NULL);
+    dt_ecs_manager_kill_entity(manager, 3);
+
+    for (int i = 0; i < 8; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, NULL);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestEmptyComponent2, e, NULL);
+    }
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 1);
+    DT_MASK_INC(mask, TestEmptyComponent2);
+    DtEcsFilter* late_filter = dt_mask_end(mask);
+    assert(late_filter->entities.count == 8);
+
+    assert(dt_ecs_manager_restore(manager, &snapshot));
+    check_initial_state();
+
+    assert(late_filter->entities.count == 0);
+    assert(DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent2)->count == 0);
+}
+
+static void test_snapshot3(void) {
+    const DtEntity e = dt_ecs_manager_new_entity(manager);
+    assert(e == 4);
+    assert(dt_ecs_manager_get_entity_components_count(manager, e) == 0);
+    DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, NULL);
+    assert(data_filter->entities.count == 3);
+
+    assert(dt_ecs_manager_restore(manager, &snapshot));
+    check_initial_state();
+
+    DtEcsManager* other = dt_ecs_manager_new(cfg);
+    assert(!dt_ecs_manager_restore(other, &snapshot));
+    dt_ecs_manager_free(other);
+}
+
+static void test_snapshot4(void) {
+    DtEcsPool* tag_pool2 = DT_ECS_MANAGER_GET_POOL(manager, TestEmptyComponent2);
+    DtEcsObserver* added = dt_ecs_manager_observe(manager, DT_OBSERVE_ADD, tag_pool2, NULL);
+    DtEventChannel* hits = DT_ECS_MANAGER_GET_EVENTS(manager, TestHitEvent);
+
+    // readable and gathered changes of both frames refer to entities of dropped state
+    const DtEntity e = dt_ecs_manager_new_entity(manager);
+    dt_ecs_pool_add(tag_pool2, e, NULL);
+    dt_event_send(hits, &(TestHitEvent) {.target = e, .damage = 1});
+    dt_ecs_manager_swap_events(manager);
+    dt_ecs_manager_swap_observers(manager);
+    dt_ecs_pool_add(tag_pool2, 0, NULL);
+    dt_event_send(hits, &(TestHitEvent) {.target = 0, .damage = 2});
+
+    u16 count = 0;
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 1 && dt_events_count(hits) == 1);
+
+    assert(dt_ecs_manager_restore(manager, &snapshot));
+    check_initial_state();
+
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 0 && dt_events_count(hits) == 0);
+    dt_ecs_manager_swap_events(manager);
+    dt_ecs_manager_swap_observers(manager);
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 0 && dt_events_count(hits) == 0);
+
+    // entity of dropped state can be observed again
+    dt_ecs_pool_add(tag_pool2, 0, NULL);
+    dt_ecs_manager_swap_observers(manager);
+    dt_ecs_observer_entities(added, &count);
+    assert(count == 1);
+}
@@ -0,0 +1,301 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Jobs/DtJobs.h"
+#include "TestEcs.h"
+
+#define SCHEDULE_ENTITIES 8
+#define SCHEDULE_FRAMES 50
+#define SCHEDULE_WORKERS 3
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    DtEcsFilter* filter;
+    DtEcsPool* pool;
+    int counter;
+} ScheduleUpdate;
+
+static DtEcsManager* manager;
+static UpdateHandler* handler;
+
+static ScheduleUpdate doubler;
+static ScheduleUpdate incrementer;
+static ScheduleUpdate counter;
+static UpdateSystem unknown;
+
+static void test_system_schedule1(void);
+static void test_system_schedule2(void);
+static void test_system_schedule3(void);
+static void test_system_schedule4(void);
+
+void test_system_schedule(void) {
+    printf("\n\t===test_system_schedule===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_system_schedule1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_system_schedule2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_system_schedule3();
+    printf("\t\t===test 3 success===\n");
+
+    printf("\n\t\t===test 4 start===\n");
+    test_system_schedule4();
+    printf("\t\t===test 4 success===\n");
+
+    dt_update_handler_free(handler);
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void data_update_init(DtEcsManager* ecs_manager, void* data) {
+    ScheduleUpdate* update = data;
+
+    DtEcsMask mask = dt_mask_new(ecs_manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    update->filter = dt_mask_end(mask);
+    update->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestDataComponent1);
+}
+
+static void doubler_update(void* data, DtUpdateContext* ctx) {
+    ScheduleUpdate* update = data;
+
+    FOREACH(DtEntity, e, &update->filter->entities.entities_iterator, {
+        TestDataComponent1* component = dt_ecs_pool_get(update->pool, e);
+        component->data *= 2;
+    });
+}
+
+static void incrementer_update(void* data, DtUpdateContext* ctx) {
+    ScheduleUpdate* update = data;
+
+    FOREACH(DtEntity, e, &update->filter->entities.entities_iterator, {
+        TestDataComponent1* component = dt_ecs_pool_get(update->pool, e);
+        component->data = component->data % 1000 + 1;
+    });
+}
+
+static void counter_init(DtEcsManager* ecs_manager, void* data) {
+    ScheduleUpdate* update = data;
+    update->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestEmptyComponent2);
+}
+
+static void counter_update(void* data, DtUpdateContext* ctx) {
+    ScheduleUpdate* update = data;
+    update->counter++;
+}
+
+static void toggler_init(DtEcsManager* ecs_manager, void* data) {
+    ScheduleUpdate* update = data;
+    update->pool = DT_ECS_MANAGER_GET_POOL(ecs_manager, TestEmptyComponent1);
+}
+
+static void toggler_update(void* data, DtUpdateContext* ctx) {
+    ScheduleUpdate* update = data;
+
+    for (DtEntity e = 0; e < SCHEDULE_ENTITIES; e++) {
+        if (update->counter % 2 == 0)
+            dt_ecs_pool_add(update->pool, e, NULL);
+        else
+            dt_ecs_pool_remove(update->pool, e);
+    }
+    update->counter++;
+}
+
+static void test_system_schedule1(void) {
+    manager = dt_ecs_manager_new(cfg);
+    for (int i = 0; i < SCHEDULE_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, &(TestDataComponent1) {i});
+    }
+
+    doubler = (ScheduleUpdate) {
+        .system = {.init = data_update_init, .update = doubler_update, .data = &doubler},
+    };
+    incrementer = (ScheduleUpdate) {
+        .system = {.init = data_update_init, .update = incrementer_update, .priority = 1,
+                   .data = &incrementer},
+    };
+    counter = (ScheduleUpdate) {
+        .system = {.init = counter_init, .update = counter_update, .priority = 2,
+                   .data = &counter},
+    };
+    unknown = (UpdateSystem) {.priority = 3};
+
+    handler = dt_update_handler_new(manager, 4);
+    dt_update_handler_add(handler, &unknown, "Unknown");
+    dt_update_handler_add(handler, &counter.system, "Counter");
+    dt_update_handler_add(handler, &incrementer.system, "Incrementer");
+    dt_update_handler_add(handler, &doubler.system, "Doubler");
+    dt_update_handler_init(handler);
+
+    // pools fetched by init are written, system without them is exclusive
+    const u16 data_id = doubler.pool->ecs_manager_id;
+    assert(dt_vec_count(handler->access[0].writes) == 1 && handler->access[0].writes[0] == data_id);
+    assert(!handler->access[2].exclusive);
+    assert(handler->access[3].exclusive);
+
+    assert(dt_system_schedule_depends(handler->schedule, 0, 1));
+    assert(!dt_system_schedule_depends(handler->schedule, 0, 2));
+    assert(!dt_system_schedule_depends(handler->schedule, 1, 2));
+    assert(dt_system_schedule_depends(handler->schedule, 2, 3));
+    assert(dt_system_schedule_depends(handler->schedule, 0, 3));
+}
+
+static void test_system_schedule2(void) {
+    const DtAttributeData reader_attrs[] = {DT_READS_ATTR(TestDataComponent1)};
+    const DtAttributeData writer_attrs[] = {
+        DT_READS_ATTR(TestEmptyComponent2),
+        DT_WRITES_ATTR(TestDataComponent1),
+    };
+    const DtAttributeData exclusive_attrs[] = {DT_EXCLUSIVE_ATTR};
+    const DtAttributeData structural_attrs[] = {
+        DT_WRITES_ATTR(TestEmptyComponent2),
+        DT_STRUCTURAL_ATTR,
+    };
+    const DtAttributeData other_attrs[] = {{.attribute_name = "test_attr"}};
+
+    DtSystemAccess reader = {0};
+    DtSystemAccess second_reader = {0};
+    DtSystemAccess writer = {0};
+    DtSystemAccess exclusive = {0};
+    DtSystemAccess other = {0};
+    DtSystemAccess structural = {0};
+
+    assert(dt_system_access_declare(&reader, manager, reader_attrs, 1));
+    assert(dt_system_access_declare(&second_reader, manager, reader_attrs, 1));
+    assert(dt_system_access_declare(&writer, manager, writer_attrs, 2));
+    assert(dt_system_access_declare(&exclusive, manager, exclusive_attrs, 1));
+    assert(!dt_system_access_declare(&other, manager, other_attrs, 1));
+    assert(dt_system_access_declare(&structural, manager, structural_attrs, 2));
+
+    assert(!dt_system_access_conflicts(&reader, &second_reader));
+    assert(dt_system_access_conflicts(&reader, &writer));
+    assert(dt_system_access_conflicts(&writer, &reader));
+    assert(dt_system_access_conflicts(&exclusive, &reader));
+    assert(!dt_system_access_conflicts(&other, &reader));
+
+    // structural changes conflict even with disjoint writes
+    assert(dt_system_access_conflicts(&structural, &writer));
+    assert(dt_system_access_conflicts(&reader, &structural));
+
+    dt_system_access_clear(&reader);
+    dt_system_access_clear(&second_reader);
+    dt_system_access_clear(&writer);
+    dt_system_access_clear(&exclusive);
+    dt_system_access_clear(&other);
+    dt_system_access_clear(&structural);
+}
+
+static void test_system_schedule3(void) {
+    int expected[SCHEDULE_ENTITIES];
+    for (int i = 0; i < SCHEDULE_ENTITIES; i++) {
+        expected[i] = i;
+        for (int frame = 0; frame < SCHEDULE_FRAMES; frame++)
+            expected[i] = expected[i] * 2 % 1000 + 1;
+    }
+
+    // conflicting systems keep priority order on any number of workers
+    dt_jobs_init(SCHEDULE_WORKERS);
+    dt_update_handler_set_parallel(handler, true);
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    for (int frame = 0; frame < SCHEDULE_FRAMES; frame++)
+        dt_update_handler_update(handler, &ctx);
+
+    for (int i = 0; i < SCHEDULE_ENTITIES; i++) {
+        const TestDataComponent1* component = dt_ecs_pool_get(doubler.pool, i);
+        assert(component->data == expected[i]);
+    }
+    assert(counter.counter == SCHEDULE_FRAMES);
+
+    dt_jobs_shutdown();
+    dt_update_handler_update(handler, &ctx);
+    assert(counter.counter == SCHEDULE_FRAMES + 1);
+
+    dt_update_handler_set_parallel(handler, false);
+    dt_update_handler_update(handler, &ctx);
+    assert(counter.counter == SCHEDULE_FRAMES + 2);
+}
+
+static void test_system_schedule4(void) {
+    ScheduleUpdate toggler = {
+        .system = {.init = toggler_init, .update = toggler_update, .data = &toggler},
+    };
+    ScheduleUpdate other = {
+        .system = {.init = counter_init, .update = counter_update, .priority = 1,
+                   .data = &other},
+    };
+
+    UpdateHandler* structural_handler = dt_update_handler_new(manager, 2);
+    dt_update_handler_add(structural_handler, &toggler.system, "Toggler");
+    dt_update_handler_add(structural_handler, &other.system, "Other");
+    dt_update_handler_init(structural_handler);
+    assert(!dt_system_schedule_depends(structural_handler->schedule, 0, 1));
+
+    // undeclared structural change of sequential run makes system conflict with others
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_update_handler_update(structural_handler, &ctx);
+    assert(structural_handler->access[0].structural);
+    assert(!structural_handler->access[1].structural);
+    assert(dt_system_schedule_depends(structural_handler->schedule, 0, 1));
+
+    dt_jobs_init(SCHEDULE_WORKERS);
+    dt_update_handler_set_parallel(structural_handler, true);
+    for (int frame = 1; frame < SCHEDULE_FRAMES; frame++)
+        dt_update_handler_update(structural_handler, &ctx);
+    assert(toggler.counter == SCHEDULE_FRAMES && other.counter == SCHEDULE_FRAMES);
+    dt_jobs_shutdown();
+
+    dt_update_handler_free(structural_handler);
+
+    // undeclared structural systems of same parallel batch fail before touching pools
+    fflush(stdout);
+    const pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        ScheduleUpdate first = {
+            .system = {.init = toggler_init, .update = toggler_update, .data = &first},
+        };
+        ScheduleUpdate second = {
+            .system = {.init = counter_init, .update = toggler_update, .data = &second},
+        };
+
+        UpdateHandler* batch_handler = dt_update_handler_new(manager, 2);
+        dt_update_handler_add(batch_handler, &first.system, "First");
+        dt_update_handler_add(batch_handler, &second.system, "Second");
+        dt_update_handler_init(batch_handler);
+        assert(!dt_system_schedule_depends(batch_handler->schedule, 0, 1));
+
+        dt_jobs_init(SCHEDULE_WORKERS);
+        dt_update_handler_set_parallel(batch_handler, true);
+        dt_update_handler_update(batch_handler, &ctx);
+        _exit(0);
+    }
+
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) != 0);
+}
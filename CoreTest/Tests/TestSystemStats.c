@@ -0,0 +1,192 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "TestEcs.h"
+
+#define STATS_ENTITIES 5
+#define STATS_FRAMES 3
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    DtEcsManager* manager;
+    DtEcsFilter* filter;
+} StatsUpdate;
+
+static DtEcsManager* manager;
+static UpdateHandler* update_handler;
+static DrawHandler* draw_handler;
+static StatsUpdate spawn_update;
+static DrawSystem idle_draw;
+
+typedef struct {
+    UpdateSystem system;
+    UpdateHandler* inner;
+} NestingUpdate;
+
+static void test_system_stats1(void);
+static void test_system_stats2(void);
+static void test_system_stats3(void);
+
+void test_system_stats(void) {
+    printf("\n\t===test_system_stats===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_system_stats1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_system_stats2();
+    printf("\t\t===test 2 success===\n");
+
+    printf("\n\t\t===test 3 start===\n");
+    test_system_stats3();
+    printf("\t\t===test 3 success===\n");
+
+    dt_update_handler_free(update_handler);
+    dt_draw_handler_free(draw_handler);
+    dt_ecs_manager_free(manager);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void spawn_update_init(DtEcsManager* ecs_manager, void* data) {
+    StatsUpdate* update = data;
+
+    DtEcsMask mask = dt_mask_new(ecs_manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    update->filter = dt_mask_end(mask);
+    update->manager = ecs_manager;
+}
+
+static void spawn_update_update(void* data, DtUpdateContext* ctx) {
+    StatsUpdate* update = data;
+
+    FOREACH(DtEntity, e, &update->filter->entities.entities_iterator, {});
+
+    const DtEntity e = dt_ecs_manager_new_entity(update->manager);
+    DT_ECS_MANAGER_ADD_TO_POOL(update->manager, TestEmptyComponent1, e, NULL);
+}
+
+static void idle_draw_draw(void* data) {}
+
+static void test_system_stats1(void) {
+    manager = dt_ecs_manager_new(cfg);
+    for (int i = 0; i < STATS_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, NULL);
+    }
+
+    spawn_update = (StatsUpdate) {
+        .system =
+            (UpdateSystem) {
+                .init = spawn_update_init,
+                .update = spawn_update_update,
+                .priority = 1,
+                .data = &spawn_update,
+            },
+    };
+    idle_draw = (DrawSystem) {.draw = idle_draw_draw};
+
+    update_handler = dt_update_handler_new(manager, 0);
+    draw_handler = dt_draw_handler_new(manager, 0);
+    dt_update_handler_add(update_handler, &spawn_update.system, "SpawnUpdate");
+    dt_draw_handler_add(draw_handler, &idle_draw, "IdleDraw");
+    dt_update_handler_init(update_handler);
+    dt_draw_handler_init(draw_handler);
+
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    for (int i = 0; i < STATS_FRAMES; i++) {
+        dt_update_handler_update(update_handler, &ctx);
+        dt_draw_handler_draw(draw_handler);
+    }
+
+    assert(dt_update_handler_get_stats(update_handler, "UnknownSystem") == NULL);
+
+#ifdef DT_PROFILE_SYSTEMS
+    const DtSystemStats* update_stats = dt_update_handler_get_stats(update_handler, "SpawnUpdate");
+    const DtSystemStats* draw_stats = dt_draw_handler_get_stats(draw_handler, "IdleDraw");
+
+    assert(update_stats && draw_stats);
+    assert(update_stats->calls == STATS_FRAMES);
+    assert(draw_stats->calls == STATS_FRAMES);
+    assert(update_stats->entities_visited == STATS_ENTITIES * STATS_FRAMES);
+    assert(update_stats->structural_changes == 2 * STATS_FRAMES);
+    assert(draw_stats->structural_changes == 0);
+    assert(update_stats->max_ns >= update_stats->last_ns);
+    assert(update_stats->total_ns >= update_stats->max_ns);
+    assert(dt_system_stats_average_ns(update_stats) <= update_stats->max_ns);
+#else
+    assert(dt_update_handler_get_stats(update_handler, "SpawnUpdate") == NULL);
+    assert(dt_draw_handler_get_stats(draw_handler, "IdleDraw") == NULL);
+#endif /*DT_PROFILE_SYSTEMS*/
+}
+
+static void test_system_stats2(void) {
+    static UpdateSystem first = {.priority = -1};
+    dt_update_handler_add(update_handler, &first, "FirstUpdate");
+    dt_update_handler_init(update_handler);
+
+    assert(update_handler->systems[0] == &first);
+    assert(strcmp(update_handler->names[0], "FirstUpdate") == 0);
+    assert(strcmp(update_handler->names[1], "SpawnUpdate") == 0);
+
+    dt_update_handler_reset_stats(update_handler);
+
+#ifdef DT_PROFILE_SYSTEMS
+    const DtSystemStats* update_stats = dt_update_handler_get_stats(update_handler, "SpawnUpdate");
+    assert(update_stats->calls == 0);
+    assert(dt_system_stats_average_ns(update_stats) == 0);
+#endif /*DT_PROFILE_SYSTEMS*/
+}
+
+static void inner_idle_update(void* data, DtUpdateContext* ctx) {}
+
+static void nesting_update_update(void* data, DtUpdateContext* ctx) {
+    NestingUpdate* update = data;
+
+    dt_update_handler_update(update->inner, ctx);
+    dt_ecs_manager_new_entity(manager);
+}
+
+static void test_system_stats3(void) {
+    static UpdateSystem inner_idle = {.update = inner_idle_update};
+    NestingUpdate nesting = {
+        .system = {.update = nesting_update_update, .data = &nesting},
+        .inner = dt_update_handler_new(manager, 1),
+    };
+    dt_update_handler_add(nesting.inner, &inner_idle, "InnerIdle");
+    dt_update_handler_init(nesting.inner);
+
+    UpdateHandler* outer = dt_update_handler_new(manager, 1);
+    dt_update_handler_add(outer, &nesting.system, "NestingUpdate");
+    dt_update_handler_init(outer);
+
+    // change after inner handler returns is counted for outer system
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    dt_update_handler_update(outer, &ctx);
+
+#ifdef DT_PROFILE_SYSTEMS
+    assert(dt_update_handler_get_stats(outer, "NestingUpdate")->structural_changes == 1);
+    assert(dt_update_handler_get_stats(nesting.inner, "InnerIdle")->structural_changes == 0);
+    assert(dt_current_system_stats == NULL);
+#endif /*DT_PROFILE_SYSTEMS*/
+
+    dt_update_handler_free(outer);
+    dt_update_handler_free(nesting.inner);
+}
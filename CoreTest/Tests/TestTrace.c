@@ -0,0 +1,139 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Profiling/DtTrace.h"
+#include "TestEcs.h"
+
+#define TRACE_TEST_PATH "./test_trace.json"
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 2,
+    .sparse_size = 2,
+    .recycle_size = 2,
+    .components_count = 2,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+static DtEcsManager* manager;
+static UpdateHandler* update_handler;
+static UpdateSystem traced_update;
+
+static void test_trace1(void);
+static void test_trace2(void);
+
+void test_trace(void) {
+    printf("\n\t===test_trace===\n");
+
+    manager = dt_ecs_manager_new(cfg);
+    update_handler = dt_update_handler_new(manager, 0);
+
+    printf("\n\t\t===test 1 start===\n");
+    test_trace1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_trace2();
+    printf("\t\t===test 2 success===\n");
+
+    dt_update_handler_free(update_handler);
+    dt_ecs_manager_free(manager);
+    remove(TRACE_TEST_PATH);
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static char* read_trace(void) {
+    FILE* file = fopen(TRACE_TEST_PATH, "r");
+    assert(file != NULL);
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = DT_MALLOC(size + 1);
+    text[fread(text, 1, size, file)] = '\0';
+    fclose(file);
+
+    return text;
+}
+
+static void traced_update_update(void* data, DtUpdateContext* ctx) {
+    for (int i = 0; i < 4; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, NULL);
+    }
+}
+
+static void* traced_thread(void* data) {
+    DT_TRACE_ZONE("TracedThreadZone");
+    return NULL;
+}
+
+static void test_trace1(void) {
+    traced_update = (UpdateSystem) {.update = traced_update_update};
+    dt_update_handler_add(update_handler, &traced_update, "TracedUpdate");
+
+    DtUpdateContext ctx = {0};
+
+    // zones before capture aren't recorded
+    dt_update_handler_update(update_handler, &ctx);
+    assert(!dt_trace_frame_mark());
+
+    dt_trace_capture(2);
+#ifdef DT_TRACE
+    assert(dt_trace_is_capturing());
+#endif /*DT_TRACE*/
+    assert(!dt_trace_frame_mark());
+
+    dt_update_handler_update(update_handler, &ctx);
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    dt_mask_end(mask);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, traced_thread, NULL);
+    pthread_join(thread, NULL);
+
+    assert(!dt_trace_frame_mark());
+    dt_update_handler_update(update_handler, &ctx);
+
+#ifdef DT_TRACE
+    assert(dt_trace_frame_mark());
+    assert(!dt_trace_is_capturing());
+#else
+    assert(!dt_trace_frame_mark());
+#endif /*DT_TRACE*/
+}
+
+static void test_trace2(void) {
+#ifdef DT_TRACE
+    assert(dt_trace_dump(TRACE_TEST_PATH));
+
+    char* text = read_trace();
+    assert(strncmp(text, "{\"displayTimeUnit\"", 18) == 0);
+    assert(strstr(text, "\"name\":\"TracedUpdate\""));
+    assert(strstr(text, "\"name\":\"dt_mask_end\""));
+    assert(strstr(text, "\"name\":\"TracedThreadZone\""));
+    assert(strstr(text, "\"name\":\"frame\""));
+    assert(strstr(text, "\"name\":\"thread 1\""));
+
+    // two update calls inside capture, one before it
+    const char* first = strstr(text, "\"name\":\"TracedUpdate\"");
+    const char* second = strstr(first + 1, "\"name\":\"TracedUpdate\"");
+    assert(second && !strstr(second + 1, "\"name\":\"TracedUpdate\""));
+
+    DT_FREE(text);
+#else
+    assert(!dt_trace_dump(TRACE_TEST_PATH));
+#endif /*DT_TRACE*/
+}
@@ -0,0 +1,149 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#include "TestEcs.h"
+#include "scheduler/RuntimeScheduler.h"
+
+#define WORLDS_COUNT 4
+#define WORLDS_ENTITIES 8
+#define WORLDS_FRAMES 200
+
+static const DtEcsManagerConfig cfg = {
+    .dense_size = 4,
+    .sparse_size = 4,
+    .recycle_size = 2,
+    .components_count = 4,
+    .pools_size = 4,
+    .masks_size = 1,
+
+    .children_size = 1,
+
+    .include_mask_count = 1,
+    .exclude_mask_count = 1,
+    .filters_size = 1,
+};
+
+typedef struct {
+    UpdateSystem system;
+    DtEcsFilter* filter;
+    DtEcsPool* pool;
+    int step;
+} WorldUpdate;
+
+typedef struct {
+    int step;
+    int sum;
+    bool lookups_failed;
+} World;
+
+static void test_worlds1(void);
+static void test_worlds2(void);
+
+void test_worlds(void) {
+    printf("\n\t===test_worlds===\n");
+
+    printf("\n\t\t===test 1 start===\n");
+    test_worlds1();
+    printf("\t\t===test 1 success===\n");
+
+    printf("\n\t\t===test 2 start===\n");
+    test_worlds2();
+    printf("\t\t===test 2 success===\n");
+
+    dt_registries_unfreeze();
+
+    printf("\n\t\t===SUCCESS===\n\n");
+}
+
+static void world_update_init(DtEcsManager* manager, void* data) {
+    WorldUpdate* update = data;
+
+    DtEcsMask mask = dt_mask_new(manager, 1, 0);
+    DT_MASK_INC(mask, TestDataComponent1);
+    update->filter = dt_mask_end(mask);
+    update->pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+}
+
+static void world_update(void* data, DtUpdateContext* ctx) {
+    WorldUpdate* update = data;
+
+    FOREACH(DtEntity, e, &update->filter->entities.entities_iterator, {
+        TestDataComponent1* component = dt_ecs_pool_get(update->pool, e);
+        component->data += update->step;
+    });
+}
+
+static void* world_run(void* data) {
+    World* world = data;
+
+    DtEcsManager* manager = dt_ecs_manager_new(cfg);
+    for (int i = 0; i < WORLDS_ENTITIES; i++) {
+        const DtEntity e = dt_ecs_manager_new_entity(manager);
+        DT_ECS_MANAGER_ADD_TO_POOL(manager, TestDataComponent1, e, &(TestDataComponent1) {0});
+    }
+
+    WorldUpdate update = {
+        .system = {.init = world_update_init, .update = world_update, .data = &update},
+        .step = world->step,
+    };
+    UpdateHandler* handler = dt_update_handler_new(manager, 1);
+    dt_update_handler_add(handler, &update.system, "WorldUpdate");
+    dt_update_handler_init(handler);
+
+    DtUpdateContext ctx = {.delta_time = 0.1f};
+    for (int frame = 0; frame < WORLDS_FRAMES; frame++) {
+        dt_update_handler_update(handler, &ctx);
+
+        // frozen registries are read by every world at once
+        const DtComponentData* component = dt_component_get_data_by_name("TestDataComponent1");
+        if (!component || !dt_component_get_plans(component))
+            world->lookups_failed = true;
+    }
+
+    const DtEcsPool* pool = DT_ECS_MANAGER_GET_POOL(manager, TestDataComponent1);
+    for (DtEntity e = 0; e < WORLDS_ENTITIES; e++)
+        world->sum += ((TestDataComponent1*) dt_ecs_pool_get(pool, e))->data;
+
+    dt_update_handler_free(handler);
+    dt_ecs_manager_free(manager);
+
+    return NULL;
+}
+
+static void test_worlds1(void) {
+    dt_registries_freeze();
+    assert(dt_registries_frozen());
+
+    // frozen registries refuse new data and keep old one
+    static DtUpdateData late = {.name = "LateUpdate"};
+    dt_update_register(&late);
+    assert(dt_update_get_data_by_name("LateUpdate") == NULL);
+
+    const DtComponentData* data = dt_component_get_data_by_name("TestDataComponent1");
+    assert(data != NULL);
+
+    // plans are compiled by invalidate itself, readers never compile them
+    dt_component_invalidate_plans();
+    const DtFieldPlan* plans = dt_component_get_plans(data);
+    assert(plans != NULL);
+    assert(plans[0].parse == dt_get_parser_json_to_type("int"));
+}
+
+static void test_worlds2(void) {
+    World worlds[WORLDS_COUNT] = {0};
+    pthread_t threads[WORLDS_COUNT];
+
+    for (int i = 0; i < WORLDS_COUNT; i++) {
+        worlds[i].step = i + 1;
+        assert(pthread_create(&threads[i], NULL, world_run, &worlds[i]) == 0);
+    }
+
+    for (int i = 0; i < WORLDS_COUNT; i++)
+        pthread_join(threads[i], NULL);
+
+    for (int i = 0; i < WORLDS_COUNT; i++) {
+        assert(!worlds[i].lookups_failed);
+        assert(worlds[i].sum == worlds[i].step * WORLDS_FRAMES * WORLDS_ENTITIES);
+    }
+}
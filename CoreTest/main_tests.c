@@ -9,6 +9,23 @@ int main() {
     test_component_register();
     test_systems_register();
     test_scene_parse();
+    test_scene_binary();
+    test_prefab();
+    test_snapshot();
+    test_scene_saver();
+    test_migration();
+    test_system_stats();
+    test_system_schedule();
+    test_jobs();
+    test_render_snapshot();
+    test_worlds();
+    test_events();
+    test_observers();
+    test_slices();
+    test_run_conditions();
+    test_fixed_step();
+    test_trace();
+    test_alloc_tracker();
     test_module_load();
     return 0;
 }
\ No newline at end of file
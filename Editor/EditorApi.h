@@ -33,6 +33,8 @@
 
 typedef enum { DTE_NORMAL, DTE_WARNING, DTE_ERROR } DtEMessageType;
 
+typedef bool (*DtEInspectorHandler)(const char* name, void* data);
+
 typedef struct {
     char text[256];
     DtEMessageType type;
@@ -65,4 +67,9 @@ void dte_add_inspector_type(const char* type, bool (*handle)(const char* name, v
 
 bool dte_inspector_field_draw(const char* type, const char* name, void* data);
 
+/**
+ * @brief return inspector handler registered for type or NULL
+ */
+DtEInspectorHandler dte_inspector_get_handler(const char* type);
+
 #endif /*EDITOR_API_H*/
@@ -5,12 +5,28 @@
 
 void load_game_lib();
 void build_game_lib();
+
+/**
+ * @brief start game lib build without blocking editor, lib is reloaded when build succeeds
+ *
+ * @note build requested while other build runs is started after it
+ */
+void build_game_lib_async();
+bool game_lib_is_building();
 void reload_game_lib(bool rebuild);
 void save_game_scene();
+void mark_game_entity_dirty(DtEntity entity);
+void wait_game_scene_saved();
 void load_game_scene();
 void reload_game_scene();
+void play_game_scene();
+void stop_game_scene();
+bool game_scene_is_playing();
+void update_game_scene(DtUpdateContext* ctx);
 
 void load_draw_game_systems();
+void unload_draw_game_systems();
+void set_game_draw_alpha(float alpha);
 void load_update_game_systems();
 
 static inline void load_game_systems() {
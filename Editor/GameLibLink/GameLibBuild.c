@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../GameLib.h"
+#include "DtAllocators.h"
+#include "EditorApi.h"
+#include "Ecs/RegisterHandler.h"
+
+#ifdef DEBUG
+#define BUILD_MOD "debug_build"
+#else
+#define BUILD_MOD "realise_build"
+#endif /*DEBUG*/
+
+#ifdef _WIN32
+#define REBUILD_SCRIPT_PATH "..\\..\\..\\" BUILD_MOD ".bat GameLibShared"
+#else
+#define REBUILD_SCRIPT_PATH "./../../../" BUILD_MOD ".sh GameLibShared"
+#endif /*_WIN32*/
+
+#define GAME_SCRIPTS_PATH "./../../../GameScripts"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BUILD_LINE_SIZE 256
+#define WATCH_EVENTS_SIZE 4096
+#define WATCH_MASK (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE)
+
+/**
+ * @brief build runs in child process, its output is read from pipe without blocking
+ * and is sent line by line to message panel
+ */
+typedef struct {
+    pid_t pid;
+    int output;
+
+    char line[BUILD_LINE_SIZE];
+    u16 line_size;
+
+    bool pending;
+} GameLibBuild;
+
+static GameLibBuild build = {.pid = -1, .output = -1};
+static int watch_fd = -1;
+
+static void watch_directory(const char* path);
+static bool is_script_file(const char* name);
+static void poll_watch();
+static void poll_build_output();
+static void poll_build_exit();
+static void flush_build_line();
+#endif /*__linux__*/
+
+static UpdateSystem* game_lib_watch_new();
+static void game_lib_watch_init(DtEcsManager* manager, void* data);
+static void game_lib_watch_update(void* data, DtUpdateContext* ctx);
+static void game_lib_watch_destroy(void* data);
+
+DT_REGISTER_UPDATE(GameLibWatchSystem, game_lib_watch_new);
+
+void build_game_lib() { system(REBUILD_SCRIPT_PATH); }
+
+#ifdef __linux__
+void build_game_lib_async() {
+    if (build.pid > 0) {
+        build.pending = true;
+        return;
+    }
+
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        dte_error_log("Could not start game lib build");
+        return;
+    }
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        dte_error_log("Could not start game lib build");
+        return;
+    }
+
+    if (pid == 0) {
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        dup2(pipe_fds[1], STDERR_FILENO);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        execl("/bin/sh", "sh", "-c", REBUILD_SCRIPT_PATH, (char*) NULL);
+        _exit(127);
+    }
+
+    close(pipe_fds[1]);
+    fcntl(pipe_fds[0], F_SETFL, fcntl(pipe_fds[0], F_GETFL) | O_NONBLOCK);
+
+    build = (GameLibBuild) {
+        .pid = pid,
+        .output = pipe_fds[0],
+    };
+    dte_log("Game lib build started");
+}
+
+bool game_lib_is_building() { return build.pid > 0; }
+#else
+void build_game_lib_async() {
+    build_game_lib();
+    stop_game_scene();
+    save_game_scene();
+    reload_game_lib(false);
+}
+
+bool game_lib_is_building() { return false; }
+#endif /*__linux__*/
+
+static UpdateSystem* game_lib_watch_new() {
+    UpdateSystem* system = DT_MALLOC(sizeof(UpdateSystem));
+
+    *system = (UpdateSystem) {
+        .data = NULL,
+
+        .init = game_lib_watch_init,
+        .update = game_lib_watch_update,
+        .destroy = game_lib_watch_destroy,
+    };
+
+    return system;
+}
+
+static void game_lib_watch_init(DtEcsManager* manager, void* data) {
+#ifdef __linux__
+    watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch_fd < 0) {
+        dte_warning_log("Game scripts watcher is unavailable");
+        return;
+    }
+
+    watch_directory(GAME_SCRIPTS_PATH);
+#endif /*__linux__*/
+}
+
+static void game_lib_watch_update(void* data, DtUpdateContext* ctx) {
+#ifdef __linux__
+    poll_watch();
+    poll_build_output();
+    poll_build_exit();
+#endif /*__linux__*/
+}
+
+static void game_lib_watch_destroy(void* data) {
+#ifdef __linux__
+    if (watch_fd >= 0) {
+        close(watch_fd);
+        watch_fd = -1;
+    }
+
+    if (build.pid > 0) {
+        kill(build.pid, SIGTERM);
+        waitpid(build.pid, NULL, 0);
+        close(build.output);
+        build = (GameLibBuild) {.pid = -1, .output = -1};
+    }
+#endif /*__linux__*/
+}
+
+#ifdef __linux__
+static void watch_directory(const char* path) {
+    if (inotify_add_watch(watch_fd, path, WATCH_MASK) < 0) {
+        dte_warning_log("Could not watch %s", path);
+        return;
+    }
+
+    DIR* dir = opendir(path);
+    if (!dir)
+        return;
+
+    const struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_type != DT_DIR || entry->d_name[0] == '.')
+            continue;
+
+        char child[512];
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        watch_directory(child);
+    }
+
+    closedir(dir);
+}
+
+static bool is_script_file(const char* name) {
+    const char* ext = strrchr(name, '.');
+    return ext && (strcmp(ext, ".c") == 0 || strcmp(ext, ".h") == 0);
+}
+
+static void poll_watch() {
+    if (watch_fd < 0)
+        return;
+
+    char events[WATCH_EVENTS_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+
+    ssize_t size;
+    while ((size = read(watch_fd, events, sizeof(events))) > 0) {
+        for (ssize_t offset = 0; offset < size;) {
+            const struct inotify_event* event = (const struct inotify_event*) (events + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            if (event->len > 0 && is_script_file(event->name))
+                changed = true;
+        }
+    }
+
+    if (changed)
+        build_game_lib_async();
+}
+
+static void poll_build_output() {
+    if (build.output < 0)
+        return;
+
+    char chunk[BUILD_LINE_SIZE];
+    ssize_t size;
+    while ((size = read(build.output, chunk, sizeof(chunk))) > 0) {
+        for (ssize_t i = 0; i < size; i++) {
+            if (chunk[i] == '\n' || build.line_size == BUILD_LINE_SIZE - 1) {
+                flush_build_line();
+                if (chunk[i] == '\n')
+                    continue;
+            }
+            build.line[build.line_size++] = chunk[i];
+        }
+    }
+}
+
+static void flush_build_line() {
+    build.line[build.line_size] = '\0';
+    build.line_size = 0;
+
+    if (strstr(build.line, "error"))
+        dte_error_log("%s", build.line);
+    else if (strstr(build.line, "warning"))
+        dte_warning_log("%s", build.line);
+    else
+        dte_log("%s", build.line);
+}
+
+static void poll_build_exit() {
+    if (build.pid <= 0)
+        return;
+
+    int status;
+    if (waitpid(build.pid, &status, WNOHANG) != build.pid)
+        return;
+
+    poll_build_output();
+    if (build.line_size > 0)
+        flush_build_line();
+    close(build.output);
+
+    const bool pending = build.pending;
+    build = (GameLibBuild) {.pid = -1, .output = -1};
+
+    if (pending) {
+        build_game_lib_async();
+        return;
+    }
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        dte_error_log("Game lib build failed");
+        return;
+    }
+
+    dte_log("Game lib build finished, reloading");
+    stop_game_scene();
+    save_game_scene();
+    reload_game_lib(false);
+}
+#endif /*__linux__*/
@@ -32,6 +32,9 @@ DrawSystem* game_lib_draw_new() {
 void game_lib_draw(void* data) {
     Camera2D camera = dte_game_camera();
     BeginMode2D(camera);
+    // editor draws right after update, so extracted frame is shown at once
+    dt_draw_handler_extract(handler);
+    dt_draw_handler_swap(handler);
     dt_draw_handler_draw(handler);
     EndMode2D();
 }
@@ -63,3 +66,17 @@ void load_draw_game_systems() {
 
     dt_draw_handler_init(handler);
 }
+
+void unload_draw_game_systems() {
+    if (!handler)
+        return;
+
+    dt_draw_handler_destroy(handler);
+    dt_draw_handler_free(handler);
+    handler = NULL;
+}
+
+void set_game_draw_alpha(const float alpha) {
+    if (handler)
+        dt_draw_handler_set_alpha(handler, alpha);
+}
@@ -7,18 +7,6 @@
 
 #define GAME_LIB_PATH "./libGameLib"
 
-#ifdef DEBUG
-#define BUILD_MOD "debug_build"
-#else
-#define BUILD_MOD "realise_build"
-#endif /*DEBUG*/
-
-#ifdef _WIN32
-#define REBUILD_SCRIPT_PATH "..\\..\\..\\" BUILD_MOD ".bat GameLibShared"
-#else
-#define REBUILD_SCRIPT_PATH "./../../../" BUILD_MOD ".sh GameLibShared"
-#endif /*_WIN32*/
-
 #define GAME_SCENE_PATH "./source/game_scene.dt.scene"
 
 ModuleInfo* game_lib;
@@ -32,14 +20,13 @@ u16 updates_count;
 const DtDrawData** draws;
 u16 draws_count;
 
-char* json_scene = NULL;
-
 const DtScene* game_scene = NULL;
 
-extern DtEFuncTable func_table;
+static DtSceneSaver* scene_saver = NULL;
+static DtEcsSnapshot play_snapshot = {0};
+static bool playing = false;
 
-static cJSON* dt_scene_serialize_ecs_manager(const DtEcsManager* manager);
-static cJSON* dt_scene_serialize_entities(const DtScene* scene);
+extern DtEFuncTable func_table;
 
 static void init_game_data() {
     components = game_lib->environment->components;
@@ -65,9 +52,16 @@ void load_game_lib() {
         init();
 }
 
-void build_game_lib() { system(REBUILD_SCRIPT_PATH); }
-
 void reload_game_lib(bool rebuild) {
+    stop_game_scene();
+    wait_game_scene_saved();
+
+    DtSceneReload* scene_reload = NULL;
+    if (game_scene) {
+        unload_draw_game_systems();
+        scene_reload = dt_scene_reload_begin(game_scene);
+    }
+
     void (*deinit)(void) =
         *(void (**)())(DtEFuncTable*) DT_LIB_GET(game_lib->handle, DTE_DEINIT_STR);
     if (deinit) {
@@ -88,127 +82,79 @@ void reload_game_lib(bool rebuild) {
 
     if (init)
         init();
-}
 
-void save_game_scene() {
-    cJSON* root = cJSON_CreateObject();
-
-    cJSON_AddItemToObject(root, "manager_config",
-                          dt_scene_serialize_ecs_manager(game_scene->manager));
-
-    cJSON* update_sys = cJSON_AddArrayToObject(root, "update_systems");
-
-    FOREACH(char*, name, DT_VEC_ITERATOR(game_scene->update_handler->names),
-            { cJSON_AddItemToArray(update_sys, cJSON_CreateString(name)); });
-
-    cJSON* draw_sys = cJSON_AddArrayToObject(root, "draw_systems");
-    FOREACH(char*, name, DT_VEC_ITERATOR(game_scene->draw_handler->names),
-            { cJSON_AddItemToArray(draw_sys, cJSON_CreateString(name)); });
+    if (!scene_reload)
+        return;
 
-    cJSON_AddItemToObject(root, "entities", dt_scene_serialize_entities(game_scene));
+    if (scene_saver)
+        dt_scene_saver_mark_all(scene_saver);
 
-    int len;
-    if (json_scene) {
-        DT_FREE(json_scene);
-        len = (int) strlen(json_scene);
+    if (dt_scene_reload_end(game_scene, scene_reload)) {
+        load_game_systems();
     } else {
-        len = 256 * 256;
+        fprintf(stderr, "[WARNING] game scene can't be migrated, it is loaded from file\n");
+        reload_game_scene();
     }
-    json_scene = cJSON_PrintBuffered(root, len, true);
-    FILE* f = fopen(GAME_SCENE_PATH, "w");
-    if (f) {
-        fputs(json_scene, f);
-        fflush(f);
-        fclose(f);
-    }
-
-    cJSON_Delete(root);
 }
 
-void load_game_scene() {
-    FILE* file = fopen(GAME_SCENE_PATH, "rb");
-
-    if (file == NULL) {
-        fprintf(stderr, "[ERROR] Could not open file %s\n", GAME_SCENE_PATH);
-        return;
-    }
+void save_game_scene() {
+    if (!scene_saver)
+        scene_saver = dt_scene_saver_new();
 
-    fseek(file, 0, SEEK_END);
+    dt_scene_saver_save_async(scene_saver, game_scene, GAME_SCENE_PATH);
+}
 
-    i32 size = (i32) ftell(file);
-    fseek(file, 0, SEEK_SET);
+void mark_game_entity_dirty(DtEntity entity) {
+    if (scene_saver)
+        dt_scene_saver_mark_dirty(scene_saver, entity);
+}
 
-    json_scene = DT_MALLOC(size + 1);
-    fread(json_scene, 1, size, file);
+void wait_game_scene_saved() {
+    if (scene_saver && !dt_scene_saver_wait(scene_saver))
+        fprintf(stderr, "[ERROR] Could not save game scene %s\n", GAME_SCENE_PATH);
+}
 
-    game_scene = dt_add_scene_from_json(json_scene, GAME_SCENE_PATH);
+void load_game_scene() {
+    game_scene = dt_add_scene(GAME_SCENE_PATH);
     load_game_systems();
-
-    fclose(file);
 }
 
 void reload_game_scene() {
+    wait_game_scene_saved();
     dt_scene_unload_by(game_scene);
-    game_scene = dt_add_scene_from_json(json_scene, game_scene->name);
+    game_scene = dt_add_scene(GAME_SCENE_PATH);
+    if (scene_saver)
+        dt_scene_saver_mark_all(scene_saver);
     load_game_systems();
 }
 
-static cJSON* dt_scene_serialize_ecs_manager(const DtEcsManager* manager) {
-    cJSON* json_cfg = cJSON_CreateObject();
-
-    cJSON_AddNumberToObject(json_cfg, "dense_size", manager->cfg_dense_size);
-    cJSON_AddNumberToObject(json_cfg, "sparse_size", manager->sparse_size);
-    cJSON_AddNumberToObject(json_cfg, "recycle_size", manager->cfg_recycle_size);
-    cJSON_AddNumberToObject(json_cfg, "children_size", manager->children_size);
-    cJSON_AddNumberToObject(json_cfg, "components_count", manager->component_count);
-    cJSON_AddNumberToObject(json_cfg, "pools_size", (double) manager->pools_table_size);
-    cJSON_AddNumberToObject(json_cfg, "include_mask_count", (double) manager->include_mask_count);
-    cJSON_AddNumberToObject(json_cfg, "exclude_mask_count", (double) manager->exclude_mask_count);
-    cJSON_AddNumberToObject(json_cfg, "filters_size", (double) manager->filters_size);
-    cJSON_AddNumberToObject(json_cfg, "masks_size", (double) manager->include_mask_count);
-
-    return json_cfg;
+void play_game_scene() {
+    if (playing || !game_scene)
+        return;
+
+    dt_ecs_manager_snapshot(game_scene->manager, &play_snapshot);
+    dt_update_handler_init(game_scene->update_handler);
+    playing = true;
+}
+
+void stop_game_scene() {
+    if (!playing)
+        return;
+
+    dt_update_handler_destroy(game_scene->update_handler);
+    if (!dt_ecs_manager_restore(game_scene->manager, &play_snapshot))
+        fprintf(stderr, "[ERROR] Could not restore game scene after play\n");
+    if (scene_saver)
+        dt_scene_saver_mark_all(scene_saver);
+    playing = false;
 }
 
-static cJSON* dt_scene_serialize_entities(const DtScene* scene) {
-    cJSON* entities_obj = cJSON_CreateObject();
-    DtEcsManager* manager = scene->manager;
-
-    for (u16 i = 0; i < manager->entities_ptr; i++) {
-        cJSON* entity_json = cJSON_CreateObject();
-        DtEntityInfo info = dt_ecs_manager_get_entity(manager, i);
-
-        cJSON* components_arr = cJSON_AddArrayToObject(entity_json, "components");
-
-        for (int c = 0; c < info.component_count; c++) {
-            u16 pool_idx = info.components[c];
-            DtEcsPool* pool = manager->pools[pool_idx];
-            const DtComponentData* data = dt_component_get_data_by_name(pool->name);
-
-            if (data->field_count == 0) {
-                cJSON_AddItemToArray(components_arr, cJSON_CreateString(pool->name));
-            } else {
-                cJSON* comp_obj = cJSON_CreateObject();
-                cJSON_AddStringToObject(comp_obj, "name", pool->name);
-                cJSON* values_obj = cJSON_AddObjectToObject(comp_obj, "values");
-
-                u8* instance = dt_ecs_pool_get(pool, i);
-                for (int f = 0; f < data->field_count; f++) {
-                    cJSON* value = dt_serialize_type_to_json(data->field_types[f],
-                                                             instance + data->field_offsets[f]);
-                    cJSON_AddItemToObject(values_obj, data->field_names[f], value);
-                }
-                cJSON_AddItemToArray(components_arr, comp_obj);
-            }
-        }
-
-        if (info.parent != DT_ENTITY_NULL) {
-            cJSON_AddNumberToObject(entity_json, "parent", info.parent);
-        }
-
-        char idx_str[16];
-        snprintf(idx_str, sizeof(idx_str), "%u", i);
-        cJSON_AddItemToObject(entities_obj, idx_str, entity_json);
-    }
-    return entities_obj;
+bool game_scene_is_playing() { return playing; }
+
+void update_game_scene(DtUpdateContext* ctx) {
+    if (!playing)
+        return;
+
+    dt_update_handler_update(game_scene->update_handler, ctx);
+    set_game_draw_alpha(ctx->alpha);
 }
@@ -1,5 +1,6 @@
 #include <scheduler/RuntimeScheduler.h>
 #include <string.h>
+#include "../GameLib.h"
 #include "DtAllocators.h"
 #include "EditorApi.h"
 #include "UI.h"
@@ -24,6 +25,8 @@ static DrawSystem* component_panel_new() {
 }
 static void draw_component_fields(const DtComponentData* data, DtEntity entity, DtEcsPool* pool,
                                   void* component_ptr) {
+    DtFieldPlan* plans = dt_component_get_plans(data);
+
     for (int i = 0; i < data->field_count; i++) {
         bool hide = false;
         for (int j = 0; j < data->filed_attributes_count[i]; j++) {
@@ -36,15 +39,19 @@ static void draw_component_fields(const DtComponentData* data, DtEntity entity,
         if (hide)
             continue;
 
-        u8* field_addr = (u8*) component_ptr + data->field_offsets[i];
-        const char* field_type = data->field_types[i];
-        const char* field_name = data->field_names[i];
+        if (!plans[i].inspect)
+            plans[i].inspect = dte_inspector_get_handler(data->field_types[i]);
+        if (!plans[i].inspect)
+            continue;
 
-        bool changed = dte_inspector_field_draw(field_type, field_name, field_addr);
+        u8* field_addr = (u8*) component_ptr + plans[i].offset;
+        bool changed = plans[i].inspect(data->field_names[i], field_addr);
 
         if (!changed)
             continue;
 
+        mark_game_entity_dirty(entity);
+
         for (int j = 0; j < data->filed_attributes_count[i]; j++) {
             if (strcmp(data->filed_attributes[i][j].attribute_name, DTE_ON_FIELD_CHANGE_NAME) != 0)
                 continue;
@@ -73,6 +80,7 @@ static void draw_single_component(DtEcsManager* manager, DtEntity entity, u16 po
         nk_layout_row_dynamic(nk_ctx, 25, 1);
         if (nk_button_label(nk_ctx, "Remove Component")) {
             dt_ecs_manager_entity_remove_component(manager, entity, comp_name);
+            mark_game_entity_dirty(entity);
         }
         nk_tree_pop(nk_ctx);
     }
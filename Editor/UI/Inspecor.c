@@ -56,10 +56,15 @@ __attribute__((constructor)) void initialize_field_handlers() {
 
 void dte_add_inspector_type(const char* type, bool (*handle)(const char* name, void* data)) {
     dt_rb_tree_add(&field_handlers, handle, get_hash(type));
+    dt_component_invalidate_plans();
+}
+
+DtEInspectorHandler dte_inspector_get_handler(const char* type) {
+    return dt_rb_tree_get(&field_handlers, get_hash(type));
 }
 
 bool dte_inspector_field_draw(const char* type, const char* name, void* data) {
-    bool (*handle)(const char*, void*) = dt_rb_tree_get(&field_handlers, get_hash(type));
+    const DtEInspectorHandler handle = dte_inspector_get_handler(type);
     if (handle)
         return handle(name, data);
 
@@ -31,6 +31,7 @@ static void manage_panel_draw(void* data) {
         nk_layout_row_template_begin(nk_ctx, 25);
         nk_layout_row_template_push_static(nk_ctx, 45);
         nk_layout_row_template_push_static(nk_ctx, 80);
+        nk_layout_row_template_push_static(nk_ctx, 45);
         nk_layout_row_template_end(nk_ctx);
 
         if (nk_menu_begin_label(nk_ctx, "File", NK_TEXT_LEFT, nk_vec2(120, 200))) {
@@ -38,6 +39,7 @@ static void manage_panel_draw(void* data) {
             if (nk_menu_item_label(nk_ctx, "New Scene", NK_TEXT_LEFT)) {
             }
             if (nk_menu_item_label(nk_ctx, "Save", NK_TEXT_LEFT)) {
+                stop_game_scene();
                 save_game_scene();
             }
             nk_menu_end(nk_ctx);
@@ -45,19 +47,26 @@ static void manage_panel_draw(void* data) {
 
         if (nk_menu_begin_label(nk_ctx, "Game Lib", NK_TEXT_LEFT, nk_vec2(150, 200))) {
             nk_layout_row_dynamic(nk_ctx, 25, 1);
-            if (nk_menu_item_label(nk_ctx, "Rebuild Lib", NK_TEXT_LEFT)) {
-                save_game_scene();
-                reload_game_lib(true);
-                reload_game_scene();
+            if (nk_menu_item_label(nk_ctx,
+                                   game_lib_is_building() ? "Building..." : "Rebuild Lib",
+                                   NK_TEXT_LEFT)) {
+                build_game_lib_async();
             }
             if (nk_menu_item_label(nk_ctx, "Reload Lib", NK_TEXT_LEFT)) {
+                stop_game_scene();
                 save_game_scene();
                 reload_game_lib(false);
-                reload_game_scene();
             }
             nk_menu_end(nk_ctx);
         }
 
+        if (nk_button_label(nk_ctx, game_scene_is_playing() ? "Stop" : "Play")) {
+            if (game_scene_is_playing())
+                stop_game_scene();
+            else
+                play_game_scene();
+        }
+
         nk_menubar_end(nk_ctx);
     }
     nk_end(nk_ctx);
@@ -1,19 +1,26 @@
 #include "Ecs/DtEcs.h"
 #define RAYLIB_NUKLEAR_IMPLEMENTATION
+#include "EditorApi.h"
 #include "GameLib.h"
+#include "Profiling/DtAllocTracker.h"
+#include "Profiling/DtTrace.h"
 #include "raylib-nuklear.h"
 #include "scheduler/RuntimeScheduler.h"
 
 #define MAIN_SCENE_PATH "./source/main menu.dt.scene"
 #define GAME_SCENE_PATH "./source/game_scene.dt.scene"
 
+#define TRACE_PATH "./trace.json"
+#define TRACE_FRAMES 120
+
 #define WINDOW_WIDTH 1200
 #define WINDOW_HEIGHT 800
+#define TARGET_FPS 60
+#define FIXED_DELTA_TIME (1.0f / 60.0f)
 
 const DtScene* main_scene;
 DtUpdateContext update_ctx = (DtUpdateContext) {
-    .delta_time = 0.2f,
-    .fixed_delta_time = 0.2f,
+    .fixed_delta_time = FIXED_DELTA_TIME,
 };
 
 extern const DtScene* game_scene;
@@ -28,16 +35,22 @@ static void deinitialize_ecs_manager();
 static void deinitialize_window();
 
 int main(void) {
+    dt_jobs_init(0);
     initialize_window();
     initialize_main_scene();
     load_game_lib();
     load_game_scene();
+    dt_registries_freeze();
 
     dt_update_handler_init(main_scene->update_handler);
     dt_draw_handler_init(main_scene->draw_handler);
 
     while (!WindowShouldClose()) {
+        update_ctx.delta_time = GetFrameTime();
         dt_update_handler_update(main_scene->update_handler, &update_ctx);
+        dt_draw_handler_set_alpha(main_scene->draw_handler, update_ctx.alpha);
+        update_game_scene(&update_ctx);
+        dt_jobs_run_main();
 
         UpdateNuklear(nk_ctx);
 
@@ -47,10 +60,25 @@ int main(void) {
         DrawNuklear(nk_ctx);
         EndDrawing();
 
+        if (IsKeyPressed(KEY_F9) && !dt_trace_is_capturing()) {
+            dt_trace_capture(TRACE_FRAMES);
+            dte_log("Trace capture of %d frames started", TRACE_FRAMES);
+        }
+        if (dt_trace_frame_mark()) {
+            if (dt_trace_dump(TRACE_PATH))
+                dte_log("Trace was saved to %s", TRACE_PATH);
+            else
+                dte_error_log("Could not save trace to %s", TRACE_PATH);
+        }
+
+        dt_alloc_frame_mark();
+        if (IsKeyPressed(KEY_F10))
+            dt_alloc_report(stderr);
     }
 
     deinitialize_ecs_manager();
     deinitialize_window();
+    dt_jobs_shutdown();
 
     return 0;
 }
@@ -64,7 +92,7 @@ static void initialize_main_scene() {
 
 static void initialize_window() {
     InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Dt Editor");
-    SetTargetFPS(60);
+    SetTargetFPS(TARGET_FPS);
 
     const int fontSize = 18;
     Font font = LoadFontFromNuklear(fontSize);
@@ -77,7 +105,10 @@ static void initialize_window() {
     };
 }
 
-static void deinitialize_ecs_manager() { dt_scene_unload_by(main_scene); }
+static void deinitialize_ecs_manager() {
+    wait_game_scene_saved();
+    dt_scene_unload_by(main_scene);
+}
 
 static void deinitialize_window() {
     UnloadNuklear(nk_ctx);
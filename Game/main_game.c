@@ -1,7 +1,257 @@
+#include <cjson/cJSON.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DtAllocators.h"
+#include "DtTime.h"
+#include "Profiling/DtAllocTracker.h"
+#include "Profiling/DtMeasure.h"
+#include "scheduler/RuntimeScheduler.h"
 
-int main() {
-    printf("playing!!!\n");
+#define DEFAULT_SCENES_DIRECTORY "./source/scenes"
+#define DEFAULT_FRAMES 600
+#define DEFAULT_RATE 60
+#define ALLOC_GUARD_WARMUP_FRAMES 60
 
-    return 0;
+/**
+ * @brief options of headless run, draw systems are never initialized or called
+ */
+typedef struct {
+    const char* scenes_directory;
+    const char* scene_name;
+    const char* out_path;
+    u32 frames;
+    u32 rate;
+    u16 workers;
+    bool unlimited;
+    bool alloc_guard;
+    bool verbose;
+} HeadlessOptions;
+
+/**
+ * @brief frame time percentiles in nanoseconds
+ */
+typedef struct {
+    u32 frames;
+    u64 total_ns;
+    u64 mean_ns;
+    u64 p50_ns;
+    u64 p90_ns;
+    u64 p99_ns;
+    u64 max_ns;
+} HeadlessReport;
+
+static bool parse_options(int argc, char** argv, HeadlessOptions* options);
+static const DtScene* select_scene(const char* name);
+static void run_frames(const DtScene* scene, const HeadlessOptions* options, u64* frame_times);
+static HeadlessReport make_report(u64* frame_times, u32 frames);
+static void print_report(const HeadlessReport* report);
+static bool save_report(const HeadlessReport* report, const char* path);
+static void print_usage(const char* program);
+
+int main(const int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!options.verbose)
+        dt_measure_mute_stdout();
+
+    dt_add_scenes(options.scenes_directory);
+    dt_registries_freeze();
+
+    const DtScene* scene = select_scene(options.scene_name);
+    if (!scene) {
+        fprintf(stderr, "[WARNING] no scene to run in %s\n", options.scenes_directory);
+        return 1;
+    }
+    dt_scenes_set_active_by(scene);
+    if (options.workers)
+        dt_jobs_init(options.workers);
+    dt_update_handler_set_parallel(scene->update_handler, options.workers > 0);
+    dt_update_handler_init(scene->update_handler);
+
+    if (options.alloc_guard)
+        dt_alloc_guard_arm(DT_ALLOC_GUARD_RECORD, ALLOC_GUARD_WARMUP_FRAMES);
+
+    u64* frame_times = DT_MALLOC(sizeof(u64) * options.frames);
+    if (!frame_times) {
+        fprintf(stderr, "[WARNING] can't allocate frame times\n");
+        exit(1);
+    }
+
+    run_frames(scene, &options, frame_times);
+    const HeadlessReport report = make_report(frame_times, options.frames);
+    DT_FREE(frame_times);
+
+    fprintf(stderr, "scene \"%s\", ", scene->name);
+    print_report(&report);
+
+    int status = 0;
+    if (options.out_path && !save_report(&report, options.out_path))
+        status = 1;
+
+    if (options.alloc_guard && dt_alloc_guard_violations() > 0) {
+        dt_alloc_guard_report(stderr);
+        status = 1;
+    }
+
+    dt_scene_unload_by(scene);
+    dt_jobs_shutdown();
+
+    return status;
+}
+
+static bool parse_options(const int argc, char** argv, HeadlessOptions* options) {
+    *options = (HeadlessOptions) {
+        .scenes_directory = DEFAULT_SCENES_DIRECTORY,
+        .frames = DEFAULT_FRAMES,
+        .rate = DEFAULT_RATE,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scenes") == 0 && i + 1 < argc) {
+            options->scenes_directory = argv[++i];
+        } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            options->scene_name = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options->frames = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            options->rate = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            options->workers = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--unlimited") == 0) {
+            options->unlimited = true;
+        } else if (strcmp(argv[i], "--alloc-guard") == 0) {
+            options->alloc_guard = true;
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            options->out_path = argv[++i];
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            options->verbose = true;
+        } else {
+            return false;
+        }
+    }
+
+    return options->frames > 0 && options->rate > 0;
+}
+
+static const DtScene* select_scene(const char* name) {
+    DtEnvironment* env = dt_environment_instance();
+
+    if (name) {
+        dt_scenes_set_active(name);
+        const DtScene* scene = dt_scenes_get_active();
+        return scene && strcmp(scene->name, name) == 0 ? scene : NULL;
+    }
+
+    // without name first scene of tree is taken, order is stable between runs
+    DtIterator* iterator = &env->scenes.iterator;
+    iterator->start(iterator->enumerable);
+    if (!iterator->has_current(iterator->enumerable))
+        return NULL;
+
+    return iterator->current(iterator->enumerable);
+}
+
+static void run_frames(const DtScene* scene, const HeadlessOptions* options, u64* frame_times) {
+    const u64 frame_duration = 1000000000ULL / options->rate;
+    DtUpdateContext ctx = {
+        .delta_time = 1.0f / (float) options->rate,
+        .fixed_delta_time = 1.0f / (float) options->rate,
+    };
+
+    // deadlines are absolute so oversleeping of one frame doesn't shift the next ones
+    u64 deadline = dt_time_now_ns();
+    for (u32 i = 0; i < options->frames; i++) {
+        const u64 start = dt_time_now_ns();
+        dt_update_handler_update(scene->update_handler, &ctx);
+        dt_alloc_frame_mark();
+        const u64 end = dt_time_now_ns();
+        frame_times[i] = end - start;
+
+        if (options->unlimited)
+            continue;
+
+        deadline += frame_duration;
+        if (deadline > end)
+            dt_time_sleep_ns(deadline - end);
+        else
+            deadline = end;
+    }
+}
+
+/**
+ * @brief nearest rank percentile of sorted samples
+ */
+static u64 percentile(const u64* sorted, const u32 count, const u32 percent) {
+    u64 rank = ((u64) count * percent + 99) / 100;
+    if (rank == 0)
+        rank = 1;
+    return sorted[rank - 1];
+}
+
+static HeadlessReport make_report(u64* frame_times, const u32 frames) {
+    qsort(frame_times, frames, sizeof(u64), dt_measure_compare_u64);
+
+    HeadlessReport report = {
+        .frames = frames,
+        .p50_ns = percentile(frame_times, frames, 50),
+        .p90_ns = percentile(frame_times, frames, 90),
+        .p99_ns = percentile(frame_times, frames, 99),
+        .max_ns = frame_times[frames - 1],
+    };
+
+    for (u32 i = 0; i < frames; i++)
+        report.total_ns += frame_times[i];
+    report.mean_ns = report.total_ns / frames;
+
+    return report;
+}
+
+static void print_report(const HeadlessReport* report) {
+    fprintf(stderr,
+            "%u frames, update time ms: mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+            report->frames, report->mean_ns / 1e6, report->p50_ns / 1e6, report->p90_ns / 1e6,
+            report->p99_ns / 1e6, report->max_ns / 1e6);
+}
+
+static bool save_report(const HeadlessReport* report, const char* path) {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "frames", report->frames);
+    cJSON_AddNumberToObject(root, "mean_ms", report->mean_ns / 1e6);
+    cJSON_AddNumberToObject(root, "p50_ms", report->p50_ns / 1e6);
+    cJSON_AddNumberToObject(root, "p90_ms", report->p90_ns / 1e6);
+    cJSON_AddNumberToObject(root, "p99_ms", report->p99_ns / 1e6);
+    cJSON_AddNumberToObject(root, "max_ms", report->max_ns / 1e6);
+
+    char* json = cJSON_Print(root);
+    cJSON_Delete(root);
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[WARNING] can't open %s\n", path);
+        cJSON_free(json);
+        return false;
+    }
+
+    fputs(json, file);
+    fclose(file);
+    cJSON_free(json);
+
+    return true;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "usage:\n"
+            "\t%s [--scenes <directory>] [--scene <name>] [--frames <count>] [--rate <hz>] "
+            "[--workers <count>] [--unlimited] [--alloc-guard] [--out <report.json>] [--verbose]\n"
+            "\n"
+            "\tupdate systems of scene run without window, draw systems are skipped,\n"
+            "\t--rate sets tick rate and delta time, --unlimited doesn't wait between frames,\n"
+            "\t--workers starts job workers, independent update systems run on them\n",
+            program);
 }
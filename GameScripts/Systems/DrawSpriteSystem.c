@@ -14,9 +14,18 @@ typedef struct {
     DtEcsPool* sprites;
 } DrawSpriteSystem;
 
+/**
+ * @brief copy of sprite and transform made by extract
+ */
+typedef struct {
+    Sprite sprite;
+    DtTransform2D transform;
+} SpriteRenderItem;
+
 DrawSystem* draw_sprite_new();
 void draw_sprite_init(DtEcsManager* manager, void* data);
-void draw_sprite_draw(void* data);
+void draw_sprite_extract(void* data, DtRenderStream* stream);
+void draw_sprite_draw(void* data, const DtRenderStream* stream);
 void draw_sprite_destroy(void* data);
 
 DT_REGISTER_DRAW(DrawSprite, draw_sprite_new, DTE_EDIT_DRAW(draw_sprite_new))
@@ -29,8 +38,9 @@ DrawSystem* draw_sprite_new() {
             (DrawSystem) {
                 .data = draw_sprite,
                 .init = draw_sprite_init,
-                .draw = draw_sprite_draw,
                 .destroy = draw_sprite_destroy,
+                .extract = draw_sprite_extract,
+                .draw_extracted = draw_sprite_draw,
             },
     };
 
@@ -50,7 +60,7 @@ void draw_sprite_init(DtEcsManager* manager, void* data) {
     sys->sprites = DT_ECS_MANAGER_GET_POOL(manager, Sprite);
 }
 
-static void draw_sprite_entity(Sprite* sprite, DtTransform2D* transform) {
+static void draw_sprite_entity(const Sprite* sprite, const DtTransform2D* transform) {
     float tex_w = (float) sprite->texture.width;
     float tex_h = (float) sprite->texture.height;
 
@@ -96,14 +106,26 @@ static void draw_sprite_entity(Sprite* sprite, DtTransform2D* transform) {
     }
 }
 
-void draw_sprite_draw(void* data) {
+void draw_sprite_extract(void* data, DtRenderStream* stream) {
     DrawSpriteSystem* sys = data;
 
-    FOREACH(DtEntity, e, &sys->filter->entities.entities_iterator, {
-        Sprite* sprite = dt_ecs_pool_get(sys->sprites, e);
-        DtTransform2D* transform = dt_ecs_pool_get(sys->transforms, e);
-        draw_sprite_entity(sprite, transform);
-    });
+    const u16 count = sys->filter->entities.count;
+    SpriteRenderItem* items = dt_render_stream_reserve(stream, sizeof(SpriteRenderItem), count);
+
+    for (u16 i = 0; i < count; i++) {
+        const DtEntity e = sys->filter->entities.entities[i];
+        items[i] = (SpriteRenderItem) {
+            .sprite = *(Sprite*) dt_ecs_pool_get(sys->sprites, e),
+            .transform = *(DtTransform2D*) dt_ecs_pool_get(sys->transforms, e),
+        };
+    }
+}
+
+void draw_sprite_draw(void* data, const DtRenderStream* stream) {
+    const SpriteRenderItem* items = stream->items;
+
+    for (u32 i = 0; i < stream->count; i++)
+        draw_sprite_entity(&items[i].sprite, &items[i].transform);
 }
 
 void draw_sprite_destroy(void* data) {}
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler/RuntimeScheduler.h"
+
+#define DEFAULT_BENCH_ITERATIONS 10
+
+static void print_usage(const char* program);
+static int convert(const char* src, const char* dst, bool to_binary);
+static int bench(const char* json_path, const char* binary_path, int iterations);
+static double bench_load(const char* path, int iterations);
+static double get_time_ms(void);
+
+int main(const int argc, char** argv) {
+    if (argc < 5) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "-") != 0 && !dt_module_load(dt_environment_instance(), argv[1])) {
+        fprintf(stderr, "[ERROR] module with scene components hasn't loaded: %s\n", argv[1]);
+        return 1;
+    }
+
+    if (strcmp(argv[2], "to-binary") == 0)
+        return convert(argv[3], argv[4], true);
+    if (strcmp(argv[2], "to-json") == 0)
+        return convert(argv[3], argv[4], false);
+    if (strcmp(argv[2], "bench") == 0)
+        return bench(argv[3], argv[4], argc > 5 ? atoi(argv[5]) : DEFAULT_BENCH_ITERATIONS);
+
+    print_usage(argv[0]);
+    return 1;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "usage:\n"
+            "\t%s <module|-> to-binary <scene.dt.scene> <scene.dt.bscene>\n"
+            "\t%s <module|-> to-json <scene.dt.bscene> <scene.dt.scene>\n"
+            "\t%s <module|-> bench <scene.dt.scene> <scene.dt.bscene> [iterations]\n",
+            program, program, program);
+}
+
+static int convert(const char* src, const char* dst, const bool to_binary) {
+    const DtScene* scene = dt_add_scene(src);
+    if (!scene)
+        return 1;
+
+    const bool ok = to_binary ? dt_scene_save_binary(scene, dst) : dt_scene_save_json(scene, dst);
+    dt_scene_unload_by(scene);
+
+    return ok ? 0 : 1;
+}
+
+static int bench(const char* json_path, const char* binary_path, const int iterations) {
+    if (iterations <= 0)
+        return 1;
+
+    const double json_ms = bench_load(json_path, iterations);
+    const double binary_ms = bench_load(binary_path, iterations);
+
+    if (json_ms < 0 || binary_ms < 0)
+        return 1;
+
+    printf("json:   %.3f ms per load\n", json_ms);
+    printf("binary: %.3f ms per load\n", binary_ms);
+    printf("speedup: %.2fx\n", binary_ms > 0 ? json_ms / binary_ms : 0.0);
+
+    return 0;
+}
+
+static double bench_load(const char* path, const int iterations) {
+    double total = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        const double start = get_time_ms();
+        const DtScene* scene = dt_add_scene(path);
+        total += get_time_ms() - start;
+
+        if (!scene)
+            return -1;
+        dt_scene_unload_by(scene);
+    }
+
+    return total / iterations;
+}
+
+static double get_time_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+}
@@ -3,6 +3,21 @@ if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
 endif ()
 
 find_package(PkgConfig REQUIRED)
+find_package(Threads REQUIRED)
 pkg_check_modules(CJSON REQUIRED libcjson)
 pkg_check_modules(RAYLIB REQUIRED raylib)
 
+option(DT_PROFILE_SYSTEMS "Collect per-system timings and counters in update and draw handlers" OFF)
+if (DT_PROFILE_SYSTEMS)
+    add_compile_definitions(DT_PROFILE_SYSTEMS)
+endif ()
+
+option(DT_TRACE "Record scoped trace zones for Chrome trace export" OFF)
+if (DT_TRACE)
+    add_compile_definitions(DT_TRACE)
+endif ()
+
+option(DT_TRACK_ALLOCATIONS "Count DT_MALLOC family allocations per subsystem tag" OFF)
+if (DT_TRACK_ALLOCATIONS)
+    add_compile_definitions(DT_TRACK_ALLOCATIONS)
+endif ()
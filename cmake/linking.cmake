@@ -1,4 +1,4 @@
-foreach (TARGET DtEngine DtEngineTestModule DtEngineTest GameLibStatic GameLibShared EditorLib Editor Game)
+foreach (TARGET DtEngine DtEngineTestModule DtEngineTest DtEngineBench GameLibStatic GameLibShared EditorLib Editor Game DtSceneConverter)
     if (TARGET ${TARGET})
         target_include_directories(${TARGET} PRIVATE
                 ${CJSON_INCLUDE_DIRS}
@@ -8,6 +8,7 @@ foreach (TARGET DtEngine DtEngineTestModule DtEngineTest GameLibStatic GameLibSh
         target_link_libraries(${TARGET} PRIVATE
                 ${CJSON_LINK_LIBRARIES}
                 ${RAYLIB_LINK_LIBRARIES}
+                Threads::Threads
         )
 
         if (WIN32)
@@ -23,7 +24,7 @@ foreach (TARGET DtEngine DtEngineTestModule DtEngineTest GameLibStatic GameLibSh
     endif ()
 endforeach ()
 
-foreach (TARGET DtEngineTestModule DtEngineTest GameLibStatic GameLibShared Editor EditorLib)
+foreach (TARGET DtEngineTestModule DtEngineTest DtEngineBench GameLibStatic GameLibShared Editor EditorLib DtSceneConverter)
     target_link_libraries(${TARGET} PRIVATE $<TARGET_OBJECTS:DtEngine_Objects>)
 endforeach ()
 
@@ -33,10 +34,12 @@ target_link_libraries(Game PUBLIC GameLibStatic)
 set(MY_TARGETS
         DtEngine_Objects
         DtEngineTest
+        DtEngineBench
         GameLibStatic
         GameLibShared
         Editor
         EditorLib
+        DtSceneConverter
 )
 
 foreach (TGT ${MY_TARGETS})
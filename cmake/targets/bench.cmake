@@ -0,0 +1,22 @@
+# Bench sources
+set(BENCH_SOURCES
+        CoreBench/main_bench.c
+        CoreBench/Bench/DtBench.c
+        CoreBench/Bench/BenchCounters.c
+        CoreBench/Bench/BenchRegisterAll.c
+        CoreBench/Bench/BenchEcs.c
+        CoreBench/Bench/BenchScene.c
+)
+
+# Bench executable
+add_executable(DtEngineBench ${BENCH_SOURCES})
+set_target_properties(DtEngineBench PROPERTIES
+        OUTPUT_NAME "DtEngineBench"
+        RUNTIME_OUTPUT_DIRECTORY "${CORE_OUTPUT_DIR}"
+)
+
+# Include directories
+target_include_directories(DtEngineBench PRIVATE
+        "${CMAKE_CURRENT_SOURCE_DIR}/Core"
+        "${CMAKE_CURRENT_SOURCE_DIR}/CoreBench/Bench"
+)
\ No newline at end of file
@@ -5,15 +5,32 @@ set(CORE_SOURCES
         Core/Ecs/Entity.c
         Core/Ecs/EcsPool.c
         Core/Ecs/Systems.c
+        Core/Ecs/SystemSchedule.c
+        Core/Ecs/FilterParallel.c
         Core/Ecs/TagPool.c
         Core/Ecs/ComponentPool.c
+        Core/Ecs/Prefab.c
+        Core/Ecs/Snapshot.c
+        Core/Ecs/Migration.c
+        Core/Jobs/Jobs.c
+        Core/Profiling/Trace.c
+        Core/Profiling/AllocTracker.c
         Core/DtComponents/Components.c
         Core/Ecs/ComponentHandler.c
         Core/Ecs/UpdateHandler.c
         Core/Ecs/UpdateRegister.c
         Core/Ecs/DrawHandler.c
+        Core/Ecs/EventHandler.c
+        Core/Ecs/Events.c
+        Core/Ecs/Observers.c
         Core/scheduler/SceneLoader.c
+        Core/scheduler/SceneSaver.c
+        Core/scheduler/SceneReload.c
+        Core/scheduler/SceneBinary.c
+        Core/scheduler/FramePipeline.c
+        Core/scheduler/MappedFile.c
         Core/Collections/RbTree.c
+        Core/Collections/Arena.c
         Core/scheduler/Environment.c
         Core/scheduler/TypeParse.c
         Core/DtComponents/DtTransform2D.c
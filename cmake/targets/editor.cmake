@@ -1,5 +1,6 @@
 set(EDITOR_SOURCES
         Editor/GameLibLink/GameLibLoader.c
+        Editor/GameLibLink/GameLibBuild.c
         Editor/UI/Systems.c
         Editor/UI/EntityComponentsPanel.c
         Editor/UI/Inspecor.c
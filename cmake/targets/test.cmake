@@ -9,6 +9,23 @@ set(TEST_SOURCES
         CoreTest/Tests/TestComponentRegister.c
         CoreTest/Tests/TestSystemsRegister.c
         CoreTest/Tests/TestSceneParse.c
+        CoreTest/Tests/TestSceneBinary.c
+        CoreTest/Tests/TestPrefab.c
+        CoreTest/Tests/TestSnapshot.c
+        CoreTest/Tests/TestSceneSaver.c
+        CoreTest/Tests/TestMigration.c
+        CoreTest/Tests/TestSystemStats.c
+        CoreTest/Tests/TestSystemSchedule.c
+        CoreTest/Tests/TestJobs.c
+        CoreTest/Tests/TestRenderSnapshot.c
+        CoreTest/Tests/TestWorlds.c
+        CoreTest/Tests/TestEvents.c
+        CoreTest/Tests/TestObservers.c
+        CoreTest/Tests/TestSlices.c
+        CoreTest/Tests/TestRunConditions.c
+        CoreTest/Tests/TestFixedStep.c
+        CoreTest/Tests/TestTrace.c
+        CoreTest/Tests/TestAllocTracker.c
         CoreTest/Tests/TestModuleLoad.c
 )
 
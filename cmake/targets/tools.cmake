@@ -0,0 +1,9 @@
+add_executable(DtSceneConverter Tools/SceneConverter/main_scene_converter.c)
+set_target_properties(DtSceneConverter PROPERTIES
+        OUTPUT_NAME "DtSceneConverter"
+        RUNTIME_OUTPUT_DIRECTORY "${CORE_OUTPUT_DIR}"
+)
+
+target_include_directories(DtSceneConverter PRIVATE
+        "${CMAKE_CURRENT_SOURCE_DIR}/Core"
+)